@@ -0,0 +1,81 @@
+#include "HttpParser.h"
+#include "HttpScan.h"
+#include "RecvBuffer.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// 브라우저/프록시가 보내는 정도(20개 이상)의 header 를 가진 요청을 반복 파싱해 scan level 별 비용을 비교한다.
+namespace {
+
+const char kRequest[] =
+    "GET /health HTTP/1.1\r\n"
+    "Host: api.example.com\r\n"
+    "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/124.0 Safari/537.36\r\n"
+    "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,image/avif,image/webp,*/*;q=0.8\r\n"
+    "Accept-Language: en-US,en;q=0.9,ko;q=0.8\r\n"
+    "Accept-Encoding: gzip, deflate, br, zstd\r\n"
+    "Cache-Control: no-cache\r\n"
+    "Pragma: no-cache\r\n"
+    "Connection: keep-alive\r\n"
+    "Upgrade-Insecure-Requests: 1\r\n"
+    "Sec-Fetch-Dest: document\r\n"
+    "Sec-Fetch-Mode: navigate\r\n"
+    "Sec-Fetch-Site: none\r\n"
+    "Sec-Fetch-User: ?1\r\n"
+    "Sec-Ch-Ua: \"Chromium\";v=\"124\", \"Google Chrome\";v=\"124\", \"Not-A.Brand\";v=\"99\"\r\n"
+    "Sec-Ch-Ua-Mobile: ?0\r\n"
+    "Sec-Ch-Ua-Platform: \"Linux\"\r\n"
+    "DNT: 1\r\n"
+    "Cookie: session=8f2b1c9d0e7a4b3c; theme=dark; tracking=off; ab_bucket=42\r\n"
+    "X-Forwarded-For: 203.0.113.7, 198.51.100.23\r\n"
+    "X-Forwarded-Proto: https\r\n"
+    "X-Request-Id: 6c1f0b2e-52a4-4d1c-9a43-0c7e5d8b9f21\r\n"
+    "Via: 1.1 edge-proxy\r\n"
+    "\r\n";
+
+double RunLevel(eHttpScanLevel level, std::size_t iterations, std::uint64_t& checksum)
+{
+    RecvBuffer rb(64 * 1024, RingBuffer_Mirrored);
+    if (rb.Open() != RecvBuf_Ok) return 0;
+
+    HttpParser parser;
+    HttpRequestView req;
+    const std::size_t len = sizeof(kRequest) - 1;
+
+    HttpScan::SetLevel(level);
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        std::size_t written = 0;
+        rb.Write(kRequest, len, written);
+        if (parser.TryParseView(rb, req) != HttpParser::Result::Http_Ok) return 0;
+        checksum += req.headerCount + req.target.size();
+        parser.FinishView(rb);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(iterations);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::size_t iterations = 1'000'000;
+    if (argc > 1) iterations = static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10));
+
+    const eHttpScanLevel best = HttpScan::BestSupportedLevel();
+    std::uint64_t checksum = 0;
+
+    std::printf("iterations            : %zu\n", iterations);
+    std::printf("request bytes         : %zu\n", sizeof(kRequest) - 1);
+    std::printf("scalar                : %7.1f ns/req\n", RunLevel(HttpScan_Scalar, iterations, checksum));
+    if (best >= HttpScan_Sse42)
+        std::printf("sse4.2 (16B)          : %7.1f ns/req\n", RunLevel(HttpScan_Sse42, iterations, checksum));
+    if (best >= HttpScan_Avx2)
+        std::printf("avx2 (32B)            : %7.1f ns/req\n", RunLevel(HttpScan_Avx2, iterations, checksum));
+    std::printf("checksum              : %llu\n", static_cast<unsigned long long>(checksum));
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include "RingBuffer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+// RingBuffer 는 별도 TU(NetworkCore) 라서 inline 되지 않으므로 비교 대상도 동일 조건으로 맞춘다.
+#define NOINLINE __attribute__((noinline))
+
+namespace {
+
+// 변경 전 RingBuffer 구현(modulo + mIsFull)을 비교 기준으로 그대로 옮겨둔 것
+class LegacyRingBuffer {
+public:
+    explicit LegacyRingBuffer(size_t bufSize)
+        : mBuf(std::make_unique<std::uint8_t[]>(bufSize)), mBufSize(bufSize) {}
+
+    size_t DataSpace() const {
+        if (mIsFull) return mBufSize;
+        if (mWritePos >= mReadPos) return mWritePos - mReadPos;
+        return mBufSize - (mReadPos - mWritePos);
+    }
+    size_t FreeSpace() const {
+        if (mIsFull) return 0;
+        return mBufSize - DataSpace();
+    }
+
+    NOINLINE size_t Write(const void* src, size_t len) {
+        size_t freeSpace = FreeSpace();
+        if (freeSpace == 0) return 0;
+        size_t toWrite = len < freeSpace ? len : freeSpace;
+        auto* in = static_cast<const std::uint8_t*>(src);
+        size_t first = toWrite;
+        size_t untilEnd = mBufSize - mWritePos;
+        if (first > untilEnd) first = untilEnd;
+        std::memcpy(mBuf.get() + mWritePos, in, first);
+        mWritePos = (mWritePos + first) % mBufSize;
+        size_t remain = toWrite - first;
+        if (remain > 0) {
+            std::memcpy(mBuf.get() + mWritePos, in + first, remain);
+            mWritePos = (mWritePos + remain) % mBufSize;
+        }
+        if (mWritePos == mReadPos) mIsFull = true;
+        return toWrite;
+    }
+
+    NOINLINE size_t Peek(void* dst, size_t len) {
+        size_t available = DataSpace();
+        if (available == 0) return 0;
+        size_t toPeek = len < available ? len : available;
+        auto* out = static_cast<std::uint8_t*>(dst);
+        size_t readPos = mReadPos;
+        size_t first = toPeek;
+        size_t untilEnd = mBufSize - readPos;
+        if (first > untilEnd) first = untilEnd;
+        std::memcpy(out, mBuf.get() + readPos, first);
+        readPos = (readPos + first) % mBufSize;
+        if (toPeek > first) std::memcpy(out + first, mBuf.get() + readPos, toPeek - first);
+        return toPeek;
+    }
+
+    NOINLINE void Consume(size_t len) {
+        size_t available = DataSpace();
+        if (available == 0) return;
+        if (len >= available) { mReadPos = mWritePos = 0; mIsFull = false; return; }
+        mReadPos = (mReadPos + len) % mBufSize;
+        mIsFull = false;
+    }
+
+    NOINLINE size_t Read(void* dst, size_t len) {
+        size_t n = Peek(dst, len);
+        Consume(n);
+        return n;
+    }
+
+private:
+    std::unique_ptr<std::uint8_t[]> mBuf;
+    size_t mBufSize;
+    size_t mReadPos = 0;
+    size_t mWritePos = 0;
+    bool mIsFull = false;
+};
+
+// framing 경로와 비슷한 패턴: 작은 write, 4바이트 header peek/consume, payload read.
+// memcpy 비용보다 cursor 계산 비용이 드러나도록 크기를 작게 유지한다.
+template <typename Ring>
+double RunWorkload(Ring& rb, std::size_t iterations, std::uint64_t& checksum)
+{
+    std::uint8_t src[16];
+    std::uint8_t dst[16];
+    for (std::size_t i = 0; i < sizeof(src); ++i) src[i] = static_cast<std::uint8_t>(i);
+
+    // 항상 데이터가 남아 있도록 채워둬서 cursor 가 계속 전진하며 wrap 되게 한다.
+    if (rb.DataSpace() == 0) {
+        for (int i = 0; i < 64; ++i) rb.Write(src, sizeof(src));
+    }
+
+    const auto begin = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        const std::size_t len = 4 + (i & 7);
+        rb.Write(src, 4);
+        rb.Write(src, len);
+        rb.Peek(dst, 4);
+        rb.Consume(4);
+        checksum += rb.Read(dst, len);
+        checksum += dst[0];
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(iterations);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t iterations = 10'000'000;
+    if (argc > 1) iterations = static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10));
+
+    constexpr std::size_t kPow2Size    = 64 * 1024;
+    constexpr std::size_t kNonPow2Size = 64 * 1024 - 1000;
+
+    std::uint64_t checksum = 0;
+
+    LegacyRingBuffer legacy(kNonPow2Size);
+    RingBuffer modRing(kNonPow2Size);
+    RingBuffer maskRing(kPow2Size);
+
+    // 노이즈를 줄이기 위해 번갈아 여러 번 돌리고 최솟값을 취한다.
+    constexpr int kRounds = 5;
+    double legacyNs = 1e30, modNs = 1e30, maskNs = 1e30;
+    for (int round = 0; round < kRounds; ++round) {
+        legacyNs = std::min(legacyNs, RunWorkload(legacy, iterations, checksum));
+        modNs    = std::min(modNs, RunWorkload(modRing, iterations, checksum));
+        maskNs   = std::min(maskNs, RunWorkload(maskRing, iterations, checksum));
+    }
+
+    std::printf("iterations            : %zu\n", iterations);
+    std::printf("legacy (modulo+flag)  : %7.2f ns/iter\n", legacyNs);
+    std::printf("counters, modulo      : %7.2f ns/iter\n", modNs);
+    std::printf("counters, pow2 mask   : %7.2f ns/iter\n", maskNs);
+    std::printf("checksum              : %llu\n", static_cast<unsigned long long>(checksum));
+    return 0;
+}
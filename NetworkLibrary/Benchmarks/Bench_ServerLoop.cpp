@@ -0,0 +1,210 @@
+#include "EpollServer.h"
+#include "IoUring.h"
+#include "MessageFramer.h"
+#include "UringServer.h"
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// 같은 Session / HttpService 위에서 epoll loop 와 io_uring loop 를 나란히 돌려 req/s 를 비교한다.
+// 부하 클라이언트는 연결마다 요청 하나를 보내고 응답을 다 받으면 다음 요청을 보내는 closed-loop.
+// 클라이언트와 서버가 같은 머신(코어)을 나눠 쓰므로 절대값보다 두 backend 의 상대 비교로 볼 것.
+
+namespace {
+
+enum eBackend { Backend_Epoll, Backend_Uring };
+
+struct ClientConn {
+    int fd = -1;
+    std::string in;
+    size_t sent = 0;
+};
+
+// 완성된 응답 하나의 길이. 아직 덜 왔으면 0
+size_t ResponseLength(eServerProtocol protocol, const std::string& in)
+{
+    if (protocol == ServerProtocol_FramedEcho) {
+        if (in.size() < MessageFramer::kHeaderSize) return 0;
+        const auto* p = reinterpret_cast<const std::uint8_t*>(in.data());
+        const size_t len = (size_t(p[0]) << 24) | (size_t(p[1]) << 16) | (size_t(p[2]) << 8) | p[3];
+        const size_t total = MessageFramer::kHeaderSize + len;
+        return in.size() >= total ? total : 0;
+    }
+
+    const size_t headerEnd = in.find("\r\n\r\n");
+    if (headerEnd == std::string::npos) return 0;
+    size_t contentLength = 0;
+    const size_t cl = in.find("Content-Length: ");
+    if (cl != std::string::npos && cl < headerEnd)
+        contentLength = std::strtoull(in.c_str() + cl + 16, nullptr, 10);
+    const size_t total = headerEnd + 4 + contentLength;
+    return in.size() >= total ? total : 0;
+}
+
+std::string MakeRequest(eServerProtocol protocol, size_t payload)
+{
+    if (protocol == ServerProtocol_FramedEcho) {
+        std::vector<std::uint8_t> frame;
+        const std::string body(payload, 'x');
+        MessageFramer::Encode(body.data(), body.size(), frame);
+        return std::string(frame.begin(), frame.end());
+    }
+    return "GET /health HTTP/1.1\r\nHost: bench\r\n\r\n";
+}
+
+int Connect(uint16_t port)
+{
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 && errno != EINPROGRESS) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// 전송 중인 요청을 가능한 만큼 밀어넣는다
+bool PushRequest(ClientConn& c, const std::string& req)
+{
+    while (c.sent < req.size()) {
+        const ssize_t n = ::send(c.fd, req.data() + c.sent, req.size() - c.sent, MSG_NOSIGNAL);
+        if (n > 0) { c.sent += static_cast<size_t>(n); continue; }
+        return n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+    }
+    return true;
+}
+
+// 완료한 요청 수. 오류가 나면 0
+size_t RunLoad(uint16_t port, eServerProtocol protocol, size_t connections, size_t payload,
+               std::chrono::milliseconds duration)
+{
+    const std::string req = MakeRequest(protocol, payload);
+    const int ep = ::epoll_create1(EPOLL_CLOEXEC);
+    std::vector<ClientConn> conns(connections);
+
+    for (size_t i = 0; i < connections; ++i) {
+        conns[i].fd = Connect(port);
+        if (conns[i].fd < 0) {
+            std::perror("connect");
+            return 0;
+        }
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLOUT | EPOLLET;
+        ev.data.u64 = i;
+        ::epoll_ctl(ep, EPOLL_CTL_ADD, conns[i].fd, &ev);
+    }
+
+    size_t completed = 0;
+    bool failed = false;
+    char buf[64 * 1024];
+    epoll_event events[256];
+    const auto deadline = std::chrono::steady_clock::now() + duration;
+
+    while (!failed && std::chrono::steady_clock::now() < deadline) {
+        const int n = ::epoll_wait(ep, events, 256, 100);
+        for (int e = 0; e < n; ++e) {
+            ClientConn& c = conns[events[e].data.u64];
+            if (!PushRequest(c, req)) { failed = true; break; }
+
+            for (;;) {
+                const ssize_t r = ::recv(c.fd, buf, sizeof(buf), 0);
+                if (r > 0) { c.in.append(buf, static_cast<size_t>(r)); continue; }
+                if (r == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) failed = true;
+                break;
+            }
+
+            // 응답을 다 받은 연결은 바로 다음 요청
+            while (size_t len = ResponseLength(protocol, c.in)) {
+                c.in.erase(0, len);
+                ++completed;
+                c.sent = 0;
+                if (!PushRequest(c, req)) { failed = true; break; }
+            }
+        }
+    }
+
+    for (auto& c : conns) ::close(c.fd);
+    ::close(ep);
+    if (failed) std::fprintf(stderr, "load client: connection failed\n");
+    return failed ? 0 : completed;
+}
+
+std::unique_ptr<ServerLoop> MakeServer(eBackend backend, uint16_t port, eServerProtocol protocol)
+{
+    constexpr size_t kBufSize = 64 * 1024;
+    if (backend == Backend_Uring) {
+        auto server = std::make_unique<UringServer>(port, kBufSize, kBufSize);
+        server->SetProtocol(protocol);
+        return server;
+    }
+    auto server = std::make_unique<EpollServer>(port, kBufSize, kBufSize);
+    server->SetProtocol(protocol);
+    return server;
+}
+
+void RunCase(const char* name, eBackend backend, uint16_t port, eServerProtocol protocol, size_t connections,
+             size_t payload, std::chrono::milliseconds duration)
+{
+    auto server = MakeServer(backend, port, protocol);
+    if (!server->Start()) {
+        std::printf("%-22s : start failed\n", name);
+        return;
+    }
+    std::thread loop([&] { server->Run(); });
+
+    const size_t completed = RunLoad(port, protocol, connections, payload, duration);
+    server->Stop();
+    loop.join();
+
+    const double seconds = std::chrono::duration<double>(duration).count();
+    std::printf("%-22s : %10.0f req/s\n", name, static_cast<double>(completed) / seconds);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    size_t connections = 64;
+    size_t payload = 64;
+    long durationMs = 3000;
+    if (argc > 1) connections = static_cast<size_t>(std::strtoull(argv[1], nullptr, 10));
+    if (argc > 2) payload = static_cast<size_t>(std::strtoull(argv[2], nullptr, 10));
+    if (argc > 3) durationMs = std::strtol(argv[3], nullptr, 10);
+    const std::chrono::milliseconds duration(durationMs);
+
+    const bool uring = IoUring::IsSupported();
+    std::printf("connections           : %zu\n", connections);
+    std::printf("frame payload         : %zu bytes\n", payload);
+    std::printf("duration              : %ld ms\n", durationMs);
+
+    RunCase("epoll  http /health", Backend_Epoll, 19080, ServerProtocol_Http, connections, payload, duration);
+    if (uring)
+        RunCase("uring  http /health", Backend_Uring, 19081, ServerProtocol_Http, connections, payload, duration);
+    RunCase("epoll  framed echo", Backend_Epoll, 19082, ServerProtocol_FramedEcho, connections, payload, duration);
+    if (uring)
+        RunCase("uring  framed echo", Backend_Uring, 19083, ServerProtocol_FramedEcho, connections, payload, duration);
+    if (!uring)
+        std::printf("io_uring not available: uring cases skipped\n");
+    return 0;
+}
@@ -4,6 +4,7 @@
 #include <memory>
 #include "Session.h"
 #include "Socket.h"
+#include "EpollTriggerMode.h"
 
 constexpr int MAX_EVENTS = 8;
 
@@ -20,6 +21,10 @@ public:
 
     eSessionError Send(const void* data, size_t len);
 
+    // Start 전에 설정. 단일 스레드 client 라 EdgeOneShot 은 Edge 와 같게 취급한다.
+    void SetTriggerMode(eEpollTriggerMode mode);
+    void SetIoBudget(size_t bytes);
+
 private:
     void HandleEvent(uint32_t events);
     bool CheckConnectCompleted(uint32_t events);
@@ -27,6 +32,8 @@ private:
     void ScheduleReconnect();
     void CleanupSession();
     void Reconnect();
+    uint32_t BuildEvents() const;
+    void FlushPendingIo();
 private:
     const char* mServerIp;
     uint16_t    mServerPort;
@@ -39,6 +46,9 @@ private:
     bool mWantSendOut = false;
     bool mRunning = false;
     bool mNeedReconnect = false;
+    eEpollTriggerMode mTriggerMode = EpollTrigger_Level;
+    size_t mIoBudget = 0;
+    bool mPendingFlush = false;   // edge 모드: 이벤트 없이 OnWritable 을 불러야 함
 
     std::chrono::steady_clock::time_point mNextReconnect;
     std::unique_ptr<Session> mSession;
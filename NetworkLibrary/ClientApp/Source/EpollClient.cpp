@@ -86,13 +86,22 @@ bool EpollClient::Start()
         return Fail();
     }
 
+    mSession->SetIoBudget(mIoBudget);
+
     // 4) Session -> EpollClient : send 목적 EPOLLOUT 토글 요청 콜백
     mSession->SetWriteInterestCallback([this](Session& /*s*/, bool enable) {
         mWantSendOut = enable;
 
+        // edge 모드는 EPOLLOUT 이 항상 등록되어 있으므로 syscall 없이 다음 loop 에서 flush
+        if (mTriggerMode != EpollTrigger_Level)
+        {
+            if (enable && !mConnecting) mPendingFlush = true;
+            return;
+        }
+
         epoll_event ev{};
         ev.data.fd = mSession->Fd();
-        ev.events  = BuildClientEvents(mConnecting, mWantSendOut);
+        ev.events  = BuildEvents();
 
         if (::epoll_ctl(mEpollFd, EPOLL_CTL_MOD, mSession->Fd(), &ev) < 0)
         {
@@ -103,7 +112,7 @@ bool EpollClient::Start()
     // 5) epoll 등록 (CONNECTING이면 EPOLLOUT 포함)
     epoll_event ev{};
     ev.data.fd = mSession->Fd();
-    ev.events  = BuildClientEvents(mConnecting, mWantSendOut);
+    ev.events  = BuildEvents();
 
     if (::epoll_ctl(mEpollFd, EPOLL_CTL_ADD, mSession->Fd(), &ev) < 0)
     {
@@ -122,7 +131,8 @@ void EpollClient::Run()
 
     while (mRunning)
     {
-        int n = ::epoll_wait(mEpollFd, events, kMaxEvents, 1000);
+        const int timeoutMs = mPendingFlush ? 0 : 1000;
+        int n = ::epoll_wait(mEpollFd, events, kMaxEvents, timeoutMs);
         if (n < 0)
         {
             if (errno == EINTR) continue;
@@ -135,6 +145,8 @@ void EpollClient::Run()
             HandleEvent(events[i].events);
         }
 
+        FlushPendingIo();
+
         if(mNeedReconnect)
         {
             const auto now = std::chrono::steady_clock::now();
@@ -157,6 +169,57 @@ eSessionError EpollClient::Send(const void* data, size_t len)
     return mSession->QueueSend(data, len);
 }
 
+void EpollClient::SetTriggerMode(eEpollTriggerMode mode)
+{
+    mTriggerMode = (mode == EpollTrigger_Level) ? EpollTrigger_Level : EpollTrigger_Edge;
+}
+
+void EpollClient::SetIoBudget(size_t bytes)
+{
+    mIoBudget = bytes;
+}
+
+uint32_t EpollClient::BuildEvents() const
+{
+    if (mTriggerMode == EpollTrigger_Level)
+        return BuildClientEvents(mConnecting, mWantSendOut);
+
+    return EPOLLIN | EPOLLOUT | EPOLLERR | EPOLLHUP | EpollTriggerFlags(mTriggerMode);
+}
+
+void EpollClient::FlushPendingIo()
+{
+    if (!mSession || !mSession->IsOpen() || mConnecting)
+    {
+        mPendingFlush = false;
+        return;
+    }
+    if (mTriggerMode == EpollTrigger_Level) return;
+
+    const bool write = mPendingFlush || mSession->NeedsWriteRetry();
+    const bool read  = mSession->NeedsReadRetry();
+    mPendingFlush = false;
+
+    if (write && mSession->OnWritable() == Session_SocketError)
+    {
+        ScheduleReconnect();
+        return;
+    }
+    if (read)
+    {
+        const eSessionError r = mSession->OnReadable();
+        if (r == Session_PeerClosed || r == Session_SocketError || r == Session_RecvBufferError)
+        {
+            ScheduleReconnect();
+            return;
+        }
+    }
+
+    // budget 에 걸려 남은 일이 있으면 다음 회차에 이어서 처리
+    if (mSession->IsOpen() && (mSession->NeedsWriteRetry() || mSession->NeedsReadRetry()))
+        mPendingFlush = true;
+}
+
 void EpollClient::HandleEvent(uint32_t events)
 {
     if (!mSession) return;
@@ -225,9 +288,16 @@ bool EpollClient::CheckConnectCompleted(uint32_t /*events*/)
     mConnecting = false;
     mWantSendOut = mSession->HasPendingSend();
 
+    // edge 모드는 등록을 바꿀 필요 없이 connect 전에 쌓인 데이터만 flush
+    if (mTriggerMode != EpollTrigger_Level)
+    {
+        mPendingFlush = mWantSendOut;
+        return true;
+    }
+
     epoll_event ev{};
     ev.data.fd = mSession->Fd();
-    ev.events  = BuildClientEvents(mConnecting, mWantSendOut);
+    ev.events  = BuildEvents();
 
     if (::epoll_ctl(mEpollFd, EPOLL_CTL_MOD, mSession->Fd(), &ev) < 0)
     {
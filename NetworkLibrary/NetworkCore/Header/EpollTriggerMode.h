@@ -0,0 +1,23 @@
+#ifndef EPOLL_TRIGGER_MODE_H
+#define EPOLL_TRIGGER_MODE_H
+
+#include <cstdint>
+#include <sys/epoll.h>
+
+enum eEpollTriggerMode{
+    EpollTrigger_Level = 0,     // 관심이 바뀔 때마다 EPOLL_CTL_MOD
+    EpollTrigger_Edge,          // IN/OUT 을 한 번만 등록, EAGAIN 까지(또는 budget 까지) 읽고 씀
+    EpollTrigger_EdgeOneShot,   // Edge + EPOLLONESHOT. 이벤트 하나를 처리한 뒤 직접 다시 arm 해야 함
+};
+
+// 등록 시 추가로 붙일 플래그
+inline std::uint32_t EpollTriggerFlags(eEpollTriggerMode mode) noexcept
+{
+    switch (mode) {
+    case EpollTrigger_Edge:        return EPOLLET;
+    case EpollTrigger_EdgeOneShot: return EPOLLET | EPOLLONESHOT;
+    default:                       return 0;
+    }
+}
+
+#endif
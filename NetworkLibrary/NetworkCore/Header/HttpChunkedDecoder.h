@@ -0,0 +1,62 @@
+#ifndef HTTP_CHUNKED_DECODER_H
+#define HTTP_CHUNKED_DECODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Transfer-Encoding: chunked body 를 조금씩 받아 푸는 상태 기계 (RFC 9112 7.1).
+//   chunk-size [; ext] CRLF  data CRLF  ...  0 [; ext] CRLF  *(trailer CRLF)  CRLF
+// 입력은 아무 위치에서나 끊겨도 되고, 다음 Next 에서 이어서 본다. data 는 입력을 그대로 가리키므로 복사가 없다.
+// chunk extension 과 trailer 는 읽고 버린다.
+class HttpChunkedDecoder
+{
+public:
+    enum class Result
+    {
+        Chunk_Data,     // outData 에 data 조각 (consumed 에 포함)
+        Chunk_NeedMore, // 입력을 다 먹었음
+        Chunk_Done,     // 마지막 chunk 와 trailer 끝까지 읽음. consumed 뒤는 다음 요청
+        Chunk_Error
+    };
+
+    static constexpr std::size_t kMaxLineBytes = 4096;     // size 줄(extension 포함) / trailer 줄 하나
+    static constexpr std::size_t kMaxTrailerBytes = 16384; // trailer 전체
+
+    // p[0, len) 을 앞에서부터 소비. Chunk_Data 면 outData 를 처리한 뒤 남은 입력(p + consumed)으로 다시 부른다.
+    Result Next(const char *p, std::size_t len, std::size_t &consumed, std::string_view &outData);
+    void Reset();
+
+    bool IsDone() const noexcept { return mState == State::Done; }
+    const char *Error() const noexcept { return mError; }
+    std::uint64_t DecodedBytes() const noexcept { return mDecoded; }
+
+private:
+    enum class State
+    {
+        Size,       // hex 숫자
+        Extension,  // ';' 이후 CR 까지
+        SizeLf,
+        Data,
+        DataCr,
+        DataLf,
+        TrailerStart, // 줄 처음: CR 이면 끝, 아니면 trailer 줄
+        Trailer,
+        TrailerLf,
+        EndLf,
+        Done,
+        Failed
+    };
+
+    Result Fail(const char *why);
+
+    State mState = State::Size;
+    std::uint64_t mChunkLeft = 0;
+    std::uint64_t mDecoded = 0;
+    std::size_t mSizeDigits = 0;
+    std::size_t mLineBytes = 0;
+    std::size_t mTrailerBytes = 0;
+    const char *mError = nullptr;
+};
+
+#endif
@@ -0,0 +1,171 @@
+#ifndef HTTP_HEADER_H
+#define HTTP_HEADER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// 자주 쓰는 header 이름. 파싱할 때 한 번 찾아 두면 이후 조회는 배열 index 다.
+// 순서를 바꾸면 kHttpHeaderNames 도 같이.
+enum class HttpHeader : std::uint8_t
+{
+    Other = 0,          // 표에 없는 이름 (이름 문자열로 비교)
+    Host,
+    ContentLength,
+    ContentType,
+    Connection,
+    TransferEncoding,
+    Expect,
+    KeepAlive,
+    Upgrade,
+    UserAgent,
+    Accept,
+    AcceptEncoding,
+    AcceptLanguage,
+    Authorization,
+    CacheControl,
+    ContentEncoding,
+    Cookie,
+    Date,
+    IfModifiedSince,
+    IfNoneMatch,
+    Origin,
+    Range,
+    Referer,
+    Te,
+    XForwardedFor,
+    Count
+};
+
+namespace HttpHeaderTable
+{
+    constexpr std::size_t kCount = static_cast<std::size_t>(HttpHeader::Count);
+
+    // 소문자. index 는 HttpHeader 값
+    constexpr std::string_view kNames[kCount] = {
+        "",
+        "host",
+        "content-length",
+        "content-type",
+        "connection",
+        "transfer-encoding",
+        "expect",
+        "keep-alive",
+        "upgrade",
+        "user-agent",
+        "accept",
+        "accept-encoding",
+        "accept-language",
+        "authorization",
+        "cache-control",
+        "content-encoding",
+        "cookie",
+        "date",
+        "if-modified-since",
+        "if-none-match",
+        "origin",
+        "range",
+        "referer",
+        "te",
+        "x-forwarded-for",
+    };
+
+    constexpr std::size_t kSlots = 64; // 2 의 거듭제곱
+
+    constexpr char Lower(char c)
+    {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    // 길이와 첫/가운데/끝 글자(소문자)만 본다. 대소문자가 달라도 같은 slot.
+    constexpr std::size_t Hash(std::string_view name, std::uint32_t seed)
+    {
+        const std::uint32_t first = static_cast<unsigned char>(Lower(name.front()));
+        const std::uint32_t mid = static_cast<unsigned char>(Lower(name[name.size() / 2]));
+        const std::uint32_t last = static_cast<unsigned char>(Lower(name.back()));
+        const std::uint32_t h = static_cast<std::uint32_t>(name.size()) * 31u + first * seed + mid * 7u + last;
+        return (h ^ (h >> 5)) & (kSlots - 1);
+    }
+
+    constexpr bool IsPerfect(std::uint32_t seed)
+    {
+        bool used[kSlots] = {};
+        for (std::size_t i = 1; i < kCount; ++i)
+        {
+            const std::size_t s = Hash(kNames[i], seed);
+            if (used[s])
+                return false;
+            used[s] = true;
+        }
+        return true;
+    }
+
+    // 이름끼리 충돌하지 않는 첫 seed (컴파일 타임에 찾음)
+    constexpr std::uint32_t FindSeed()
+    {
+        for (std::uint32_t seed = 1; seed < 4096; ++seed)
+        {
+            if (IsPerfect(seed))
+                return seed;
+        }
+        return 0;
+    }
+
+    constexpr std::uint32_t kSeed = FindSeed();
+    static_assert(kSeed != 0, "no collision-free seed for the known header names");
+
+    struct Slots
+    {
+        HttpHeader id[kSlots] = {};
+    };
+
+    constexpr Slots MakeSlots()
+    {
+        Slots t{};
+        for (std::size_t i = 1; i < kCount; ++i)
+            t.id[Hash(kNames[i], kSeed)] = static_cast<HttpHeader>(i);
+        return t;
+    }
+
+    constexpr Slots kSlotTable = MakeSlots();
+
+    constexpr std::size_t MaxNameLength()
+    {
+        std::size_t n = 0;
+        for (std::size_t i = 1; i < kCount; ++i)
+            n = kNames[i].size() > n ? kNames[i].size() : n;
+        return n;
+    }
+
+    constexpr std::size_t kMaxNameLength = MaxNameLength();
+}
+
+// 이름(대소문자 무관) -> HttpHeader. 표에 없으면 HttpHeader::Other.
+// hash 한 번 + 후보 이름 하나와의 비교.
+constexpr HttpHeader LookupHttpHeader(std::string_view name)
+{
+    if (name.empty() || name.size() > HttpHeaderTable::kMaxNameLength)
+        return HttpHeader::Other;
+
+    const HttpHeader id = HttpHeaderTable::kSlotTable.id[HttpHeaderTable::Hash(name, HttpHeaderTable::kSeed)];
+    const std::string_view known = HttpHeaderTable::kNames[static_cast<std::size_t>(id)];
+    if (id == HttpHeader::Other || known.size() != name.size())
+        return HttpHeader::Other;
+    for (std::size_t i = 0; i < name.size(); ++i)
+    {
+        if (HttpHeaderTable::Lower(name[i]) != known[i])
+            return HttpHeader::Other;
+    }
+    return id;
+}
+
+// 소문자 이름 (Other 는 빈 문자열)
+constexpr std::string_view HttpHeaderName(HttpHeader id)
+{
+    return HttpHeaderTable::kNames[static_cast<std::size_t>(id)];
+}
+
+static_assert(LookupHttpHeader("Content-Length") == HttpHeader::ContentLength);
+static_assert(LookupHttpHeader("x-unknown") == HttpHeader::Other);
+
+#endif
@@ -1,8 +1,11 @@
 #ifndef HTTP_PARSER
 #define HTTP_PARSER
 
+#include "HttpChunkedDecoder.h"
+#include "HttpHeader.h"
 #include "ListenerSocket.h"
 #include <cstdint>
+#include <functional>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -11,32 +14,79 @@
 
 class RecvBuffer;
 
+struct HttpHeaderView{
+    HttpHeader id = HttpHeader::Other;
+    std::string_view name;  // 받은 그대로 (대소문자 유지)
+    std::string_view value; // 앞뒤 공백 제거
+};
+
+// header 는 map 대신 고정 크기 flat 배열에 둔다. 아는 이름은 파싱할 때 HttpHeader 로 바꿔 두므로
+// Header(HttpHeader::Connection) 은 배열 index 하나, 모르는 이름만 순서대로 비교한다.
+// 같은 이름이 여러 번 오면 Header() 는 첫 번째 값.
 struct HttpRequest{
+    static constexpr std::size_t kMaxHeaders = 32;
+
     std::string method;
     std::string target;
     std::string version;
-    std::unordered_map<std::string, std::string> headers;
     std::vector<std::uint8_t> body;
 
-    void Clear(){
-        method.clear();
-        target.clear();
-        version.clear();
-        headers.clear();
-        body.clear();
-    }
+    void Clear();
+
+    // 이름/값을 내부 저장소로 복사. kMaxHeaders 를 넘으면 false
+    bool AddHeader(std::string_view name, std::string_view value);
+    std::size_t HeaderCount() const noexcept { return mFieldCount; }
+    HttpHeaderView HeaderAt(std::size_t i) const noexcept;
+
+    std::optional<std::string_view> Header(HttpHeader id) const noexcept;
+    // 이름은 대소문자 구분 없이 비교
+    std::optional<std::string_view> Header(std::string_view name) const noexcept;
+
+private:
+    struct Field{
+        HttpHeader id;
+        std::uint32_t name;     // mFieldBytes 안의 위치
+        std::uint32_t nameLen;
+        std::uint32_t value;
+        std::uint32_t valueLen;
+    };
+
+    std::string mFieldBytes;    // 모든 이름/값을 이어 붙인 저장소 (요청마다 header 별 할당 없음)
+    Field mFields[kMaxHeaders];
+    std::size_t mFieldCount = 0;
+    std::uint8_t mKnown[HttpHeaderTable::kCount] = {}; // id -> field index + 1 (0 이면 없음)
+};
 
-    std::optional<std::string_view> Header(std::string_view key) const{
-        std:: string k(key);
-        for(auto&c : k) c = (char)std::tolower((unsigned char)c);
+// 복사 없이 recv buffer (또는 parser 의 재사용 buffer) 를 가리키는 요청.
+// HttpParser::FinishView 로 소비하거나 다음 TryParseView 를 부르기 전까지만 유효하다.
+struct HttpRequestView{
+    static constexpr std::size_t kMaxHeaders = HttpRequest::kMaxHeaders;
 
-        auto it = headers.find(k);
-        if (it == headers.end()) return std::nullopt;
+    std::string_view method;
+    std::string_view target;
+    std::string_view version;
+    HttpHeaderView headers[kMaxHeaders];
+    std::size_t headerCount = 0;
+    std::uint8_t known[HttpHeaderTable::kCount] = {}; // id -> headers index + 1 (0 이면 없음)
+    std::string_view body; // TryParseView 만 채움. TryParseStream 의 view 는 항상 비어 있음
 
-        return std::string_view(it->second);
+    void ClearHeaders() noexcept;
+    // kMaxHeaders 를 넘으면 false
+    bool AddHeader(HttpHeader id, std::string_view name, std::string_view value) noexcept;
+
+    std::optional<std::string_view> Header(HttpHeader id) const noexcept{
+        const std::uint8_t at = known[static_cast<std::size_t>(id)];
+        if(id == HttpHeader::Other || at == 0) return std::nullopt;
+        return headers[at - 1].value;
     }
+    // 이름은 대소문자 구분 없이 비교
+    std::optional<std::string_view> Header(std::string_view name) const noexcept;
 };
 
+// 소유하는 HttpRequest 를 같은 view 로 (header 가 kMaxHeaders 를 넘으면 앞쪽만)
+HttpRequestView MakeRequestView(const HttpRequest& rq);
+bool EqualsIgnoreCase(std::string_view a, std::string_view b);
+
 struct HttpResponse{
     int status = 200;
     std::string reason = "OK";
@@ -49,32 +99,93 @@ struct HttpResponse{
     }
 };
 std::vector<std::uint8_t> BuildHttpResponseBytes(const HttpResponse& resp, bool keepAlive);
+// status line + header 만 (body 를 따로 참조로 보낼 때)
+std::vector<std::uint8_t> BuildHttpResponseHead(const HttpResponse& resp, bool keepAlive);
+// body 를 나중에 조각으로 보낼 때. contentLength 가 없으면 Transfer-Encoding: chunked (조각은 호출자가 chunk 로 감쌈)
+std::vector<std::uint8_t> BuildHttpStreamHead(const HttpResponse& resp, bool keepAlive, std::optional<std::size_t> contentLength);
+
+// TryParseStream 이 요청 하나를 조각으로 넘기는 곳. OnHeaders -> OnBodyChunk* -> OnBodyEnd 순서.
+class HttpStreamHandler{
+public:
+    virtual ~HttpStreamHandler() = default;
+
+    // req 는 이 호출 안에서만 유효 (recv buffer 를 가리킴). req.body 는 항상 비어 있고 body 는 OnBodyChunk 로 온다
+    virtual void OnHeaders(const HttpRequestView& req) = 0;
+    // body 조각 (chunked 는 푼 뒤). false 를 돌려주면 parser 가 여기서 멈추고 Http_NeedMore,
+    // 남은 body 는 recv buffer 에 둔 채 다음 TryParseStream 에서 이어서 넘긴다
+    virtual bool OnBodyChunk(std::string_view data) = 0;
+    virtual void OnBodyEnd() = 0;
+};
 
 class HttpParser{
 public:
-    enum class Result {Http_Ok, Http_NeedMore, Http_Error};
+    // Http_TooLarge: TryParseView 전용. 요청 전체가 recv buffer 에 다 들어갈 수 없거나 chunked body 라서 in-place 로 볼 수 없음
+    //                (아무것도 소비하지 않았으므로 같은 위치에서 TryParse 로 이어 가면 된다)
+    enum class Result {Http_Ok, Http_NeedMore, Http_Error, Http_TooLarge};
     
+    // chunked body 조각 (rq 는 header 까지 채워진 요청). TryParse 중에 불린다.
+    using BodyCallback = std::function<void(const HttpRequest& rq, std::string_view data)>;
+
     HttpParser();
     
+    // chunked body 를 rq.body 에 모으지 않고 푼 조각마다 넘긴다 (비우면 rq.body 에 모음)
+    void SetBodyCallback(BodyCallback cb);
+
+    static constexpr std::size_t kDefaultMaxHeaderBytes = 16 * 1024;
+    static constexpr std::size_t kDefaultMaxBufferedBody = 8 * 1024 * 1024;
+
+    // maxHeaderBytes : request line + header (빈 줄 포함). 모든 경로에 적용
+    // maxBufferedBody: TryParse 가 HttpRequest::body 로 모을 수 있는 크기. TryParseStream 은 모으지 않으므로 무관
+    void SetLimits(std::size_t maxHeaderBytes, std::size_t maxBufferedBody);
+
+    // 요청을 HttpRequest 로 복사해 꺼냄 (body 는 maxBufferedBody 까지).
+    // Transfer-Encoding: chunked 도 처리하며 여러 번 호출에 걸쳐 이어서 푼다.
     Result TryParse(RecvBuffer& rb, HttpRequest& rq, std::string* outErr = nullptr);
+    // recv buffer 에 쌓인 요청 하나를 복사 없이 파싱. 연속 구간(Mirrored, 또는 wrap 되지 않은 heap ring)은 그대로 가리키고,
+    // wrap 된 경우에만 재사용 buffer 한 개로 모은다. 성공하면 처리 후 FinishView 로 요청 크기만큼 소비해야 한다.
+    Result TryParseView(RecvBuffer& rb, HttpRequestView& out, std::string* outErr = nullptr);
+    void FinishView(RecvBuffer& rb);
+    // header 는 in-place 로 파싱해 OnHeaders 로, body 는 도착하는 대로 OnBodyChunk 로 넘기고 바로 소비한다.
+    // body 를 모으지 않으므로 크기와 무관하게 메모리는 recv buffer 만큼. 요청 하나가 끝나면 Http_Ok.
+    // 한 요청 안에서 TryParse / TryParseView 와 섞어 부르면 안 된다.
+    Result TryParseStream(RecvBuffer& rb, HttpStreamHandler& handler, std::string* outErr = nullptr);
+    // TryParse 가 요청 중간을 들고 있지 않음 (TryParseView 로 바꿔도 되는 지점)
+    bool IsIdle() const noexcept;
     void Reset();
 
 private:
-    enum class State {Http_RequestLine, Http_Headers, Http_Body};
+    enum class State {Http_RequestLine, Http_Headers, Http_Body, Http_ChunkedBody};
     
     std::string mBuf;
     State mState = State::Http_RequestLine;
     HttpRequest mCur;
     std::size_t mContentLength = 0;
+    std::size_t mHeaderBytes = 0;      // TryParse 가 지금 요청에서 읽은 request line + header 크기
+    HttpChunkedDecoder mChunked;
+    BodyCallback mOnBody;
+    std::size_t mMaxHeaderBytes = kDefaultMaxHeaderBytes;
+    std::size_t mMaxBufferedBody = kDefaultMaxBufferedBody;
+
+    std::string mLinear;          // wrap 된 heap ring 을 모으는 재사용 buffer
+    std::size_t mScanned = 0;     // header 끝("\r\n\r\n")을 이미 찾아본 길이 (NeedMore 반복 시 재검색 방지)
+    std::size_t mViewBytes = 0;   // 마지막 TryParseView 성공 요청의 크기
 
 private:
-    static std::string ToLower(std::string_view s);
-    static std::string Trim(std::string_view s);
-    static bool SplitOnce(std::string_view s, char delim, std::string_view& left, std::string_view& right);
     
     bool PullFromRecvBuffer(RecvBuffer& rb, std::size_t maxPull = 64 * 1024);
     bool PopLine(std::string& outLine);
     bool ParseRequestLine(const std::string& line, std::string* err);
     bool ParseHeaderLine(const std::string& line, std::string* err);
+    Result ParseChunkedBody(RecvBuffer& rb, HttpRequest& rq, std::string* err);
+    Result FinishRequest(HttpRequest& rq);
+    struct HeadInfo{
+        std::size_t bytes = 0;          // 빈 줄까지
+        std::size_t contentLength = 0;
+        bool chunked = false;
+    };
+    // TryParseView / TryParseStream 공용. header 끝이 없고 더 받을 수 없으면 (ring 또는 maxHeaderBytes) Http_TooLarge
+    Result ParseHeadView(RecvBuffer& rb, HttpRequestView& out, std::string_view& buf, HeadInfo& head, std::string* err);
+    static bool ParseRequestLineView(std::string_view line, HttpRequestView& out, std::string* err);
+    static bool ParseHeaderLineView(std::string_view line, HttpRequestView& out, std::string* err);
 };
 #endif
\ No newline at end of file
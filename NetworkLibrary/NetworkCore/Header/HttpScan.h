@@ -0,0 +1,38 @@
+#ifndef HTTP_SCAN_H
+#define HTTP_SCAN_H
+
+#include <cstddef>
+#include <cstdint>
+
+enum eHttpScanLevel
+{
+    HttpScan_Scalar = 0,
+    HttpScan_Sse42,   // 16 byte 씩 (SSE4.2 CPU 에서 SSSE3 pshufb + SSE2 비교)
+    HttpScan_Avx2     // 32 byte 씩
+};
+
+// HttpParser 가 쓰는 구분자/토큰 검색. 시작 시 CPU 를 확인해 가장 넓은 kernel 을 고르고,
+// 짧은 꼬리와 지원하지 않는 CPU 는 scalar 로 처리한다. 결과는 level 과 무관하게 같다.
+class HttpScan
+{
+public:
+    static constexpr size_t npos = SIZE_MAX;
+
+    // c 의 첫 위치
+    static size_t FindByte(const char *p, size_t len, char c) noexcept;
+    // "\r\n" 의 '\r' 위치
+    static size_t FindCrlf(const char *p, size_t len) noexcept;
+    // "\r\n\r\n" 의 첫 '\r' 위치
+    static size_t FindHeaderEnd(const char *p, size_t len) noexcept;
+    // 앞에서부터 연속된 RFC 9110 token 문자(tchar) 수. 구분자(':', ' ')나 잘못된 문자에서 멈추므로
+    // header 이름 검증과 ':' 찾기를 한 번에 한다.
+    static size_t TokenLength(const char *p, size_t len) noexcept;
+    static bool IsTokenChar(char c) noexcept;
+
+    static eHttpScanLevel Level() noexcept;
+    static eHttpScanLevel BestSupportedLevel() noexcept;
+    // 테스트/벤치마크용. CPU 가 지원하지 않는 level 이면 false
+    static bool SetLevel(eHttpScanLevel level) noexcept;
+};
+
+#endif
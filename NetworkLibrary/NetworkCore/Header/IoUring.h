@@ -0,0 +1,137 @@
+#ifndef IO_URING_H
+#define IO_URING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <linux/io_uring.h>
+
+enum eIoUringError
+{
+    IoUring_Ok = 0,
+    IoUring_NotSupported,
+    IoUring_InvalidState,
+    IoUring_SetupFailed,
+    IoUring_MapFailed,
+    IoUring_EnterFailed,
+    IoUring_RegisterFailed,
+    IoUring_Timeout,
+    IoUring_Interrupted
+};
+
+// liburing 없이 syscall 로 직접 쓰는 최소 io_uring 래퍼.
+// SQ/CQ ring 을 mmap 하고 sqe 채우기, 제출, cqe 순회만 제공한다. 한 스레드(이벤트 루프) 전용.
+class IoUring
+{
+public:
+    IoUring() = default;
+    ~IoUring();
+
+    IoUring(const IoUring &) = delete;
+    IoUring &operator=(const IoUring &) = delete;
+
+    // entries 는 SQ 크기 (CQ 는 커널이 2배로 잡음). flags 는 IORING_SETUP_*
+    eIoUringError Open(unsigned entries, unsigned flags = 0);
+    void Close();
+    bool IsOpen() const noexcept;
+    int Fd() const noexcept;
+    unsigned Features() const noexcept;
+
+    // 0 으로 초기화된 sqe. SQ 가 가득 차면 먼저 제출해 자리를 만들고, 그래도 없으면 nullptr.
+    io_uring_sqe *GetSqe() noexcept;
+    // 제출 없이 바로 얻을 수 있는 sqe 수. IOSQE_IO_LINK 체인은 한 번의 제출 안에 있어야 하므로 먼저 확인한다.
+    unsigned SqSpaceLeft() const noexcept;
+    // 쌓인 sqe 를 제출하고 cqe 가 minComplete 개 이상 모일 때까지 최대 timeoutMs 대기 (-1 = 무한)
+    eIoUringError SubmitAndWait(unsigned minComplete, int timeoutMs);
+    eIoUringError Submit();
+
+    // 아직 소비하지 않은 cqe 를 최대 max 개 꺼내 본다. 처리 후 Advance 로 돌려준다.
+    unsigned PeekCqes(io_uring_cqe **out, unsigned max) noexcept;
+    void Advance(unsigned count) noexcept;
+
+    eIoUringError Register(unsigned opcode, void *arg, unsigned nrArgs) noexcept;
+
+    // 커널이 io_uring_setup 을 허용하는지 (seccomp, sysctl 로 막힌 환경 확인용)
+    static bool IsSupported() noexcept;
+
+private:
+    unsigned PendingSqes() const noexcept;
+    int Enter(unsigned toSubmit, unsigned minComplete, unsigned flags, int timeoutMs) noexcept;
+
+private:
+    int mFd = -1;
+    unsigned mFeatures = 0;
+
+    void *mSqRing = nullptr;
+    size_t mSqRingSize = 0;
+    void *mCqRing = nullptr;
+    size_t mCqRingSize = 0;
+    io_uring_sqe *mSqes = nullptr;
+    size_t mSqesSize = 0;
+
+    unsigned *mSqHead = nullptr;
+    unsigned *mSqTail = nullptr;
+    unsigned mSqMask = 0;
+    unsigned mSqEntries = 0;
+    unsigned *mSqArray = nullptr;
+    unsigned mSqLocalTail = 0; // 아직 커널에 공개하지 않은 tail
+
+    unsigned *mCqHead = nullptr;
+    unsigned *mCqTail = nullptr;
+    unsigned mCqMask = 0;
+    io_uring_cqe *mCqes = nullptr;
+};
+
+// multishot recv 가 고를 provided buffer 묶음.
+// 기본은 IORING_REGISTER_PBUF_RING 으로 등록한 buffer ring 이고, 등록은 되지만 실제 선택이 안 되는 커널
+// (recv 가 계속 -ENOBUFS) 이 있어 Open 때 pipe read 로 한 번 확인한 뒤 안 되면 IORING_OP_PROVIDE_BUFFERS 로 내려간다.
+// 커널이 cqe flags 에 buffer id 를 실어 보내고, 다 쓴 버퍼는 Recycle 로 돌려줘야 다시 선택된다.
+class IoUringBufferRing
+{
+public:
+    // PROVIDE_BUFFERS 방식에서 반납 sqe 의 user_data. 이 값의 cqe 는 무시하면 된다.
+    static constexpr std::uint64_t kProvideUserData = ~0ull;
+
+    IoUringBufferRing() = default;
+    ~IoUringBufferRing();
+
+    IoUringBufferRing(const IoUringBufferRing &) = delete;
+    IoUringBufferRing &operator=(const IoUringBufferRing &) = delete;
+
+    // count 는 2의 거듭제곱 (최대 32768). 확인용 요청을 직접 제출하고 기다리므로 ring 에 다른 요청을 걸기 전에 부른다.
+    eIoUringError Open(IoUring &ring, std::uint16_t groupId, unsigned count, size_t bufSize);
+    void Close();
+    bool IsOpen() const noexcept;
+    // false 면 PROVIDE_BUFFERS 방식
+    bool IsMapped() const noexcept;
+
+    std::uint16_t GroupId() const noexcept;
+    size_t BufSize() const noexcept;
+    unsigned Count() const noexcept;
+    const std::uint8_t *Buffer(std::uint16_t bid) const noexcept;
+
+    // 버퍼를 커널에 다시 넘긴다. ring 방식은 tail 공개로 바로, PROVIDE_BUFFERS 방식은 다음 제출 때 반영
+    void Recycle(std::uint16_t bid) noexcept;
+
+    // cqe flags 에서 buffer id 추출 (IORING_CQE_F_BUFFER 가 있을 때만 유효)
+    static std::uint16_t BufferId(std::uint32_t cqeFlags) noexcept;
+
+private:
+    bool OpenMapped();
+    bool ProbeMapped();
+    bool Provide(std::uint16_t bid, unsigned count) noexcept;
+
+private:
+    IoUring *mRing = nullptr;
+    io_uring_buf_ring *mBufRing = nullptr;
+    size_t mRingBytes = 0;
+    std::uint8_t *mBuffers = nullptr;
+    size_t mBufferBytes = 0;
+    size_t mBufSize = 0;
+    unsigned mCount = 0;
+    std::uint16_t mGroupId = 0;
+    std::uint16_t mTail = 0;
+    std::vector<std::uint16_t> mDeferred; // sqe 가 없어 아직 못 넘긴 버퍼 (PROVIDE_BUFFERS 방식)
+};
+
+#endif
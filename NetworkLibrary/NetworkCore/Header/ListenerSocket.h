@@ -35,6 +35,9 @@ public:
 	ListenerSocket(ListenerSocket &&other) noexcept;
 	ListenerSocket &operator=(ListenerSocket &&other) noexcept;
 
+	// Open 전에 설정. 같은 포트에 여러 listener 를 열어 커널이 연결을 분산하게 한다.
+	void SetReusePort(bool enable) noexcept;
+
 	eListenerSocketError Open();
 	eListenerSocketError Accept(Socket &outServerSocket);
 
@@ -48,6 +51,7 @@ private:
 	int mListenSocket;
 	uint16_t mPort;
 	int mBacklog;
+	bool mReusePort{false};
 };
 
 #endif
\ No newline at end of file
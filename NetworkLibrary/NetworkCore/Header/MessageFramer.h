@@ -26,6 +26,8 @@ public:
 
     static eFrameError PopFrame(RecvBuffer& rb, Frame& out);
     static eFrameError Encode(const void* data, std::size_t len, std::vector<std::uint8_t> &out);
+    // payload 를 복사하지 않고 길이 header 만 만든다 (payload 는 호출자가 이어서 보냄)
+    static eFrameError EncodeHeader(std::size_t len, std::uint8_t (&out)[kHeaderSize]);
 private:
     static std::uint32_t ReadU32BE(const std::uint8_t* p);
     static void WriteU32BE(std::uint8_t* p, std::uint32_t v);
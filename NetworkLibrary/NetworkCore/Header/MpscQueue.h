@@ -0,0 +1,88 @@
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+// 여러 producer / 하나의 consumer 용 lock-free queue (Vyukov 방식 linked list).
+// Push 는 아무 스레드에서나, TryPop 은 consumer 스레드 하나에서만 호출해야 한다.
+// producer 가 링크를 마치기 전 잠깐 비어 보일 수 있으므로 Push 후 consumer 를 깨우는 쪽에서 다시 TryPop 하면 된다.
+template <typename T>
+class MpscQueue
+{
+public:
+    MpscQueue()
+        : mHead(&mStub), mTail(&mStub)
+    {
+    }
+
+    ~MpscQueue()
+    {
+        // mTail 은 값이 없는 stub, 그 뒤 노드들은 아직 꺼내지 않은 값을 갖고 있다.
+        Node *node = mTail->next.load(std::memory_order_acquire);
+        while (node) {
+            Node *next = node->next.load(std::memory_order_acquire);
+            node->Value()->~T();
+            delete node;
+            node = next;
+        }
+        if (mTail != &mStub) {
+            delete mTail;
+        }
+    }
+
+    MpscQueue(const MpscQueue &) = delete;
+    MpscQueue &operator=(const MpscQueue &) = delete;
+
+    void Push(T &&value)
+    {
+        Node *node = new Node;
+        ::new (node->Storage()) T(std::move(value));
+
+        Node *prev = mHead.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    bool TryPop(T &out)
+    {
+        Node *tail = mTail;
+        Node *next = tail->next.load(std::memory_order_acquire);
+        if (next == nullptr) {
+            return false;
+        }
+
+        // next 가 새 stub 이 되므로 값은 꺼낸 뒤 바로 소멸시킨다.
+        T *value = next->Value();
+        out = std::move(*value);
+        value->~T();
+
+        mTail = next;
+        if (tail != &mStub) {
+            delete tail;
+        }
+        return true;
+    }
+
+    bool IsEmpty() const
+    {
+        return mTail->next.load(std::memory_order_acquire) == nullptr;
+    }
+
+private:
+    struct Node
+    {
+        std::atomic<Node *> next{nullptr};
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        void *Storage() noexcept { return storage; }
+        T *Value() noexcept { return std::launder(reinterpret_cast<T *>(storage)); }
+    };
+
+    Node mStub;
+    alignas(64) std::atomic<Node *> mHead;  // producer 쪽
+    alignas(64) Node *mTail;                // consumer 쪽
+};
+
+#endif
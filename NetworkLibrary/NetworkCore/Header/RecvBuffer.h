@@ -17,7 +17,7 @@
 
     class RecvBuffer{
     public:
-        explicit RecvBuffer(size_t bufSize);
+        explicit RecvBuffer(size_t bufSize, eRingBufferMode mode = RingBuffer_Heap);
         ~RecvBuffer();
 
         RecvBuffer(const RecvBuffer&) = delete;
@@ -33,6 +33,14 @@
         eRecvBufferError Peek(void* dst, size_t len, size_t& outPeek);
         eRecvBufferError Consume(size_t len);
         eRecvBufferError Write(const void* src, size_t len, size_t& outWrite);
+
+        // 복사 없이 읽을 수 있는 연속 구간. Mirrored 모드에서는 쌓인 데이터 전체.
+        eRecvBufferError PeekContiguous(const std::uint8_t*& outData, size_t& outLen) const;
+
+        // ring 메모리를 readv/writev/recvmsg 에 직접 넘기기 위한 scatter/gather 구간
+        eRecvBufferError GetReadableSpans(struct iovec* outSpans, int maxSpans, int& outCount) const;
+        eRecvBufferError GetWritableSpans(struct iovec* outSpans, int maxSpans, int& outCount);
+        eRecvBufferError CommitWrite(size_t len);
         
         size_t BufSize() const noexcept;
         size_t WriteSpace() const noexcept;
@@ -40,7 +48,13 @@
 
         bool IsOpen() const;
         bool IsEmpty() const;
-        bool IsFull() const;        
+        bool IsFull() const;
+        bool IsMirrored() const;
+
+        // ring 저장 공간을 비어 있는 동안 RingStoragePool 에 돌려준다 (Segmented 송신은 이미 segment pool 사용)
+        void SetLazyStorage(bool lazy) noexcept;
+        void ReleaseIdleStorage() noexcept;
+        bool HasStorage() const noexcept;
 
     private:
         std::unique_ptr<RingBuffer> mRingBuffer;
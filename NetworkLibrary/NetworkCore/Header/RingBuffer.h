@@ -2,12 +2,27 @@
 #define RING_BUFFER_H
 
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <memory>
 #include <cstdint>
 
+enum eRingBufferMode{
+    RingBuffer_Heap = 0,
+    RingBuffer_Mirrored,
+};
+
+// mReadPos / mWritePos 는 wrap 되지 않는 64bit 누적 카운터이다.
+// 실제 인덱스는 용량이 2의 거듭제곱이면 mask, 아니면 modulo 로 계산하며
+// full/empty 는 두 카운터의 차이로만 판단한다.
+//
+// Mirrored 모드는 같은 물리 페이지(memfd)를 가상 주소에 두 번 연속으로 매핑한다.
+// 용량은 페이지 크기의 2의 거듭제곱 배로 올림되며, 읽기/쓰기 영역이 항상 연속이다.
+//
+// 저장 공간은 스레드별 RingStoragePool 에서 빌리고 돌려준다 (heap 모드는 SlabAllocator 의 size class 블록). Lazy 로 두면 비는 순간 반납하고
+// 다음 쓰기에서 다시 빌리므로, 데이터가 없는 연결은 저장 공간을 갖지 않는다.
 class RingBuffer{
 public:
-    explicit RingBuffer(size_t bufSize);
+    explicit RingBuffer(size_t bufSize, eRingBufferMode mode = RingBuffer_Heap);
     ~RingBuffer();
 
     RingBuffer(const RingBuffer&) = delete;
@@ -16,26 +31,61 @@ public:
     RingBuffer(RingBuffer&& other) noexcept;
     RingBuffer& operator=(RingBuffer&& other) noexcept;
 
+    // lazy 모드에서는 저장 공간도 pool 로 반납
     void Reset();
     void Close();
     std::size_t Read(void* dst, size_t len);
     std::size_t Peek(void* dst, size_t len);
     void Consume(size_t len);
     std::size_t Write(const void* src, size_t len);
-    
+
+    // 복사 없이 접근 가능한 연속 구간. Mirrored 모드에서는 항상 전체 데이터/여유 공간.
+    const std::uint8_t* ReadRegion(size_t& outLen) const noexcept;
+    std::uint8_t* WriteRegion(size_t& outLen) noexcept;
+
+    // readv/writev 에 그대로 넘길 수 있는 iovec (최대 2개, Mirrored 는 1개). 반환값은 채운 개수.
+    int GetReadableSpans(struct iovec* outSpans, int maxSpans) const noexcept;
+    int GetWritableSpans(struct iovec* outSpans, int maxSpans) noexcept;
+    // GetWritableSpans 로 직접 채운 바이트를 데이터로 확정
+    std::size_t CommitWrite(size_t len) noexcept;
+
+    // true 면 빌 때마다 저장 공간을 반납하고 쓰기 시점에 다시 할당 (idle keep-alive 연결용)
+    void SetLazy(bool lazy) noexcept;
+    bool IsLazy() const noexcept;
+    bool HasStorage() const noexcept;
+    // lazy 이고 비어 있으면 저장 공간 반납
+    void ReleaseIfEmpty() noexcept;
+
     size_t BufSize() const noexcept;
     size_t DataSpace() const noexcept;
     size_t FreeSpace() const noexcept;
 
     bool IsEmpty() const;
-    bool IsFull() const;        
+    bool IsFull() const;
+    bool IsPowerOfTwo() const noexcept;
+    bool IsMirrored() const noexcept;
+
+    static bool IsPowerOfTwo(size_t value) noexcept;
+    static size_t RoundUpPowerOfTwo(size_t value) noexcept;
+
+private:
+    bool EnsureStorage() noexcept;
+    bool AllocateMirrored() noexcept;
+    void ReleaseStorage() noexcept;
+
+    size_t Index(std::uint64_t pos) const noexcept;
+    void CopyOut(std::uint64_t pos, void* dst, size_t len) const;
+    void CopyIn(std::uint64_t pos, const void* src, size_t len);
 
 private:
-    std::unique_ptr<std::uint8_t[]> mBuf;
-    bool mIsFull{false};
-    size_t mReadPos;
-    size_t mWritePos;
+    std::uint8_t* mBuf{nullptr};
+    bool mIsMirrored{false};
+    bool mWantMirrored{false};
+    bool mLazy{false};
+    std::uint64_t mReadPos;
+    std::uint64_t mWritePos;
     size_t mBufSize;
+    size_t mMask;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,50 @@
+#ifndef RING_STORAGE_POOL_H
+#define RING_STORAGE_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// RingBuffer 저장 공간의 출입구. 놀고 있는 keep-alive 연결은 버퍼를 여기로 돌려주고 데이터가 올 때 다시 빌린다.
+// - heap 블록: SlabAllocator 로 바로 넘긴다 (size class 별 스레드 cache 가 그쪽에 있음)
+// - mirrored 매핑: 만들기 비싸므로(memfd + mmap 3번) 용량별로 여기 보관했다가 재사용
+// event loop 스레드마다 하나씩 쓰는 것을 전제로 하며 thread-safe 하지 않다.
+class RingStoragePool{
+public:
+    static constexpr std::size_t kDefaultMaxCachedBytes = 64 * 1024 * 1024;
+
+    struct Block{
+        std::uint8_t* buf{nullptr};
+        std::size_t capacity{0};
+        bool mirrored{false};
+    };
+
+    explicit RingStoragePool(std::size_t maxCachedBytes = kDefaultMaxCachedBytes);
+    ~RingStoragePool();
+
+    RingStoragePool(const RingStoragePool&) = delete;
+    RingStoragePool& operator=(const RingStoragePool&) = delete;
+
+    // heap 은 slab 에서 할당. mirrored 는 보관 중인 매핑이 있을 때만 true (새 매핑은 RingBuffer 쪽).
+    bool Acquire(std::size_t capacity, bool mirrored, Block& out) noexcept;
+    // heap 은 slab 으로, mirrored 는 상한을 넘으면 바로 해제
+    void Release(const Block& block) noexcept;
+    void Trim() noexcept;
+
+    std::size_t CachedBlocks() const noexcept;
+    std::size_t CachedBytes() const noexcept;
+    std::size_t MaxCachedBytes() const noexcept;
+    void SetMaxCachedBytes(std::size_t bytes) noexcept;
+
+    static void Free(const Block& block) noexcept;
+
+    // 현재 스레드 전용 pool
+    static RingStoragePool& Local();
+
+private:
+    std::vector<Block> mFree;
+    std::size_t mCachedBytes{0};
+    std::size_t mMaxCachedBytes;
+};
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef SEGMENT_POOL_H
+#define SEGMENT_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "SharedBuffer.h"
+
+// SegmentQueue 를 구성하는 노드.
+// - data segment: 헤더 뒤에 kCapacity 바이트의 저장 공간이 붙어 있음
+// - shared segment: 저장 공간 없이 SharedBuffer 를 참조하고, 앞에 작은 prefix(프레임 헤더 등)를 inline 으로 가짐
+//   readPos/writePos 는 prefix + body 를 이어 붙인 논리 구간 기준
+struct SendSegment{
+    static constexpr std::size_t kCapacity  = 16 * 1024;
+    static constexpr std::size_t kMaxPrefix = 16;
+
+    SendSegment* next{nullptr};
+    std::size_t readPos{0};
+    std::size_t writePos{0};
+    bool isShared{false};
+
+    SharedBuffer shared;
+    std::uint8_t prefixLen{0};
+    std::uint8_t prefix[kMaxPrefix];
+
+    std::size_t Readable() const noexcept { return writePos - readPos; }
+    std::size_t Writable() const noexcept { return isShared ? 0 : kCapacity - writePos; }
+
+    std::uint8_t* Data() noexcept { return reinterpret_cast<std::uint8_t*>(this + 1); }
+    const std::uint8_t* Data() const noexcept { return reinterpret_cast<const std::uint8_t*>(this + 1); }
+};
+
+// 다 쓴 segment 를 free list 에 보관했다가 재사용한다.
+// event loop 스레드마다 하나씩 쓰는 것을 전제로 하며 thread-safe 하지 않다.
+class SegmentPool{
+public:
+    static constexpr std::size_t kDefaultMaxCached = 1024;
+
+    explicit SegmentPool(std::size_t maxCached = kDefaultMaxCached);
+    ~SegmentPool();
+
+    SegmentPool(const SegmentPool&) = delete;
+    SegmentPool& operator=(const SegmentPool&) = delete;
+
+    SendSegment* Acquire();
+    SendSegment* AcquireShared(SharedBuffer buffer, const void* prefix, std::size_t prefixLen);
+    void Release(SendSegment* segment) noexcept;
+    void Reserve(std::size_t count);
+    void Trim() noexcept;
+
+    std::size_t CachedCount() const noexcept;
+    std::size_t MaxCached() const noexcept;
+    void SetMaxCached(std::size_t maxCached) noexcept;
+
+    // 현재 스레드 전용 pool
+    static SegmentPool& Local();
+
+private:
+    static SendSegment* NewDataSegment();
+    static void DeleteSegment(SendSegment* segment) noexcept;
+
+private:
+    SendSegment* mFreeList{nullptr};
+    SendSegment* mSharedFreeList{nullptr};
+    std::size_t mCached{0};
+    std::size_t mSharedCached{0};
+    std::size_t mMaxCached;
+};
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef SEGMENT_QUEUE_H
+#define SEGMENT_QUEUE_H
+
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <cstddef>
+#include <cstdint>
+
+#include "SegmentPool.h"
+
+// pool 에서 빌린 segment 를 linked list 로 이어 붙인 byte queue.
+// 필요한 만큼 segment 를 늘리고, 다 보낸 segment 는 즉시 pool 로 돌려준다.
+// maxBytes 가 0 이면 크기 제한 없음. SharedBuffer 참조 노드를 섞어 넣을 수 있다.
+class SegmentQueue{
+public:
+    explicit SegmentQueue(size_t maxBytes, SegmentPool& pool = SegmentPool::Local());
+    ~SegmentQueue();
+
+    SegmentQueue(const SegmentQueue&) = delete;
+    SegmentQueue& operator=(const SegmentQueue&) = delete;
+
+    SegmentQueue(SegmentQueue&& other) noexcept;
+    SegmentQueue& operator=(SegmentQueue&& other) noexcept;
+
+    void Clear() noexcept;
+
+    std::size_t Write(const void* src, size_t len);
+    // payload 를 복사하지 않고 참조로 추가. prefix(최대 SendSegment::kMaxPrefix 바이트)는 노드 안에 복사된다.
+    bool AppendShared(SharedBuffer buffer, const void* prefix = nullptr, size_t prefixLen = 0);
+    // head 가 shared segment 면 buffer 와 아직 안 보낸 prefix 길이, body 오프셋을 돌려준다.
+    bool PeekSharedHead(SharedBuffer& outBuffer, size_t& outPrefixRemain, size_t& outBodyOffset) const;
+    std::size_t Peek(void* dst, size_t len) const;
+    std::size_t Read(void* dst, size_t len);
+    void Consume(size_t len) noexcept;
+
+    int GetReadableSpans(struct iovec* outSpans, int maxSpans) const noexcept;
+    int GetWritableSpans(struct iovec* outSpans, int maxSpans);
+    std::size_t CommitWrite(size_t len) noexcept;
+
+    size_t MaxBytes() const noexcept;
+    size_t DataSpace() const noexcept;
+    size_t FreeSpace() const noexcept;
+    size_t SegmentCount() const noexcept;
+
+    bool IsEmpty() const noexcept;
+    bool IsFull() const noexcept;
+
+private:
+    SendSegment* AppendSegment();
+    void LinkTail(SendSegment* segment) noexcept;
+    void PopHead() noexcept;
+
+    static int SegmentSpans(const SendSegment* segment, struct iovec* outSpans, int maxSpans) noexcept;
+
+private:
+    SegmentPool* mPool;
+    SendSegment* mHead{nullptr};
+    SendSegment* mTail{nullptr};
+    size_t mSize{0};
+    size_t mSegmentCount{0};
+    size_t mMaxBytes;
+};
+
+#endif
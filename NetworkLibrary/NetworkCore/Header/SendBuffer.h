@@ -5,6 +5,7 @@
 #include <memory>
 #include <cstdint>
 #include "RingBuffer.h"
+#include "SegmentQueue.h"
 
 enum eSendBufferError{
     SendBuf_Ok = 0,
@@ -15,9 +16,16 @@ enum eSendBufferError{
     SendBuf_InternalError,
 };
 
+enum eSendBufferMode{
+    SendBufMode_Ring = 0,
+    SendBufMode_Segmented,
+};
+
+// Ring 모드: 고정 크기 RingBuffer (bufSize 가 용량)
+// Segmented 모드: pool segment 를 이어 붙이는 SegmentQueue (bufSize 는 최대 적재량, 0 이면 무제한)
 class SendBuffer{
 public:
-    explicit SendBuffer(size_t bufSize);
+    explicit SendBuffer(size_t bufSize, eRingBufferMode mode = RingBuffer_Heap, eSendBufferMode sendMode = SendBufMode_Ring);
     ~SendBuffer();
 
     SendBuffer(const SendBuffer&) = delete;
@@ -31,10 +39,22 @@ public:
     void             Close();
 
     eSendBufferError Write(const void* src, size_t len, size_t& outWrite);
+    // Segmented 모드는 buffer 를 참조로만 큐에 넣고, Ring 모드는 prefix + buffer 를 복사한다.
+    eSendBufferError WriteShared(SharedBuffer buffer, const void* prefix = nullptr, size_t prefixLen = 0);
+    // 맨 앞 데이터가 SharedBuffer 참조일 때만 Ok (Ring 모드는 항상 Underflow)
+    eSendBufferError PeekSharedHead(SharedBuffer& outBuffer, size_t& outPrefixRemain, size_t& outBodyOffset) const;
     eSendBufferError Read(void* dst, size_t len, size_t& outRead);
     eSendBufferError Peek(void* dst, size_t len, size_t& outPeek);
     eSendBufferError Consume(size_t len);
 
+    // 복사 없이 읽을 수 있는 연속 구간. Mirrored 모드에서는 쌓인 데이터 전체.
+    eSendBufferError PeekContiguous(const std::uint8_t*& outData, size_t& outLen) const;
+
+    // ring(segment) 메모리를 readv/writev/recvmsg 에 직접 넘기기 위한 scatter/gather 구간
+    eSendBufferError GetReadableSpans(struct iovec* outSpans, int maxSpans, int& outCount) const;
+    eSendBufferError GetWritableSpans(struct iovec* outSpans, int maxSpans, int& outCount);
+    eSendBufferError CommitWrite(size_t len);
+
     size_t BufSize()    const noexcept;
     size_t WriteSpace() const noexcept; 
     size_t FreeSpace()  const noexcept;
@@ -42,10 +62,18 @@ public:
     bool IsOpen()  const;
     bool IsEmpty() const;
     bool IsFull()  const;
+    bool IsMirrored() const;
+
+    // ring 저장 공간을 비어 있는 동안 RingStoragePool 에 돌려준다 (Segmented 송신은 이미 segment pool 사용)
+    void SetLazyStorage(bool lazy) noexcept;
+    void ReleaseIdleStorage() noexcept;
+    bool HasStorage() const noexcept;
+    eSendBufferMode Mode() const noexcept;
 
 private:
-    std::unique_ptr<RingBuffer> mRingBuffer;
-    bool                        mIsOpen{false};
+    std::unique_ptr<RingBuffer>   mRingBuffer;
+    std::unique_ptr<SegmentQueue> mSegments;
+    bool                          mIsOpen{false};
 };
 
 #endif
@@ -4,9 +4,11 @@
 #include "Socket.h"
 #include "RecvBuffer.h"
 #include "SendBuffer.h"
+#include "ZeroCopyLinger.h"
 
 #include <functional>
 #include <chrono>
+#include <deque>
 
 enum eSessionError
 {
@@ -37,8 +39,13 @@ public:
     using CloseCallback = std::function<void(Session &)>;
     using FrameCallback = std::function<void(Session &, const std::uint8_t*, std::size_t)>;
     using WriteInterestCallback = std::function<void(Session &, bool enable)>;
+    using WatermarkCallback = std::function<void(Session &, bool aboveHigh)>;
 public:
-    Session(size_t recvBufSize, size_t sendBufSize, Socket &&socket);
+    static constexpr size_t kDefaultMaxSendBatch = 256 * 1024;
+    static constexpr int kMaxSendSpans = 16;
+    static constexpr size_t kDefaultZeroCopyThreshold = 64 * 1024;
+
+    Session(size_t recvBufSize, size_t sendBufSize, Socket &&socket, eRingBufferMode bufferMode = RingBuffer_Heap, eSendBufferMode sendMode = SendBufMode_Ring);
     ~Session();
 
     Session(const Session &) = delete;
@@ -49,6 +56,10 @@ public:
 
     eSessionError Open(size_t recvBufSize, size_t sendBufSize);
     void Close();
+    // 닫힌 세션에 새 소켓을 붙여 재사용한다 (SessionPool). 버퍼 메모리는 그대로 두고
+    // 콜백과 연결별 설정은 기본값으로 돌린다. 이후 Open 을 다시 불러야 한다.
+    // 닫히지 않았거나 송신이 남아 있으면 실패하며, 이때 socket 은 그대로 남는다.
+    eSessionError Reattach(Socket &&socket);
 
     bool IsOpen() const;
 
@@ -56,15 +67,54 @@ public:
     eSessionError FlushSend();
     eSessionError QueueSend(const void *data, size_t len);
     eSessionError SendFrame(const void *payload, std::size_t len);
+    // broadcast 용: 같은 buffer 를 여러 세션이 참조만 하고 보낸다 (Segmented 모드에서 복사 없음)
+    eSessionError QueueSendShared(SharedBuffer buffer);
+    eSessionError SendFrameShared(SharedBuffer payload);
 
+    // recv/frame 콜백이 없으면 읽기만 하고 dispatch 는 호출자 몫이다 (RecvBuf 를 직접 소비).
+    // 이때 ring 이 차면 더 읽지 않고 NeedsReadRetry 로 알린다.
     eSessionError OnReadable();
     eSessionError OnWritable();
+    // watermark 로 멈췄던 동안 recv buffer 에 남아 있던 데이터를 다시 콜백으로 넘긴다.
+    eSessionError ResumeRecv();
+    // EPOLLERR: zerocopy 완료 통지를 회수하고, 실제 소켓 에러면 세션을 닫는다.
+    eSessionError OnError();
+
+    // completion 기반 backend (io_uring) 용 입구. 커널이 이미 읽어 온 data 를 recv buffer 에 넣고 콜백을 돌린다.
+    // buffer 가 차면 콜백으로 비워 가며 넣는다. paused 라서 다 못 넣으면 outAccepted < len 으로 돌려주고, 나머지는 호출자가 들고 있다가 다시 넘긴다.
+    eSessionError DeliverRecv(const void *data, size_t len, size_t &outAccepted);
+    // 보낼 구간을 소비하지 않고 꺼낸다 (최대 mMaxSendBatch). CompleteSend 로 모두 돌려받기 전까지는 새 구간을 주지 않으며,
+    // 그 사이 Close 되어도 구간 메모리는 유지된다. zerocopy 경로는 쓰지 않는다.
+    int PrepareSend(struct iovec *outSpans, int maxSpans, size_t &outBytes);
+    // PrepareSend 구간 중 attempted 바이트를 맡겼던 요청이 끝남. 실제로 나간 sent 만큼 소비하고 send 콜백/watermark 를 갱신한다.
+    eSessionError CompleteSend(size_t attempted, size_t sent);
+    bool IsSendInFlight() const noexcept;
 
     void SetRecvCallback(RecvCallback callback);
     void SetSendCallback(SendCallback callback);
     void SetCloseCallback(CloseCallback callback);
     void SetFrameCallback(FrameCallback callback);
     void SetWriteInterestCallback(WriteInterestCallback callback);
+    void SetWatermarkCallback(WatermarkCallback callback);
+    // 송신 큐가 high 이상이면 paused(콜백 true), low 이하로 빠지면 해제(콜백 false). high 0 = 사용 안 함
+    eSessionError SetSendWatermarks(size_t low, size_t high);
+    bool IsSendPaused() const noexcept;
+    // writev 한 번에 내보낼 최대 바이트 수
+    void SetMaxSendBatch(size_t bytes) noexcept;
+    // OnReadable/OnWritable 한 번에 읽고 쓸 최대 바이트 수. edge-triggered 에서 한 연결이 loop 를 독점하지 않게 함
+    // 0 이면 읽기는 recv ring 한 바퀴, 쓰기는 EAGAIN 까지
+    void SetIoBudget(size_t bytes) noexcept;
+    // recv/send ring 을 비어 있는 동안 반납 (idle keep-alive 연결의 메모리를 줄임). SessionPool 재사용 시에도 유지됨
+    void SetLazyBuffers(bool lazy) noexcept;
+    // 직전 OnReadable/OnWritable 이 EAGAIN 전에(budget, ring full) 멈췄음. edge-triggered 에서는 새 이벤트가 오지 않으므로 다시 불러야 한다.
+    bool NeedsReadRetry() const noexcept;
+    bool NeedsWriteRetry() const noexcept;
+    // Segmented 모드 전용. threshold 이상 남은 SharedBuffer body 는 MSG_ZEROCOPY 로 보내고
+    // 커널 완료 통지가 올 때까지 참조를 유지한다. 작은 쓰기는 기존 복사 경로.
+    // 통지 전에 Close 되면 socket 과 함께 ZeroCopyLinger 로 넘겨 통지를 받은 뒤 놓는다.
+    eSessionError EnableZeroCopy(size_t threshold = kDefaultZeroCopyThreshold);
+    bool IsZeroCopyEnabled() const noexcept;
+    size_t PendingZeroCopyCount() const noexcept;
 
     int Fd() const;
     eSessionState State() const;
@@ -80,6 +130,12 @@ public:
     bool IsIdleTimeout(std::chrono::milliseconds timeout) const noexcept;
 
 private:
+    eSessionError DrainSendBuffer();
+    eSessionError DispatchRecv();
+    void UpdateSendWatermark();
+    bool PrepareZeroCopySpan(struct iovec &outSpan, SharedBuffer &outPinned) const;
+
+    bool HasRecvCallback() const noexcept;
     void InvokeRecvCallback();
     void InvokeSendCallback(size_t sentBytes);
     void InvokeCloseCallback();
@@ -97,6 +153,19 @@ private:
     CloseCallback mCloseCallback;
     FrameCallback mFrameCallback;
     WriteInterestCallback mWriteInterestCallback;
+    WatermarkCallback mWatermarkCallback;
+    size_t mMaxSendBatch = kDefaultMaxSendBatch;
+    size_t mIoBudget = 0;
+    bool mReadRetry = false;
+    bool mWriteRetry = false;
+    size_t mSendInFlight = 0; // PrepareSend 로 커널에 맡긴 뒤 아직 완료되지 않은 바이트
+    size_t mSendLowWatermark = 0;
+    size_t mSendHighWatermark = 0;
+    bool mSendPaused = false;
+
+    size_t mZeroCopyThreshold = 0; // 0 = 사용 안 함
+    std::uint32_t mZeroCopySeq = 0;
+    std::deque<ZeroCopyPin> mZeroCopyPending;
 
     std::chrono::steady_clock::time_point mLastActive;
 };
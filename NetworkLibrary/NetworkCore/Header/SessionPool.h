@@ -0,0 +1,53 @@
+#ifndef SESSION_POOL_H
+#define SESSION_POOL_H
+
+#include <cstddef>
+#include <vector>
+
+#include "Session.h"
+
+// 닫힌 Session 을 recv/send 버퍼 메모리째 보관했다가 새 연결에 다시 붙여 준다.
+// 같은 크기/모드의 세션만 다루며, event loop 스레드 하나에서만 쓴다 (thread-safe 하지 않음).
+class SessionPool{
+public:
+    static constexpr std::size_t kDefaultMaxCached = 256;
+
+    SessionPool(std::size_t recvBufSize, std::size_t sendBufSize,
+                eRingBufferMode bufferMode = RingBuffer_Heap,
+                eSendBufferMode sendMode = SendBufMode_Ring,
+                std::size_t maxCached = kDefaultMaxCached);
+
+    SessionPool(const SessionPool&) = delete;
+    SessionPool& operator=(const SessionPool&) = delete;
+
+    // 보관 중인 세션이 있으면 꺼내 socket 을 붙이고, 없으면 새로 만든다. Open 은 호출자가 한다.
+    Session Acquire(Socket&& socket);
+    // 열려 있으면 닫은 뒤 보관. 상한을 넘으면 그냥 버린다.
+    void Release(Session&& session);
+    // 미리 만들어 두기 (accept 경로에서 할당이 생기지 않도록)
+    void Reserve(std::size_t count);
+    void Trim() noexcept;
+
+    std::size_t CachedCount() const noexcept;
+    std::size_t MaxCached() const noexcept;
+    void SetMaxCached(std::size_t maxCached);
+
+    std::size_t Hits() const noexcept;
+    std::size_t Misses() const noexcept;
+
+private:
+    Session NewSession(Socket&& socket) const;
+
+private:
+    std::size_t mRecvBufSize;
+    std::size_t mSendBufSize;
+    eRingBufferMode mBufferMode;
+    eSendBufferMode mSendMode;
+    std::size_t mMaxCached;
+
+    std::vector<Session> mFree;
+    std::size_t mHits{0};
+    std::size_t mMisses{0};
+};
+
+#endif
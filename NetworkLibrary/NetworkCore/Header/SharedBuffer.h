@@ -0,0 +1,23 @@
+#ifndef SHARED_BUFFER_H
+#define SHARED_BUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// 여러 세션에 같은 payload 를 보낼 때 바이트 대신 참조만 큐에 넣기 위한 불변 버퍼
+using SharedBuffer = std::shared_ptr<const std::vector<std::uint8_t>>;
+
+inline SharedBuffer MakeSharedBuffer(const void* data, std::size_t len)
+{
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+    return std::make_shared<const std::vector<std::uint8_t>>(bytes, bytes + len);
+}
+
+inline SharedBuffer MakeSharedBuffer(std::vector<std::uint8_t>&& bytes)
+{
+    return std::make_shared<const std::vector<std::uint8_t>>(std::move(bytes));
+}
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef SLAB_ALLOCATOR_H
+#define SLAB_ALLOCATOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+enum eSlabBacking{
+    SlabBacking_Default = 0,
+    SlabBacking_TransparentHuge,    // 2MB 정렬 chunk + madvise(MADV_HUGEPAGE)
+    SlabBacking_HugeTlb,            // MAP_HUGETLB (예약된 hugepage 가 없으면 TransparentHuge 로 fallback)
+};
+
+struct SlabStats{
+    std::size_t reservedBytes{0};    // OS 에서 받아 둔 chunk 총량
+    std::size_t inUseBytes{0};       // 호출자에게 나가 있는 블록 (size class 기준)
+    std::size_t freeBytes{0};        // chunk 에서 잘라냈지만 free list / thread cache 에 있는 블록
+    std::size_t highWaterBytes{0};   // inUseBytes 최대치
+    std::size_t hugeTlbChunks{0};
+    std::size_t directBytes{0};      // 최대 class 보다 커서 chunk 를 거치지 않은 할당
+};
+
+// ring 저장 공간용 size class(2의 거듭제곱) slab 할당기.
+// 2MB chunk 에서 블록을 잘라 연결 버퍼들을 적은 수의 큰 페이지에 모은다.
+// 블록은 스레드별 cache 에서 먼저 꺼내고, 모자라거나 넘치면 batch 로 공용 free list 와 주고받는다.
+// 잘라낸 블록은 OS 에 돌려주지 않고 재사용한다.
+class SlabAllocator{
+public:
+    static constexpr int kMinClassBits = 6;             // 64B
+    static constexpr int kMaxClassBits = 22;            // 4MB
+    static constexpr int kClassCount = kMaxClassBits - kMinClassBits + 1;
+    static constexpr std::size_t kChunkSize = 2 * 1024 * 1024;
+    static constexpr std::uint32_t kThreadCacheMax = 32; // class 당 스레드 cache 상한 (블록 수)
+    static constexpr std::uint32_t kBatch = 8;
+
+    SlabAllocator() = default;
+    ~SlabAllocator();
+
+    SlabAllocator(const SlabAllocator&) = delete;
+    SlabAllocator& operator=(const SlabAllocator&) = delete;
+
+    // size 는 Free 때 같은 값을 넘겨야 한다 (class 를 다시 계산).
+    void* Allocate(std::size_t size) noexcept;
+    void Free(void* block, std::size_t size) noexcept;
+
+    // 이후 새로 잡는 chunk 에만 적용
+    void SetBacking(eSlabBacking backing) noexcept;
+    eSlabBacking Backing() const noexcept;
+
+    SlabStats Stats() const noexcept;
+
+    static std::size_t ClassSize(std::size_t size) noexcept;
+
+    // 프로세스 전역 인스턴스 (스레드 cache 가 종료 시점에 블록을 돌려줄 수 있도록 소멸시키지 않음)
+    static SlabAllocator& Global();
+
+private:
+    struct FreeNode{
+        FreeNode* next;
+    };
+
+    struct ThreadCache{
+        SlabAllocator* owner{nullptr};
+        FreeNode* head[kClassCount]{};
+        std::uint32_t count[kClassCount]{};
+        ~ThreadCache();
+    };
+
+    static int ClassIndex(std::size_t size) noexcept;
+    ThreadCache& LocalCache() noexcept;
+
+    // mMutex 를 잡은 상태에서 호출
+    std::uint32_t RefillLocked(int cls, FreeNode*& outHead) noexcept;
+    std::uint8_t* CarveLocked(std::size_t classSize) noexcept;
+    std::uint8_t* MapChunk(std::size_t size) noexcept;
+
+    void ReturnToCentral(int cls, FreeNode* head, FreeNode* tail) noexcept;
+    void AddInUse(std::ptrdiff_t delta) noexcept;
+
+private:
+    mutable std::mutex mMutex;
+    FreeNode* mFree[kClassCount]{};
+    std::uint8_t* mBumpCur{nullptr};
+    std::uint8_t* mBumpEnd{nullptr};
+    std::vector<std::pair<void*, std::size_t>> mChunks;
+
+    std::atomic<eSlabBacking> mBacking{SlabBacking_Default};
+    std::atomic<std::size_t> mReserved{0};
+    std::atomic<std::size_t> mCarved{0};
+    std::atomic<std::size_t> mInUse{0};
+    std::atomic<std::size_t> mHighWater{0};
+    std::atomic<std::size_t> mHugeTlbChunks{0};
+    std::atomic<std::size_t> mDirect{0};
+};
+
+#endif
@@ -6,8 +6,13 @@
 
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
+#ifndef MSG_ZEROCOPY
+#define MSG_ZEROCOPY 0x4000000
+#endif
+
 enum eSocketError
 {
     Socket_Ok = 0,
@@ -16,7 +21,17 @@ enum eSocketError
     Socket_RecvFailed,
     Socket_WouldBlock,
     Socket_ConnectFailed,  
-    Socket_ConnectInProgress
+    Socket_ConnectInProgress,
+    Socket_NoBuffers,
+    Socket_OptionFailed
+};
+
+// MSG_ZEROCOPY 완료 통지 한 건. [lo, hi] 범위의 zerocopy send 가 끝났음을 뜻한다.
+struct ZeroCopyCompletion
+{
+    std::uint32_t lo = 0;
+    std::uint32_t hi = 0;
+    bool copied = false; // 커널이 결국 복사로 처리함 (loopback 등)
 };
 
 class Socket
@@ -38,8 +53,20 @@ public:
     eSocketError Connect(const char *ip, uint16_t port, bool nonBlocking);
     eSocketError Send(const void *data, std::size_t length, std::size_t &outSent);
     eSocketError Recv(void *buffer, std::size_t maxLength, std::size_t &outReceived);
+    eSocketError Readv(const struct iovec *spans, int spanCount, std::size_t &outReceived);
+    eSocketError Writev(const struct iovec *spans, int spanCount, std::size_t &outSent);
+    eSocketError SendMsg(const struct iovec *spans, int spanCount, int flags, std::size_t &outSent);
+
+    eSocketError EnableZeroCopy();
+    // error queue 에서 zerocopy 완료 통지를 하나 꺼낸다. 비어 있으면 WouldBlock.
+    eSocketError ReadZeroCopyCompletion(ZeroCopyCompletion &out);
+    eSocketError GetPendingError(int &outError);
 
     eSocketError SetBlocking(bool blocking);
+    // 쓰기 방향만 닫는다 (FIN). fd 는 열려 있어 error queue 를 계속 읽을 수 있다.
+    eSocketError ShutdownWrite();
+    // RST 로 연결을 끊는다. 커널이 송신 큐를 버리므로 남은 zerocopy 완료 통지가 바로 온다. fd 는 유지.
+    eSocketError Abort();
 
     void Close();
 
@@ -0,0 +1,82 @@
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+class TimingWheel;
+
+// TimingWheel 에 걸리는 intrusive 노드. 소유자가 들고 있으며 소멸 시 자동으로 해제된다.
+// 링크가 주소에 묶이므로 복사/이동 불가.
+struct TimerNode{
+    TimerNode() = default;
+    ~TimerNode();
+
+    TimerNode(const TimerNode&) = delete;
+    TimerNode& operator=(const TimerNode&) = delete;
+
+    bool IsScheduled() const noexcept { return wheel != nullptr; }
+
+    std::uint64_t userData{0};
+
+private:
+    friend class TimingWheel;
+
+    TimerNode* prev{nullptr};
+    TimerNode* next{nullptr};
+    TimingWheel* wheel{nullptr};
+    std::uint64_t expireTick{0};
+    int level{0};
+    int slot{0};
+};
+
+// 64 slot x 4 level 계층형 timing wheel (tick 10ms 기준 약 46시간까지 표현, 그 이상은 최대값으로 clamp).
+// Schedule/Cancel 은 O(1), Advance 는 지나간 tick 의 slot 만 방문한다.
+// 이벤트 루프 스레드 전용이며 thread-safe 하지 않다.
+class TimingWheel{
+public:
+    using Clock          = std::chrono::steady_clock;
+    using ExpireCallback = std::function<void(TimerNode&)>;
+
+    static constexpr int kSlotBits = 6;
+    static constexpr int kSlots    = 1 << kSlotBits;
+    static constexpr int kLevels   = 4;
+
+    explicit TimingWheel(std::chrono::milliseconds tick = std::chrono::milliseconds(10), Clock::time_point start = Clock::now());
+    ~TimingWheel();
+
+    TimingWheel(const TimingWheel&) = delete;
+    TimingWheel& operator=(const TimingWheel&) = delete;
+
+    // 이미 걸려 있으면 떼어낸 뒤 다시 건다 (re-arm). 기준 시각은 마지막 Advance 시점.
+    void Schedule(TimerNode& node, std::chrono::milliseconds delay);
+    void Cancel(TimerNode& node) noexcept;
+
+    // now 까지 만료된 노드를 떼어내고 콜백 호출. 콜백 안에서 Schedule/Cancel 해도 된다. 반환값은 만료 개수.
+    std::size_t Advance(Clock::time_point now, const ExpireCallback& onExpire);
+
+    // 다음 만료(또는 상위 level cascade) 까지 남은 ms. 비어 있으면 maxMs.
+    int NextTimeoutMs(Clock::time_point now, int maxMs) const;
+
+    std::size_t Size() const noexcept;
+    bool IsEmpty() const noexcept;
+    std::chrono::milliseconds Tick() const noexcept;
+
+private:
+    void Link(TimerNode& node);
+    void Unlink(TimerNode& node) noexcept;
+    void Cascade(int level, int slot);
+    std::uint64_t ToTick(Clock::time_point t) const noexcept;
+
+private:
+    TimerNode mSlots[kLevels][kSlots];      // 각 slot 의 원형 리스트 sentinel
+    std::uint64_t mOccupied[kLevels]{};     // 비어있지 않은 slot bitmap
+    std::chrono::milliseconds mTick;
+    Clock::time_point mStart;
+    std::uint64_t mCurrentTick{0};          // 다음에 처리할 tick
+    std::size_t mSize{0};
+};
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef ZERO_COPY_LINGER_H
+#define ZERO_COPY_LINGER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "SharedBuffer.h"
+#include "Socket.h"
+
+// MSG_ZEROCOPY 로 보낸 buffer 하나. 완료 통지가 seq 를 덮을 때까지 참조를 쥔다.
+struct ZeroCopyPin
+{
+    std::uint32_t seq;
+    SharedBuffer buffer;
+    bool done;
+};
+
+// completion 범위 [lo, hi] 에 든 pin 을 놓고, 앞에서부터 끝난 것을 뺀다.
+void CompleteZeroCopyPins(std::deque<ZeroCopyPin> &pins, const ZeroCopyCompletion &completion);
+
+// 완료 통지 전에 닫힌 세션의 zerocopy buffer 를 맡아 두는 곳.
+// close 뒤에도 커널은 그 page 로 전송/재전송하므로 buffer 를 먼저 놓으면 재사용된 메모리가 나간다.
+// 그래서 socket 은 쓰기만 닫고(FIN) 열어 둔 채로 완료 통지를 받고, 다 받으면 닫는다.
+// kAbortAfter 안에 끝나지 않으면 (상대가 읽지 않는 등) RST 로 끊어 남은 통지를 받아 낸다.
+// event loop 스레드마다 하나씩 쓰며 thread-safe 하지 않다.
+class ZeroCopyLinger
+{
+public:
+    static constexpr std::chrono::seconds kAbortAfter{30};
+
+    ZeroCopyLinger() = default;
+    ~ZeroCopyLinger();
+
+    ZeroCopyLinger(const ZeroCopyLinger &) = delete;
+    ZeroCopyLinger &operator=(const ZeroCopyLinger &) = delete;
+
+    void Adopt(Socket &&socket, std::deque<ZeroCopyPin> &&pins);
+    // loop 마다 호출. 완료 통지를 회수하고 끝난 socket 을 닫는다.
+    void Poll(std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+    std::size_t Count() const noexcept;
+
+    static ZeroCopyLinger &Local();
+
+private:
+    struct Entry
+    {
+        Socket socket;
+        std::deque<ZeroCopyPin> pins;
+        std::chrono::steady_clock::time_point deadline;
+        bool aborted;
+    };
+
+    static void Drain(Entry &entry);
+
+    std::vector<Entry> mEntries;
+};
+
+#endif
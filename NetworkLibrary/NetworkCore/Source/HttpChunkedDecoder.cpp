@@ -0,0 +1,156 @@
+#include "HttpChunkedDecoder.h"
+
+namespace
+{
+    int HexValue(char c)
+    {
+        if (c >= '0' && c <= '9')
+            return c - '0';
+        if (c >= 'a' && c <= 'f')
+            return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F')
+            return c - 'A' + 10;
+        return -1;
+    }
+
+    // 16 자리면 uint64 를 넘을 수 있으므로 15 자리(2^60)까지만
+    constexpr std::size_t kMaxSizeDigits = 15;
+}
+
+void HttpChunkedDecoder::Reset()
+{
+    mState = State::Size;
+    mChunkLeft = 0;
+    mDecoded = 0;
+    mSizeDigits = 0;
+    mLineBytes = 0;
+    mTrailerBytes = 0;
+    mError = nullptr;
+}
+
+HttpChunkedDecoder::Result HttpChunkedDecoder::Fail(const char *why)
+{
+    mState = State::Failed;
+    mError = why;
+    return Result::Chunk_Error;
+}
+
+HttpChunkedDecoder::Result HttpChunkedDecoder::Next(const char *p, std::size_t len, std::size_t &consumed,
+                                                    std::string_view &outData)
+{
+    consumed = 0;
+    if (mState == State::Failed)
+        return Result::Chunk_Error;
+
+    std::size_t i = 0;
+    while (i < len)
+    {
+        const char c = p[i];
+        switch (mState)
+        {
+        case State::Size:
+        {
+            const int v = HexValue(c);
+            if (v >= 0)
+            {
+                if (++mSizeDigits > kMaxSizeDigits)
+                    return Fail("Chunk Size Too Large");
+                mChunkLeft = (mChunkLeft << 4) | static_cast<std::uint64_t>(v);
+                ++i;
+                break;
+            }
+            if (mSizeDigits == 0)
+                return Fail("Bad Chunk Size");
+            if (c == '\r')
+                mState = State::SizeLf;
+            else if (c == ';' || c == ' ' || c == '\t')
+                mState = State::Extension; // BWS ";" ext
+            else
+                return Fail("Bad Chunk Size");
+            ++mLineBytes;
+            ++i;
+            break;
+        }
+        case State::Extension:
+            if (++mLineBytes > kMaxLineBytes)
+                return Fail("Chunk Line Too Long");
+            if (c == '\r')
+                mState = State::SizeLf;
+            else if (c == '\n')
+                return Fail("Bad Chunk Line");
+            ++i;
+            break;
+        case State::SizeLf:
+            if (c != '\n')
+                return Fail("Bad Chunk Line");
+            ++i;
+            mSizeDigits = 0;
+            mLineBytes = 0;
+            mState = mChunkLeft == 0 ? State::TrailerStart : State::Data;
+            break;
+        case State::Data:
+        {
+            const std::size_t avail = len - i;
+            const std::size_t take = mChunkLeft < avail ? static_cast<std::size_t>(mChunkLeft) : avail;
+            outData = std::string_view(p + i, take);
+            mChunkLeft -= take;
+            mDecoded += take;
+            if (mChunkLeft == 0)
+                mState = State::DataCr;
+            consumed = i + take;
+            return Result::Chunk_Data;
+        }
+        case State::DataCr:
+            if (c != '\r')
+                return Fail("Bad Chunk Data");
+            mState = State::DataLf;
+            ++i;
+            break;
+        case State::DataLf:
+            if (c != '\n')
+                return Fail("Bad Chunk Data");
+            mState = State::Size;
+            ++i;
+            break;
+        case State::TrailerStart:
+            if (c == '\r')
+            {
+                mState = State::EndLf;
+                ++i;
+                break;
+            }
+            mState = State::Trailer;
+            break;
+        case State::Trailer:
+            if (++mLineBytes > kMaxLineBytes || ++mTrailerBytes > kMaxTrailerBytes)
+                return Fail("Trailer Too Large");
+            if (c == '\r')
+                mState = State::TrailerLf;
+            else if (c == '\n')
+                return Fail("Bad Trailer Line");
+            ++i;
+            break;
+        case State::TrailerLf:
+            if (c != '\n')
+                return Fail("Bad Trailer Line");
+            mLineBytes = 0;
+            mState = State::TrailerStart;
+            ++i;
+            break;
+        case State::EndLf:
+            if (c != '\n')
+                return Fail("Bad Chunked Body End");
+            mState = State::Done;
+            consumed = i + 1;
+            return Result::Chunk_Done;
+        case State::Done:
+            consumed = i;
+            return Result::Chunk_Done;
+        case State::Failed:
+            return Result::Chunk_Error;
+        }
+    }
+
+    consumed = i;
+    return mState == State::Done ? Result::Chunk_Done : Result::Chunk_NeedMore;
+}
@@ -1,69 +1,223 @@
 #include "HttpParser.h"
+#include "HttpScan.h"
 #include "RecvBuffer.h"
-#include <cctype>
+#include <charconv>
 #include <cstddef>
 #include <cstring>
-#include <cstdlib>
+#include <sys/uio.h>
 
-HttpParser::HttpParser() = default;
+namespace {
+    std::string_view TrimView(std::string_view s){
+        std::size_t b = 0;
+        std::size_t e = s.size();
 
-void HttpParser::Reset(){
-    mBuf.clear();
-    mState = State::Http_RequestLine;
-    mCur.Clear();
-    mContentLength = 0;
+        while (b < e && (s[b] == ' ' || s[b] == '\t')) b++;
+        while (e > b && (s[e-1] == ' ' || s[e-1] == '\t')) e--;
+
+        return s.substr(b, e-b);
+    }
+
+    // Transfer-Encoding 목록 하나. 지원하는 coding 은 chunked 뿐이고 한 번, 마지막에만 올 수 있다
+    bool CheckTransferCoding(std::string_view list, bool& chunked){
+        while(!list.empty()){
+            const std::size_t comma = list.find(',');
+            const std::string_view coding = TrimView(list.substr(0, comma));
+            list = comma == std::string_view::npos ? std::string_view() : list.substr(comma + 1);
+            if(coding.empty()) continue;
+            if(chunked || !EqualsIgnoreCase(coding, "chunked")) return false;
+            chunked = true;
+        }
+        return true;
+    }
+
+    // 본문 길이를 정하는 header (Content-Length / Transfer-Encoding) 를 모은 결과
+    struct BodyFraming{
+        bool chunked = false;
+        bool hasLength = false;
+        std::size_t contentLength = 0;
+    };
+
+    bool AddFraming(const HttpHeaderView& h, BodyFraming& f, std::string* err){
+        if(h.id == HttpHeader::TransferEncoding){
+            if(!CheckTransferCoding(h.value, f.chunked)){
+                if(err) *err = "Unsupported Transfer-Encoding";
+                return false;
+            }
+            return true;
+        }
+        if(h.id != HttpHeader::ContentLength) return true;
+
+        std::size_t v = 0;
+        const char* first = h.value.data();
+        const char* last = first + h.value.size();
+        auto [ptr, ec] = std::from_chars(first, last, v);
+        // 같은 값이 여러 번 오는 것만 허용
+        if(ec != std::errc() || ptr != last || first == last || (f.hasLength && v != f.contentLength)){
+            if(err) *err = "Invalid Content-Length";
+            return false;
+        }
+        f.hasLength = true;
+        f.contentLength = v;
+        return true;
+    }
+
+    bool CheckFraming(const BodyFraming& f, std::string* err){
+        // 둘 다 있으면 길이를 다르게 해석하는 중간 서버와 어긋날 수 있으므로 거절 (RFC 9112 6.3)
+        if(f.chunked && f.hasLength){
+            if(err) *err = "Content-Length With Transfer-Encoding";
+            return false;
+        }
+        return true;
+    }
+
+    char LowerAscii(char c){
+        return (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c;
+    }
 }
 
-std::string HttpParser::ToLower(std::string_view s){
-    std::string out;
-    out.reserve(s.size());
+bool EqualsIgnoreCase(std::string_view a, std::string_view b){
+    if(a.size() != b.size()) return false;
+    for(std::size_t i = 0; i < a.size(); ++i){
+        if(LowerAscii(a[i]) != LowerAscii(b[i])) return false;
+    }
+    return true;
+}
 
-    for(char c : s) out.push_back((char)std::tolower((unsigned char)c));
+void HttpRequest::Clear(){
+    method.clear();
+    target.clear();
+    version.clear();
+    body.clear();
+    mFieldBytes.clear();
+    mFieldCount = 0;
+    std::memset(mKnown, 0, sizeof(mKnown));
+}
 
-    return out;
+bool HttpRequest::AddHeader(std::string_view name, std::string_view value){
+    if(mFieldCount == kMaxHeaders) return false;
+
+    const HttpHeader id = LookupHttpHeader(name);
+    Field& f = mFields[mFieldCount];
+    f.id = id;
+    f.name = static_cast<std::uint32_t>(mFieldBytes.size());
+    f.nameLen = static_cast<std::uint32_t>(name.size());
+    mFieldBytes.append(name);
+    f.value = static_cast<std::uint32_t>(mFieldBytes.size());
+    f.valueLen = static_cast<std::uint32_t>(value.size());
+    mFieldBytes.append(value);
+
+    ++mFieldCount;
+    std::uint8_t& known = mKnown[static_cast<std::size_t>(id)];
+    if(id != HttpHeader::Other && known == 0) known = static_cast<std::uint8_t>(mFieldCount);
+    return true;
+}
+
+HttpHeaderView HttpRequest::HeaderAt(std::size_t i) const noexcept{
+    const Field& f = mFields[i];
+    const std::string_view bytes(mFieldBytes);
+    return HttpHeaderView{f.id, bytes.substr(f.name, f.nameLen), bytes.substr(f.value, f.valueLen)};
 }
 
-std::string HttpParser::Trim(std::string_view s){
-    std::size_t b = 0;
-    std::size_t e = s.size();
+std::optional<std::string_view> HttpRequest::Header(HttpHeader id) const noexcept{
+    const std::uint8_t at = mKnown[static_cast<std::size_t>(id)];
+    if(id == HttpHeader::Other || at == 0) return std::nullopt;
+    return HeaderAt(at - 1).value;
+}
 
-    while (b < e && std::isspace((unsigned char)s[b])) b++;
-    while (e > b && std::isspace((unsigned char)s[e-1])) e--;
+std::optional<std::string_view> HttpRequest::Header(std::string_view name) const noexcept{
+    const HttpHeader id = LookupHttpHeader(name);
+    if(id != HttpHeader::Other) return Header(id);
 
-    return std::string(s.substr(b, e-b));
+    for(std::size_t i = 0; i < mFieldCount; ++i){
+        if(mFields[i].id != HttpHeader::Other) continue;
+        const HttpHeaderView h = HeaderAt(i);
+        if(EqualsIgnoreCase(h.name, name)) return h.value;
+    }
+    return std::nullopt;
 }
 
-bool HttpParser::SplitOnce(std::string_view s, char delim, std::string_view& left, std::string_view& right){
-    auto pos = s.find(delim);
-    if(pos == std::string_view::npos) return false;
+void HttpRequestView::ClearHeaders() noexcept{
+    headerCount = 0;
+    std::memset(known, 0, sizeof(known));
+}
 
-    left = s.substr(0, pos);
-    right = s.substr(pos+1);
+bool HttpRequestView::AddHeader(HttpHeader id, std::string_view name, std::string_view value) noexcept{
+    if(headerCount == kMaxHeaders) return false;
 
+    headers[headerCount++] = HttpHeaderView{id, name, value};
+    std::uint8_t& at = known[static_cast<std::size_t>(id)];
+    if(id != HttpHeader::Other && at == 0) at = static_cast<std::uint8_t>(headerCount);
     return true;
 }
 
-bool HttpParser::PullFromRecvBuffer(RecvBuffer& rb, std::size_t maxPull){
-    std::size_t  available = rb.WriteSpace();
-    if(available == 0) return false;
+std::optional<std::string_view> HttpRequestView::Header(std::string_view name) const noexcept{
+    const HttpHeader id = LookupHttpHeader(name);
+    if(id != HttpHeader::Other) return Header(id);
 
-    if(available > maxPull) available = maxPull;
+    for(std::size_t i = 0; i < headerCount; ++i){
+        if(headers[i].id == HttpHeader::Other && EqualsIgnoreCase(headers[i].name, name)) return headers[i].value;
+    }
+    return std::nullopt;
+}
 
-    std::string tmp;
-    tmp.resize(available);
+HttpRequestView MakeRequestView(const HttpRequest& rq){
+    HttpRequestView v;
+    v.method = rq.method;
+    v.target = rq.target;
+    v.version = rq.version;
+    for(std::size_t i = 0; i < rq.HeaderCount(); ++i){
+        const HttpHeaderView h = rq.HeaderAt(i);
+        (void)v.AddHeader(h.id, h.name, h.value);
+    }
+    v.body = std::string_view(reinterpret_cast<const char*>(rq.body.data()), rq.body.size());
+    return v;
+}
 
-    std::size_t peeked = 0;
-    if(rb.Peek(tmp.data(), available, peeked)!= RecvBuf_Ok || peeked == 0) return false;
+HttpParser::HttpParser() = default;
 
-    mBuf.append(tmp.data(), peeked);
-    if(rb.Consume(peeked) != RecvBuf_Ok) return false;
+void HttpParser::SetBodyCallback(BodyCallback cb){
+    mOnBody = std::move(cb);
+}
 
-    return true;
+void HttpParser::SetLimits(std::size_t maxHeaderBytes, std::size_t maxBufferedBody){
+    mMaxHeaderBytes = maxHeaderBytes;
+    mMaxBufferedBody = maxBufferedBody;
+}
+
+void HttpParser::Reset(){
+    mBuf.clear();
+    mLinear.clear();
+    mScanned = 0;
+    mViewBytes = 0;
+    mState = State::Http_RequestLine;
+    mCur.Clear();
+    mContentLength = 0;
+    mHeaderBytes = 0;
+    mChunked.Reset();
+}
+
+bool HttpParser::PullFromRecvBuffer(RecvBuffer& rb, std::size_t maxPull){
+    std::size_t pulled = 0;
+
+    // ring 메모리에서 직접 append (heap 모드에서 wrap 되어 있으면 두 구간)
+    while(pulled < maxPull){
+        const std::uint8_t* data = nullptr;
+        std::size_t len = 0;
+        if(rb.PeekContiguous(data, len) != RecvBuf_Ok || len == 0) break;
+
+        if(len > maxPull - pulled) len = maxPull - pulled;
+
+        mBuf.append(reinterpret_cast<const char*>(data), len);
+        if(rb.Consume(len) != RecvBuf_Ok) return false;
+        pulled += len;
+    }
+
+    return pulled > 0;
 }
 
 bool HttpParser::PopLine(std::string& outLine){
-    auto pos = mBuf.find("\r\n");
-    if(pos == std::string::npos) return false;
+    const std::size_t pos = HttpScan::FindCrlf(mBuf.data(), mBuf.size());
+    if(pos == HttpScan::npos) return false;
 
     outLine = mBuf.substr(0, pos);
     mBuf.erase(0, pos+2);
@@ -83,30 +237,34 @@ bool HttpParser::ParseRequestLine(const std::string& line, std::string* err){
     mCur.version = line.substr(p2+1);
 
     if(mCur.method.empty() || mCur.target.empty() || mCur.version.empty()){
-        if(err) *err = "Bad Request Line"; return false;
+        if(err) *err = "Bad Request Line";
+        return false;
     }
 
     if(mCur.version != "HTTP/1.1" && mCur.version != "HTTP/1.0"){
-        if(err) *err = "Unsupported HTTP version"; return false;
+        if(err) *err = "Unsupported HTTP version";
+        return false;
     }
 
     return true;
 }
 
 bool HttpParser::ParseHeaderLine(const std::string& line, std::string* err){
-    std::string_view left, right;
-    if(!SplitOnce(line, ':', left, right)){
-        if(err) *err = "Bad Header Line"; return false;
+    // 이름은 token 문자만 허용하고 바로 뒤가 ':' 이어야 함 (검증과 ':' 찾기를 한 번에)
+    const std::size_t nameLen = HttpScan::TokenLength(line.data(), line.size());
+    if(nameLen == line.size() || line[nameLen] != ':'){
+        if(err) *err = (line.find(':') == std::string::npos) ? "Bad Header Line" : "Bad Header Key";
+        return false;
     }
-
-    auto k = ToLower(Trim(left));
-    auto v = Trim(right);
-    
-    if(k.empty()){
-        if(err) *err = "Bad Header Key"; return false;
+    if(nameLen == 0){
+        if(err) *err = "Bad Header Key";
+        return false;
     }
 
-    mCur.headers[k] = v;
+    if(!mCur.AddHeader(std::string_view(line).substr(0, nameLen), TrimView(std::string_view(line).substr(nameLen + 1)))){
+        if(err) *err = "Too Many Headers";
+        return false;
+    }
     return true;
 }
 
@@ -115,10 +273,19 @@ HttpParser::Result HttpParser::TryParse(RecvBuffer& rb, HttpRequest& rq, std::st
     if(rb.WriteSpace() > 0) (void)PullFromRecvBuffer(rb);
 
     while(true){
+        if(mState == State::Http_RequestLine || mState == State::Http_Headers){
+            // 줄이 끝나지 않은 채로 쌓이는 것도 header 크기로 센다
+            if(mHeaderBytes + mBuf.size() > mMaxHeaderBytes && HttpScan::FindCrlf(mBuf.data(), mBuf.size()) == HttpScan::npos){
+                if(outErr) *outErr = "Header Too Large";
+                return Result::Http_Error;
+            }
+        }
+
         if(mState == State::Http_RequestLine){
             std::string line;
             if(!PopLine(line)) return Result::Http_NeedMore;
             if(line.empty()) return Result::Http_NeedMore;
+            mHeaderBytes = line.size() + 2;
             if(!ParseRequestLine(line, outErr)) return Result::Http_Error;
 
             mState = State::Http_Headers;
@@ -128,29 +295,38 @@ HttpParser::Result HttpParser::TryParse(RecvBuffer& rb, HttpRequest& rq, std::st
         if(mState == State::Http_Headers){
             std::string line;
             if(!PopLine(line)) return Result::Http_NeedMore;
+            mHeaderBytes += line.size() + 2;
+            if(mHeaderBytes > mMaxHeaderBytes){
+                if(outErr) *outErr = "Header Too Large";
+                return Result::Http_Error;
+            }
             if(line.empty()){
-                mContentLength = 0;
-                auto it = mCur.headers.find("content-length");
-                if(it != mCur.headers.end()){
-                    char* end = nullptr;
-                    long v = std::strtol(it->second.c_str(), &end, 10);
-                    if(end == it->second.c_str() || v < 0){
-                        if(outErr) *outErr = "Invalid Content-Length";
-                        return Result::Http_Error;
-                    }
-                    mContentLength = (std::size_t)v;
+                BodyFraming framing;
+                for(std::size_t i = 0; i < mCur.HeaderCount(); ++i){
+                    if(!AddFraming(mCur.HeaderAt(i), framing, outErr)) return Result::Http_Error;
+                }
+                if(!CheckFraming(framing, outErr)) return Result::Http_Error;
+
+                if(framing.chunked){
+                    mChunked.Reset();
+                    mState = State::Http_ChunkedBody;
+                    continue;
                 }
 
-                if(mContentLength == 0){
-                    rq = std::move(mCur);
-                    mCur.Clear();
-                    mState = State::Http_RequestLine;
-                    return Result::Http_Ok;
+                // 이 경로는 body 를 통째로 메모리에 모으므로 상한이 필요 (큰 body 는 TryParseStream)
+                if(framing.contentLength > mMaxBufferedBody){
+                    if(outErr) *outErr = "Body Too Large";
+                    return Result::Http_Error;
                 }
+                mContentLength = framing.contentLength;
+                if(mContentLength == 0) return FinishRequest(rq);
 
                 mState = State::Http_Body;
                 continue;
             }
+
+            if(!ParseHeaderLine(line, outErr)) return Result::Http_Error;
+            continue;
         }
 
         if(mState == State::Http_Body){
@@ -163,17 +339,279 @@ HttpParser::Result HttpParser::TryParse(RecvBuffer& rb, HttpRequest& rq, std::st
 
             mCur.body.assign(mBuf.begin(), mBuf.begin()+ (std::ptrdiff_t)mContentLength);
             mBuf.erase(0, mContentLength);
+            return FinishRequest(rq);
+        }
+
+        if(mState == State::Http_ChunkedBody) return ParseChunkedBody(rb, rq, outErr);
+    }
+}
+
+HttpParser::Result HttpParser::FinishRequest(HttpRequest& rq){
+    rq = std::move(mCur);
+    mCur.Clear();
+    mContentLength = 0;
+    mHeaderBytes = 0;
+    mState = State::Http_RequestLine;
+    return Result::Http_Ok;
+}
+
+HttpParser::Result HttpParser::ParseChunkedBody(RecvBuffer& rb, HttpRequest& rq, std::string* err){
+    while(true){
+        // mBuf 에 있는 만큼 풀고, 소비한 앞부분은 마지막에 한 번만 지움
+        std::size_t pos = 0;
+        HttpChunkedDecoder::Result r = HttpChunkedDecoder::Result::Chunk_NeedMore;
+        while(true){
+            std::size_t used = 0;
+            std::string_view data;
+            r = mChunked.Next(mBuf.data() + pos, mBuf.size() - pos, used, data);
+            pos += used;
+            if(r != HttpChunkedDecoder::Result::Chunk_Data) break;
+
+            if(mOnBody){
+                mOnBody(mCur, data);
+                continue;
+            }
+            if(mCur.body.size() + data.size() > mMaxBufferedBody){
+                if(err) *err = "Body Too Large";
+                return Result::Http_Error;
+            }
+            mCur.body.insert(mCur.body.end(), data.begin(), data.end());
+        }
+        mBuf.erase(0, pos);
+
+        if(r == HttpChunkedDecoder::Result::Chunk_Done) return FinishRequest(rq);
+        if(r == HttpChunkedDecoder::Result::Chunk_Error){
+            if(err) *err = mChunked.Error();
+            return Result::Http_Error;
+        }
+        if(rb.WriteSpace() == 0 || !PullFromRecvBuffer(rb)) return Result::Http_NeedMore;
+    }
+}
+
+bool HttpParser::IsIdle() const noexcept{
+    return mState == State::Http_RequestLine && mBuf.empty();
+}
+
+bool HttpParser::ParseRequestLineView(std::string_view line, HttpRequestView& out, std::string* err){
+    // method 는 token 이고 바로 뒤가 ' '
+    const std::size_t p1 = HttpScan::TokenLength(line.data(), line.size());
+    if(p1 == line.size() || line[p1] != ' ') {if(err) *err = "Bad Request Line"; return false;}
+
+    const std::size_t rest = HttpScan::FindByte(line.data() + p1 + 1, line.size() - p1 - 1, ' ');
+    if(rest == HttpScan::npos) {if(err) *err = "Bad Request Line"; return false;}
+    const std::size_t p2 = p1 + 1 + rest;
+
+    out.method = line.substr(0, p1);
+    out.target = line.substr(p1+1, p2-(p1+1));
+    out.version = line.substr(p2+1);
+
+    if(out.method.empty() || out.target.empty() || out.version.empty()){
+        if(err) *err = "Bad Request Line";
+        return false;
+    }
+
+    if(out.version != "HTTP/1.1" && out.version != "HTTP/1.0"){
+        if(err) *err = "Unsupported HTTP version";
+        return false;
+    }
+
+    return true;
+}
+
+bool HttpParser::ParseHeaderLineView(std::string_view line, HttpRequestView& out, std::string* err){
+    const std::size_t colon = HttpScan::TokenLength(line.data(), line.size());
+    if(colon == line.size() || line[colon] != ':'){
+        if(err) *err = (line.find(':') == std::string_view::npos) ? "Bad Header Line" : "Bad Header Key";
+        return false;
+    }
+
+    const std::string_view name = line.substr(0, colon);
+    if(name.empty()){
+        if(err) *err = "Bad Header Key";
+        return false;
+    }
+    if(!out.AddHeader(LookupHttpHeader(name), name, TrimView(line.substr(colon+1)))){
+        if(err) *err = "Too Many Headers";
+        return false;
+    }
+    return true;
+}
+
+HttpParser::Result HttpParser::ParseHeadView(RecvBuffer& rb, HttpRequestView& out, std::string_view& buf, HeadInfo& head, std::string* err){
+    const std::size_t available = rb.WriteSpace();
+    if(available == 0) return Result::Http_NeedMore;
+
+    const std::uint8_t* data = nullptr;
+    std::size_t len = 0;
+    if(rb.PeekContiguous(data, len) != RecvBuf_Ok) return Result::Http_NeedMore;
+
+    buf = std::string_view(reinterpret_cast<const char*>(data), len);
+    if(len < available){
+        // heap ring 이 wrap 됨: 두 구간을 재사용 buffer 하나로 (capacity 는 유지되므로 보통 할당 없음)
+        struct iovec spans[2];
+        int count = 0;
+        if(rb.GetReadableSpans(spans, 2, count) != RecvBuf_Ok) return Result::Http_NeedMore;
+        mLinear.clear();
+        for(int i = 0; i < count; ++i) mLinear.append(static_cast<const char*>(spans[i].iov_base), spans[i].iov_len);
+        buf = mLinear;
+    }
+
+    // header 끝 검색은 지난번에 본 곳 바로 앞부터
+    const std::size_t from = mScanned > 3 ? mScanned - 3 : 0;
+    std::size_t headerEnd = HttpScan::FindHeaderEnd(buf.data() + from, buf.size() - from);
+    if(headerEnd != HttpScan::npos) headerEnd += from;
+    if(headerEnd == HttpScan::npos){
+        if(buf.size() >= rb.BufSize() || buf.size() >= mMaxHeaderBytes){
+            mScanned = 0;
+            return Result::Http_TooLarge;
+        }
+        mScanned = buf.size();
+        return Result::Http_NeedMore;
+    }
+    if(headerEnd + 4 > mMaxHeaderBytes){
+        mScanned = 0;
+        return Result::Http_TooLarge;
+    }
+
+    out.ClearHeaders();
+    out.body = {};
 
-            rq = std::move(mCur);
-            mCur.Clear();
-            mContentLength = 0;
-            mState = State::Http_RequestLine;
+    std::string_view lines = buf.substr(0, headerEnd + 2); // 각 줄이 "\r\n" 으로 끝나게
+    std::size_t eol = HttpScan::FindCrlf(lines.data(), lines.size());
+    if(!ParseRequestLineView(lines.substr(0, eol), out, err)) return Result::Http_Error;
+    lines.remove_prefix(eol + 2);
+
+    BodyFraming framing;
+    while(!lines.empty()){
+        eol = HttpScan::FindCrlf(lines.data(), lines.size());
+        if(!ParseHeaderLineView(lines.substr(0, eol), out, err)) return Result::Http_Error;
+        lines.remove_prefix(eol + 2);
+        if(!AddFraming(out.headers[out.headerCount - 1], framing, err)) return Result::Http_Error;
+    }
+    if(!CheckFraming(framing, err)) return Result::Http_Error;
+
+    head.bytes = headerEnd + 4;
+    head.contentLength = framing.contentLength;
+    head.chunked = framing.chunked;
+    return Result::Http_Ok;
+}
+
+HttpParser::Result HttpParser::TryParseView(RecvBuffer& rb, HttpRequestView& out, std::string* outErr){
+    // 이전 view 를 FinishView 하지 않고 다시 부르면 같은 요청을 다시 본다
+    mViewBytes = 0;
+
+    std::string_view buf;
+    HeadInfo head;
+    const Result r = ParseHeadView(rb, out, buf, head, outErr);
+    if(r != Result::Http_Ok) return r;
+
+    // chunked body 는 풀어야 하므로 in-place 로 볼 수 없음. 아무것도 소비하지 않고 TryParse 로 넘김
+    const std::size_t total = head.bytes + head.contentLength;
+    if(head.chunked || total > rb.BufSize()){
+        mScanned = 0;
+        return Result::Http_TooLarge;
+    }
+    if(buf.size() < total){
+        // body 대기. header 끝은 찾았으므로 다음에도 그 자리에서 바로 찾음
+        mScanned = head.bytes - 1;
+        return Result::Http_NeedMore;
+    }
+
+    out.body = buf.substr(head.bytes, head.contentLength);
+    mViewBytes = total;
+    mScanned = 0;
+    return Result::Http_Ok;
+}
+
+HttpParser::Result HttpParser::TryParseStream(RecvBuffer& rb, HttpStreamHandler& handler, std::string* outErr){
+    if(mState == State::Http_RequestLine){
+        HttpRequestView req;
+        std::string_view buf;
+        HeadInfo head;
+        const Result r = ParseHeadView(rb, req, buf, head, outErr);
+        if(r == Result::Http_TooLarge){
+            if(outErr) *outErr = "Header Too Large";
+            return Result::Http_Error;
+        }
+        if(r != Result::Http_Ok) return r;
+
+        mScanned = 0;
+        handler.OnHeaders(req);
+        // view 가 가리키던 header 는 OnHeaders 가 끝난 뒤에 소비
+        (void)rb.Consume(head.bytes);
+
+        if(head.chunked){
+            mChunked.Reset();
+            mState = State::Http_ChunkedBody;
+        }
+        else if(head.contentLength > 0){
+            mContentLength = head.contentLength;
+            mState = State::Http_Body;
+        }
+        else{
+            handler.OnBodyEnd();
             return Result::Http_Ok;
         }
     }
+
+    // body 는 ring 에서 바로 넘기고 넘긴 만큼 소비 (따로 모으지 않음)
+    while(true){
+        const std::uint8_t* data = nullptr;
+        std::size_t len = 0;
+        if(rb.PeekContiguous(data, len) != RecvBuf_Ok || len == 0) return Result::Http_NeedMore;
+        const char* p = reinterpret_cast<const char*>(data);
+
+        bool more = true;
+        if(mState == State::Http_Body){
+            const std::size_t n = len < mContentLength ? len : mContentLength;
+            more = handler.OnBodyChunk(std::string_view(p, n));
+            (void)rb.Consume(n);
+            mContentLength -= n;
+            if(mContentLength == 0){
+                mState = State::Http_RequestLine;
+                handler.OnBodyEnd();
+                return Result::Http_Ok;
+            }
+        }
+        else{
+            std::size_t used = 0;
+            std::string_view piece;
+            const HttpChunkedDecoder::Result r = mChunked.Next(p, len, used, piece);
+            if(r == HttpChunkedDecoder::Result::Chunk_Data) more = handler.OnBodyChunk(piece);
+            (void)rb.Consume(used);
+
+            if(r == HttpChunkedDecoder::Result::Chunk_Done){
+                mState = State::Http_RequestLine;
+                handler.OnBodyEnd();
+                return Result::Http_Ok;
+            }
+            if(r == HttpChunkedDecoder::Result::Chunk_Error){
+                if(outErr) *outErr = mChunked.Error();
+                return Result::Http_Error;
+            }
+        }
+        // handler 가 멈춰 달라고 하면 남은 body 는 recv buffer 에 둔 채 다음 호출에서 이어 감
+        if(!more) return Result::Http_NeedMore;
+    }
+}
+
+void HttpParser::FinishView(RecvBuffer& rb){
+    if(mViewBytes == 0) return;
+    (void)rb.Consume(mViewBytes);
+    mViewBytes = 0;
 }
 
 std::vector<std::uint8_t> BuildHttpResponseBytes(const HttpResponse &resp, bool keepAlive){
+    std::vector<std::uint8_t> out = BuildHttpResponseHead(resp, keepAlive);
+    out.insert(out.end(), resp.body.begin(), resp.body.end());
+    return out;
+}
+
+std::vector<std::uint8_t> BuildHttpResponseHead(const HttpResponse &resp, bool keepAlive){
+    return BuildHttpStreamHead(resp, keepAlive, resp.body.size());
+}
+
+std::vector<std::uint8_t> BuildHttpStreamHead(const HttpResponse &resp, bool keepAlive, std::optional<std::size_t> contentLength){
     std::string header;
     header.reserve(256);
 
@@ -183,8 +621,8 @@ std::vector<std::uint8_t> BuildHttpResponseBytes(const HttpResponse &resp, bool
     header += resp.reason;
     header += "\r\n";
 
-    std::size_t contentLen = resp.body.size();
-    header += "Content-Length: " + std::to_string(contentLen) + "\r\n";
+    if(contentLength) header += "Content-Length: " + std::to_string(*contentLength) + "\r\n";
+    else header += "Transfer-Encoding: chunked\r\n";
 
     header += std::string("Connection: ") + (keepAlive ? "keep-alive" : "close") + "\r\n";
 
@@ -197,9 +635,7 @@ std::vector<std::uint8_t> BuildHttpResponseBytes(const HttpResponse &resp, bool
 
     header += "\r\n";
 
-    std::vector<std::uint8_t> out;
-    out.reserve(header.size() + resp.body.size());
-    out.insert(out.end(), header.begin(), header.end());
-    out.insert(out.end(), resp.body.begin(), resp.body.end());
+    // contentLength 만큼 미리 잡지 않음 (stream 응답은 수백 MB 일 수 있음). body 를 붙이는 쪽이 늘린다
+    std::vector<std::uint8_t> out(header.begin(), header.end());
     return out;
 }
\ No newline at end of file
@@ -0,0 +1,344 @@
+#include "HttpScan.h"
+
+#include <array>
+#include <atomic>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HTTP_SCAN_X86 1
+#endif
+
+namespace
+{
+    // RFC 9110 tchar: "!#$%&'*+-.^_`|~" / DIGIT / ALPHA
+    constexpr bool IsTchar(unsigned c)
+    {
+        if ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'))
+            return true;
+        constexpr const char kSymbols[] = "!#$%&'*+-.^_`|~";
+        for (size_t i = 0; i + 1 < sizeof(kSymbols); ++i)
+        {
+            if (static_cast<unsigned char>(kSymbols[i]) == c)
+                return true;
+        }
+        return false;
+    }
+
+    constexpr std::array<bool, 256> MakeTcharTable()
+    {
+        std::array<bool, 256> t{};
+        for (unsigned c = 0; c < 256; ++c)
+            t[c] = IsTchar(c);
+        return t;
+    }
+
+    constexpr std::array<bool, 256> kTchar = MakeTcharTable();
+
+    // SIMD 분류용 nibble 표: byte b 가 tchar 이면 (kLoBits[b & 15] & kHiBits[b >> 4]) != 0.
+    // 상위 nibble 0~7 마다 bit 하나, 8~15 (non-ASCII) 는 0 이라 항상 거짓.
+    constexpr std::array<std::uint8_t, 16> MakeLoBits()
+    {
+        std::array<std::uint8_t, 16> t{};
+        for (unsigned hi = 0; hi < 8; ++hi)
+        {
+            for (unsigned lo = 0; lo < 16; ++lo)
+            {
+                if (IsTchar((hi << 4) | lo))
+                    t[lo] = static_cast<std::uint8_t>(t[lo] | (1u << hi));
+            }
+        }
+        return t;
+    }
+
+    constexpr std::array<std::uint8_t, 16> MakeHiBits()
+    {
+        std::array<std::uint8_t, 16> t{};
+        for (unsigned hi = 0; hi < 8; ++hi)
+            t[hi] = static_cast<std::uint8_t>(1u << hi);
+        return t;
+    }
+
+    constexpr std::array<std::uint8_t, 16> kLoBits = MakeLoBits();
+    constexpr std::array<std::uint8_t, 16> kHiBits = MakeHiBits();
+
+    // ---------------- scalar ----------------
+
+    size_t ScalarFindByte(const char *p, size_t len, char c) noexcept
+    {
+        const void *hit = std::memchr(p, c, len);
+        return hit ? static_cast<size_t>(static_cast<const char *>(hit) - p) : HttpScan::npos;
+    }
+
+    size_t ScalarFindCrlf(const char *p, size_t len) noexcept
+    {
+        for (size_t i = 0; i + 1 < len; ++i)
+        {
+            if (p[i] == '\r' && p[i + 1] == '\n')
+                return i;
+        }
+        return HttpScan::npos;
+    }
+
+    size_t ScalarFindHeaderEnd(const char *p, size_t len) noexcept
+    {
+        for (size_t i = 0; i + 3 < len; ++i)
+        {
+            if (p[i] == '\r' && p[i + 1] == '\n' && p[i + 2] == '\r' && p[i + 3] == '\n')
+                return i;
+        }
+        return HttpScan::npos;
+    }
+
+    size_t ScalarTokenLength(const char *p, size_t len) noexcept
+    {
+        size_t i = 0;
+        while (i < len && kTchar[static_cast<unsigned char>(p[i])])
+            ++i;
+        return i;
+    }
+
+    // SIMD 본체가 처리한 뒤 남은 꼬리 (offset 기준 결과로 변환)
+    size_t Tail(size_t found, size_t offset) noexcept
+    {
+        return found == HttpScan::npos ? HttpScan::npos : offset + found;
+    }
+
+#if HTTP_SCAN_X86
+    // ---------------- 16 byte (SSE4.2 tier) ----------------
+
+    __attribute__((target("sse4.2"))) size_t Sse42FindByte(const char *p, size_t len, char c) noexcept
+    {
+        const __m128i needle = _mm_set1_epi8(c);
+        size_t i = 0;
+        for (; i + 16 <= len; i += 16)
+        {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+            const unsigned m = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, needle)));
+            if (m)
+                return i + static_cast<size_t>(__builtin_ctz(m));
+        }
+        return Tail(ScalarFindByte(p + i, len - i, c), i);
+    }
+
+    __attribute__((target("sse4.2"))) size_t Sse42FindCrlf(const char *p, size_t len) noexcept
+    {
+        const __m128i cr = _mm_set1_epi8('\r');
+        const __m128i lf = _mm_set1_epi8('\n');
+        size_t i = 0;
+        // p[i] == '\r' 와 p[i+1] == '\n' 을 한 블록에서 같이 본다
+        for (; i + 17 <= len; i += 16)
+        {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i + 1));
+            const unsigned m = static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, cr), _mm_cmpeq_epi8(b, lf))));
+            if (m)
+                return i + static_cast<size_t>(__builtin_ctz(m));
+        }
+        return Tail(ScalarFindCrlf(p + i, len - i), i);
+    }
+
+    __attribute__((target("sse4.2"))) size_t Sse42FindHeaderEnd(const char *p, size_t len) noexcept
+    {
+        const __m128i cr = _mm_set1_epi8('\r');
+        const __m128i lf = _mm_set1_epi8('\n');
+        size_t i = 0;
+        for (; i + 19 <= len; i += 16)
+        {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i + 1));
+            const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i + 2));
+            const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i + 3));
+            const __m128i hit = _mm_and_si128(_mm_and_si128(_mm_cmpeq_epi8(a, cr), _mm_cmpeq_epi8(b, lf)),
+                                              _mm_and_si128(_mm_cmpeq_epi8(c, cr), _mm_cmpeq_epi8(d, lf)));
+            const unsigned m = static_cast<unsigned>(_mm_movemask_epi8(hit));
+            if (m)
+                return i + static_cast<size_t>(__builtin_ctz(m));
+        }
+        return Tail(ScalarFindHeaderEnd(p + i, len - i), i);
+    }
+
+    __attribute__((target("sse4.2"))) size_t Sse42TokenLength(const char *p, size_t len) noexcept
+    {
+        const __m128i loBits = _mm_loadu_si128(reinterpret_cast<const __m128i *>(kLoBits.data()));
+        const __m128i hiBits = _mm_loadu_si128(reinterpret_cast<const __m128i *>(kHiBits.data()));
+        const __m128i nibble = _mm_set1_epi8(0x0F);
+        const __m128i zero = _mm_setzero_si128();
+        size_t i = 0;
+        for (; i + 16 <= len; i += 16)
+        {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+            const __m128i lo = _mm_shuffle_epi8(loBits, _mm_and_si128(v, nibble));
+            const __m128i hi = _mm_shuffle_epi8(hiBits, _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+            const unsigned bad = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(lo, hi), zero)));
+            if (bad)
+                return i + static_cast<size_t>(__builtin_ctz(bad));
+        }
+        return i + ScalarTokenLength(p + i, len - i);
+    }
+
+    // ---------------- 32 byte (AVX2) ----------------
+
+    __attribute__((target("avx2"))) size_t Avx2FindByte(const char *p, size_t len, char c) noexcept
+    {
+        const __m256i needle = _mm256_set1_epi8(c);
+        size_t i = 0;
+        for (; i + 32 <= len; i += 32)
+        {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+            const unsigned m = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, needle)));
+            if (m)
+                return i + static_cast<size_t>(__builtin_ctz(m));
+        }
+        return Tail(ScalarFindByte(p + i, len - i, c), i);
+    }
+
+    __attribute__((target("avx2"))) size_t Avx2FindCrlf(const char *p, size_t len) noexcept
+    {
+        const __m256i cr = _mm256_set1_epi8('\r');
+        const __m256i lf = _mm256_set1_epi8('\n');
+        size_t i = 0;
+        for (; i + 33 <= len; i += 32)
+        {
+            const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i + 1));
+            const unsigned m = static_cast<unsigned>(
+                _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, cr), _mm256_cmpeq_epi8(b, lf))));
+            if (m)
+                return i + static_cast<size_t>(__builtin_ctz(m));
+        }
+        return Tail(ScalarFindCrlf(p + i, len - i), i);
+    }
+
+    __attribute__((target("avx2"))) size_t Avx2FindHeaderEnd(const char *p, size_t len) noexcept
+    {
+        const __m256i cr = _mm256_set1_epi8('\r');
+        const __m256i lf = _mm256_set1_epi8('\n');
+        size_t i = 0;
+        for (; i + 35 <= len; i += 32)
+        {
+            const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i + 1));
+            const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i + 2));
+            const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i + 3));
+            const __m256i hit =
+                _mm256_and_si256(_mm256_and_si256(_mm256_cmpeq_epi8(a, cr), _mm256_cmpeq_epi8(b, lf)),
+                                 _mm256_and_si256(_mm256_cmpeq_epi8(c, cr), _mm256_cmpeq_epi8(d, lf)));
+            const unsigned m = static_cast<unsigned>(_mm256_movemask_epi8(hit));
+            if (m)
+                return i + static_cast<size_t>(__builtin_ctz(m));
+        }
+        return Tail(ScalarFindHeaderEnd(p + i, len - i), i);
+    }
+
+    __attribute__((target("avx2"))) size_t Avx2TokenLength(const char *p, size_t len) noexcept
+    {
+        // pshufb 는 128bit lane 별로 동작하므로 표를 두 lane 에 복제
+        const __m256i loBits = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(kLoBits.data())));
+        const __m256i hiBits = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(kHiBits.data())));
+        const __m256i nibble = _mm256_set1_epi8(0x0F);
+        const __m256i zero = _mm256_setzero_si256();
+        size_t i = 0;
+        for (; i + 32 <= len; i += 32)
+        {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+            const __m256i lo = _mm256_shuffle_epi8(loBits, _mm256_and_si256(v, nibble));
+            const __m256i hi = _mm256_shuffle_epi8(hiBits, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+            const unsigned bad =
+                static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(lo, hi), zero)));
+            if (bad)
+                return i + static_cast<size_t>(__builtin_ctz(bad));
+        }
+        return i + ScalarTokenLength(p + i, len - i);
+    }
+#endif
+
+    struct ScanOps
+    {
+        eHttpScanLevel level;
+        size_t (*findByte)(const char *, size_t, char) noexcept;
+        size_t (*findCrlf)(const char *, size_t) noexcept;
+        size_t (*findHeaderEnd)(const char *, size_t) noexcept;
+        size_t (*tokenLength)(const char *, size_t) noexcept;
+    };
+
+    constexpr ScanOps kScalarOps{HttpScan_Scalar, ScalarFindByte, ScalarFindCrlf, ScalarFindHeaderEnd, ScalarTokenLength};
+#if HTTP_SCAN_X86
+    constexpr ScanOps kSse42Ops{HttpScan_Sse42, Sse42FindByte, Sse42FindCrlf, Sse42FindHeaderEnd, Sse42TokenLength};
+    constexpr ScanOps kAvx2Ops{HttpScan_Avx2, Avx2FindByte, Avx2FindCrlf, Avx2FindHeaderEnd, Avx2TokenLength};
+#endif
+
+    const ScanOps *OpsFor(eHttpScanLevel level) noexcept
+    {
+#if HTTP_SCAN_X86
+        if (level == HttpScan_Avx2)
+            return &kAvx2Ops;
+        if (level == HttpScan_Sse42)
+            return &kSse42Ops;
+#endif
+        (void)level;
+        return &kScalarOps;
+    }
+
+    // 첫 호출 때 CPU 확인 (정적 초기화 순서와 무관하게)
+    std::atomic<const ScanOps *> &ActiveOps() noexcept
+    {
+        static std::atomic<const ScanOps *> ops{OpsFor(HttpScan::BestSupportedLevel())};
+        return ops;
+    }
+
+    const ScanOps &Ops() noexcept
+    {
+        return *ActiveOps().load(std::memory_order_relaxed);
+    }
+}
+
+size_t HttpScan::FindByte(const char *p, size_t len, char c) noexcept
+{
+    return Ops().findByte(p, len, c);
+}
+
+size_t HttpScan::FindCrlf(const char *p, size_t len) noexcept
+{
+    return Ops().findCrlf(p, len);
+}
+
+size_t HttpScan::FindHeaderEnd(const char *p, size_t len) noexcept
+{
+    return Ops().findHeaderEnd(p, len);
+}
+
+size_t HttpScan::TokenLength(const char *p, size_t len) noexcept
+{
+    return Ops().tokenLength(p, len);
+}
+
+bool HttpScan::IsTokenChar(char c) noexcept
+{
+    return kTchar[static_cast<unsigned char>(c)];
+}
+
+eHttpScanLevel HttpScan::Level() noexcept
+{
+    return Ops().level;
+}
+
+eHttpScanLevel HttpScan::BestSupportedLevel() noexcept
+{
+#if HTTP_SCAN_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return HttpScan_Avx2;
+    if (__builtin_cpu_supports("sse4.2"))
+        return HttpScan_Sse42;
+#endif
+    return HttpScan_Scalar;
+}
+
+bool HttpScan::SetLevel(eHttpScanLevel level) noexcept
+{
+    if (level > BestSupportedLevel())
+        return false;
+    ActiveOps().store(OpsFor(level), std::memory_order_relaxed);
+    return true;
+}
@@ -0,0 +1,517 @@
+#include "IoUring.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace
+{
+    int SysSetup(unsigned entries, io_uring_params *params)
+    {
+        return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+    }
+
+    int SysEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags, const void *arg, size_t argSize)
+    {
+        return static_cast<int>(::syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, arg, argSize));
+    }
+
+    int SysRegister(int fd, unsigned opcode, void *arg, unsigned nrArgs)
+    {
+        return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, nrArgs));
+    }
+
+    // 커널과 공유하는 head/tail 은 acquire/release 로만 접근
+    unsigned LoadAcquire(const unsigned *p)
+    {
+        return std::atomic_ref<const unsigned>(*p).load(std::memory_order_acquire);
+    }
+
+    void StoreRelease(unsigned *p, unsigned v)
+    {
+        std::atomic_ref<unsigned>(*p).store(v, std::memory_order_release);
+    }
+
+    template <typename T>
+    T *At(void *base, std::uint32_t offset)
+    {
+        return reinterpret_cast<T *>(static_cast<std::uint8_t *>(base) + offset);
+    }
+}
+
+IoUring::~IoUring()
+{
+    Close();
+}
+
+eIoUringError IoUring::Open(unsigned entries, unsigned flags)
+{
+    if (mFd >= 0)
+        return IoUring_InvalidState;
+
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    params.flags = flags;
+
+    const int fd = SysSetup(entries, &params);
+    if (fd < 0)
+        return (errno == ENOSYS || errno == EPERM) ? IoUring_NotSupported : IoUring_SetupFailed;
+
+    // 대기 timeout 을 io_uring_enter 인자로 넘기므로 EXT_ARG 가 필요 (5.11+)
+    if ((params.features & IORING_FEAT_EXT_ARG) == 0)
+    {
+        ::close(fd);
+        return IoUring_NotSupported;
+    }
+
+    mFd = fd;
+    mFeatures = params.features;
+
+    mSqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    mCqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMmap)
+    {
+        if (mCqRingSize > mSqRingSize)
+            mSqRingSize = mCqRingSize;
+        mCqRingSize = mSqRingSize;
+    }
+
+    mSqRing = ::mmap(nullptr, mSqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (mSqRing == MAP_FAILED)
+    {
+        mSqRing = nullptr;
+        Close();
+        return IoUring_MapFailed;
+    }
+
+    if (singleMmap)
+    {
+        mCqRing = mSqRing;
+    }
+    else
+    {
+        mCqRing = ::mmap(nullptr, mCqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (mCqRing == MAP_FAILED)
+        {
+            mCqRing = nullptr;
+            Close();
+            return IoUring_MapFailed;
+        }
+    }
+
+    mSqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void *sqes = ::mmap(nullptr, mSqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED)
+    {
+        Close();
+        return IoUring_MapFailed;
+    }
+    mSqes = static_cast<io_uring_sqe *>(sqes);
+
+    mSqHead    = At<unsigned>(mSqRing, params.sq_off.head);
+    mSqTail    = At<unsigned>(mSqRing, params.sq_off.tail);
+    mSqMask    = *At<unsigned>(mSqRing, params.sq_off.ring_mask);
+    mSqEntries = *At<unsigned>(mSqRing, params.sq_off.ring_entries);
+    mSqArray   = At<unsigned>(mSqRing, params.sq_off.array);
+    mSqLocalTail = *mSqTail;
+
+    mCqHead = At<unsigned>(mCqRing, params.cq_off.head);
+    mCqTail = At<unsigned>(mCqRing, params.cq_off.tail);
+    mCqMask = *At<unsigned>(mCqRing, params.cq_off.ring_mask);
+    mCqes   = At<io_uring_cqe>(mCqRing, params.cq_off.cqes);
+
+    // sqe 와 array 를 1:1 로 고정해 두면 GetSqe 에서 array 를 다시 쓸 필요가 없다
+    for (unsigned i = 0; i < mSqEntries; ++i)
+        mSqArray[i] = i;
+
+    return IoUring_Ok;
+}
+
+void IoUring::Close()
+{
+    if (mSqes)
+        ::munmap(mSqes, mSqesSize);
+    if (mCqRing && mCqRing != mSqRing)
+        ::munmap(mCqRing, mCqRingSize);
+    if (mSqRing)
+        ::munmap(mSqRing, mSqRingSize);
+    if (mFd >= 0)
+        ::close(mFd);
+
+    mFd = -1;
+    mFeatures = 0;
+    mSqRing = nullptr;
+    mCqRing = nullptr;
+    mSqes = nullptr;
+    mSqHead = mSqTail = mSqArray = nullptr;
+    mCqHead = mCqTail = nullptr;
+    mCqes = nullptr;
+    mSqMask = mSqEntries = mSqLocalTail = mCqMask = 0;
+}
+
+bool IoUring::IsOpen() const noexcept
+{
+    return mFd >= 0;
+}
+
+int IoUring::Fd() const noexcept
+{
+    return mFd;
+}
+
+unsigned IoUring::Features() const noexcept
+{
+    return mFeatures;
+}
+
+unsigned IoUring::PendingSqes() const noexcept
+{
+    return mSqLocalTail - LoadAcquire(mSqHead);
+}
+
+unsigned IoUring::SqSpaceLeft() const noexcept
+{
+    if (mFd < 0)
+        return 0;
+    return mSqEntries - (mSqLocalTail - LoadAcquire(mSqHead));
+}
+
+io_uring_sqe *IoUring::GetSqe() noexcept
+{
+    if (mFd < 0)
+        return nullptr;
+
+    if (mSqLocalTail - LoadAcquire(mSqHead) >= mSqEntries)
+    {
+        // SQ 가 꽉 참: 지금까지 채운 것을 먼저 넘긴다
+        if (Submit() != IoUring_Ok || mSqLocalTail - LoadAcquire(mSqHead) >= mSqEntries)
+            return nullptr;
+    }
+
+    io_uring_sqe *sqe = &mSqes[mSqLocalTail & mSqMask];
+    std::memset(sqe, 0, sizeof(*sqe));
+    ++mSqLocalTail;
+    return sqe;
+}
+
+int IoUring::Enter(unsigned toSubmit, unsigned minComplete, unsigned flags, int timeoutMs) noexcept
+{
+    if (timeoutMs < 0)
+        return SysEnter(mFd, toSubmit, minComplete, flags, nullptr, 0);
+
+    __kernel_timespec ts;
+    ts.tv_sec  = timeoutMs / 1000;
+    ts.tv_nsec = static_cast<long long>(timeoutMs % 1000) * 1000000;
+
+    io_uring_getevents_arg arg;
+    std::memset(&arg, 0, sizeof(arg));
+    arg.ts = reinterpret_cast<std::uint64_t>(&ts);
+    return SysEnter(mFd, toSubmit, minComplete, flags | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+}
+
+eIoUringError IoUring::Submit()
+{
+    return SubmitAndWait(0, -1);
+}
+
+eIoUringError IoUring::SubmitAndWait(unsigned minComplete, int timeoutMs)
+{
+    if (mFd < 0)
+        return IoUring_InvalidState;
+
+    StoreRelease(mSqTail, mSqLocalTail);
+    const unsigned toSubmit = PendingSqes();
+
+    // 이미 cqe 가 있으면 기다리지 않는다
+    if (minComplete != 0 && LoadAcquire(mCqTail) - *mCqHead >= minComplete)
+        minComplete = 0;
+    if (toSubmit == 0 && minComplete == 0)
+        return IoUring_Ok;
+
+    const unsigned flags = (minComplete != 0) ? IORING_ENTER_GETEVENTS : 0;
+    const int r = Enter(toSubmit, minComplete, flags, (minComplete != 0) ? timeoutMs : -1);
+    if (r >= 0)
+        return IoUring_Ok;
+    if (errno == ETIME)
+        return IoUring_Timeout;
+    if (errno == EINTR)
+        return IoUring_Interrupted;
+    // CQ 가 밀려 커널이 제출을 거부: 남은 sqe 는 SQ 에 그대로 있으니 cqe 를 비운 뒤 다시 제출하면 된다
+    if (errno == EBUSY || errno == EAGAIN)
+        return IoUring_Ok;
+    return IoUring_EnterFailed;
+}
+
+unsigned IoUring::PeekCqes(io_uring_cqe **out, unsigned max) noexcept
+{
+    if (mFd < 0 || !out)
+        return 0;
+
+    const unsigned head  = *mCqHead;
+    const unsigned ready = LoadAcquire(mCqTail) - head;
+    const unsigned count = (ready < max) ? ready : max;
+    for (unsigned i = 0; i < count; ++i)
+        out[i] = &mCqes[(head + i) & mCqMask];
+    return count;
+}
+
+void IoUring::Advance(unsigned count) noexcept
+{
+    if (mFd < 0 || count == 0)
+        return;
+    StoreRelease(mCqHead, *mCqHead + count);
+}
+
+eIoUringError IoUring::Register(unsigned opcode, void *arg, unsigned nrArgs) noexcept
+{
+    if (mFd < 0)
+        return IoUring_InvalidState;
+    if (SysRegister(mFd, opcode, arg, nrArgs) < 0)
+        return (errno == EINVAL || errno == EOPNOTSUPP) ? IoUring_NotSupported : IoUring_RegisterFailed;
+    return IoUring_Ok;
+}
+
+bool IoUring::IsSupported() noexcept
+{
+    IoUring probe;
+    return probe.Open(4) == IoUring_Ok;
+}
+
+IoUringBufferRing::~IoUringBufferRing()
+{
+    Close();
+}
+
+eIoUringError IoUringBufferRing::Open(IoUring &ring, std::uint16_t groupId, unsigned count, size_t bufSize)
+{
+    if (mBuffers)
+        return IoUring_InvalidState;
+    if (!ring.IsOpen())
+        return IoUring_InvalidState;
+    if (count == 0 || count > 32768 || (count & (count - 1)) != 0 || bufSize == 0 || bufSize > UINT32_MAX)
+        return IoUring_SetupFailed;
+
+    mBufferBytes = count * bufSize;
+    void *buffers = ::mmap(nullptr, mBufferBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (buffers == MAP_FAILED)
+    {
+        mBufferBytes = 0;
+        return IoUring_MapFailed;
+    }
+
+    mRing    = &ring;
+    mBuffers = static_cast<std::uint8_t *>(buffers);
+    mBufSize = bufSize;
+    mCount   = count;
+    mGroupId = groupId;
+    mTail    = 0;
+
+    if (OpenMapped())
+        return IoUring_Ok;
+    mDeferred.reserve(count); // Recycle (noexcept) 에서 재할당이 일어나지 않게
+
+    // 처음에는 전부 커널에 넘겨 둔다 (sqe 하나로 연속 bid 전체)
+    if (!Provide(0, count) || ring.SubmitAndWait(1, 1000) != IoUring_Ok)
+    {
+        Close();
+        return IoUring_RegisterFailed;
+    }
+
+    io_uring_cqe *cqe = nullptr;
+    const bool ok = ring.PeekCqes(&cqe, 1) == 1 && cqe->user_data == kProvideUserData && cqe->res >= 0;
+    if (cqe)
+        ring.Advance(1);
+    if (!ok)
+    {
+        Close();
+        return IoUring_RegisterFailed;
+    }
+    return IoUring_Ok;
+}
+
+bool IoUringBufferRing::OpenMapped()
+{
+    // ring 은 페이지 정렬이어야 하므로 mmap 으로 잡는다
+    mRingBytes = mCount * sizeof(io_uring_buf);
+    void *ringMem = ::mmap(nullptr, mRingBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ringMem == MAP_FAILED)
+    {
+        mRingBytes = 0;
+        return false;
+    }
+
+    io_uring_buf_reg reg;
+    std::memset(&reg, 0, sizeof(reg));
+    reg.ring_addr    = reinterpret_cast<std::uint64_t>(ringMem);
+    reg.ring_entries = mCount;
+    reg.bgid         = mGroupId;
+
+    if (mRing->Register(IORING_REGISTER_PBUF_RING, &reg, 1) != IoUring_Ok)
+    {
+        ::munmap(ringMem, mRingBytes);
+        mRingBytes = 0;
+        return false;
+    }
+    mBufRing = static_cast<io_uring_buf_ring *>(ringMem);
+
+    for (unsigned i = 0; i < mCount; ++i)
+    {
+        io_uring_buf &buf = mBufRing->bufs[(mTail + i) & (mCount - 1)];
+        buf.addr = reinterpret_cast<std::uint64_t>(mBuffers + i * mBufSize);
+        buf.len  = static_cast<std::uint32_t>(mBufSize);
+        buf.bid  = static_cast<std::uint16_t>(i);
+    }
+    mTail = static_cast<std::uint16_t>(mTail + mCount);
+    std::atomic_ref<std::uint16_t>(mBufRing->tail).store(mTail, std::memory_order_release);
+
+    if (ProbeMapped())
+        return true;
+
+    std::memset(&reg, 0, sizeof(reg));
+    reg.bgid = mGroupId;
+    (void)mRing->Register(IORING_UNREGISTER_PBUF_RING, &reg, 1);
+    ::munmap(mBufRing, mRingBytes);
+    mBufRing   = nullptr;
+    mRingBytes = 0;
+    mTail      = 0;
+    return false;
+}
+
+bool IoUringBufferRing::ProbeMapped()
+{
+    // 등록은 성공해도 선택이 안 되는 커널이 있다: pipe 1바이트를 buffer select read 로 읽어 본다
+    int fds[2];
+    if (::pipe2(fds, O_CLOEXEC) != 0)
+        return false;
+
+    bool ok = false;
+    io_uring_sqe *sqe = (::write(fds[1], "x", 1) == 1) ? mRing->GetSqe() : nullptr;
+    if (sqe)
+    {
+        sqe->opcode    = IORING_OP_READ;
+        sqe->fd        = fds[0];
+        sqe->flags     = IOSQE_BUFFER_SELECT;
+        sqe->buf_group = mGroupId;
+        sqe->len       = static_cast<std::uint32_t>(mBufSize);
+        sqe->user_data = kProvideUserData;
+
+        io_uring_cqe *cqe = nullptr;
+        if (mRing->SubmitAndWait(1, 1000) == IoUring_Ok && mRing->PeekCqes(&cqe, 1) == 1)
+        {
+            ok = cqe->res == 1 && (cqe->flags & IORING_CQE_F_BUFFER);
+            const std::uint32_t flags = cqe->flags;
+            mRing->Advance(1);
+            if (ok)
+                Recycle(BufferId(flags));
+        }
+    }
+
+    ::close(fds[0]);
+    ::close(fds[1]);
+    return ok;
+}
+
+bool IoUringBufferRing::Provide(std::uint16_t bid, unsigned count) noexcept
+{
+    io_uring_sqe *sqe = mRing->GetSqe();
+    if (!sqe)
+        return false;
+
+    sqe->opcode    = IORING_OP_PROVIDE_BUFFERS;
+    sqe->fd        = static_cast<int>(count);
+    sqe->addr      = reinterpret_cast<std::uint64_t>(mBuffers + static_cast<size_t>(bid) * mBufSize);
+    sqe->len       = static_cast<std::uint32_t>(mBufSize);
+    sqe->off       = bid;
+    sqe->buf_group = mGroupId;
+    sqe->user_data = kProvideUserData;
+    return true;
+}
+
+void IoUringBufferRing::Close()
+{
+    if (mBufRing && mRing && mRing->IsOpen())
+    {
+        io_uring_buf_reg reg;
+        std::memset(&reg, 0, sizeof(reg));
+        reg.bgid = mGroupId;
+        (void)mRing->Register(IORING_UNREGISTER_PBUF_RING, &reg, 1);
+    }
+    // PROVIDE_BUFFERS 로 넘긴 버퍼는 ring 을 닫을 때 커널이 같이 정리한다
+    if (mBuffers)
+        ::munmap(mBuffers, mBufferBytes);
+    if (mBufRing)
+        ::munmap(mBufRing, mRingBytes);
+
+    mRing = nullptr;
+    mBufRing = nullptr;
+    mBuffers = nullptr;
+    mRingBytes = mBufferBytes = mBufSize = 0;
+    mCount = 0;
+    mTail = 0;
+    mDeferred.clear();
+}
+
+bool IoUringBufferRing::IsOpen() const noexcept
+{
+    return mBuffers != nullptr;
+}
+
+bool IoUringBufferRing::IsMapped() const noexcept
+{
+    return mBufRing != nullptr;
+}
+
+std::uint16_t IoUringBufferRing::GroupId() const noexcept
+{
+    return mGroupId;
+}
+
+size_t IoUringBufferRing::BufSize() const noexcept
+{
+    return mBufSize;
+}
+
+unsigned IoUringBufferRing::Count() const noexcept
+{
+    return mCount;
+}
+
+const std::uint8_t *IoUringBufferRing::Buffer(std::uint16_t bid) const noexcept
+{
+    if (!mBuffers || bid >= mCount)
+        return nullptr;
+    return mBuffers + static_cast<size_t>(bid) * mBufSize;
+}
+
+void IoUringBufferRing::Recycle(std::uint16_t bid) noexcept
+{
+    if (!mBuffers || bid >= mCount)
+        return;
+
+    if (!mBufRing)
+    {
+        // 앞서 못 넘긴 것부터. sqe 가 또 모자라면 다음 Recycle 때 다시
+        while (!mDeferred.empty() && Provide(mDeferred.back(), 1))
+            mDeferred.pop_back();
+        if (!mDeferred.empty() || !Provide(bid, 1))
+            mDeferred.push_back(bid);
+        return;
+    }
+
+    io_uring_buf &buf = mBufRing->bufs[mTail & (mCount - 1)];
+    buf.addr = reinterpret_cast<std::uint64_t>(mBuffers + static_cast<size_t>(bid) * mBufSize);
+    buf.len  = static_cast<std::uint32_t>(mBufSize);
+    buf.bid  = bid;
+    ++mTail;
+    std::atomic_ref<std::uint16_t>(mBufRing->tail).store(mTail, std::memory_order_release);
+}
+
+std::uint16_t IoUringBufferRing::BufferId(std::uint32_t cqeFlags) noexcept
+{
+    return static_cast<std::uint16_t>(cqeFlags >> IORING_CQE_BUFFER_SHIFT);
+}
@@ -12,7 +12,7 @@ ListenerSocket::~ListenerSocket()
 }
 
 ListenerSocket::ListenerSocket(ListenerSocket &&other) noexcept
-    : mListenSocket(other.mListenSocket), mPort(other.mPort), mBacklog(other.mBacklog)
+    : mListenSocket(other.mListenSocket), mPort(other.mPort), mBacklog(other.mBacklog), mReusePort(other.mReusePort)
 {
     other.mListenSocket = -1;
 }
@@ -24,6 +24,7 @@ ListenerSocket &ListenerSocket::operator=(ListenerSocket &&other) noexcept
         mListenSocket = other.mListenSocket;
         mPort = other.mPort;
         mBacklog = other.mBacklog;
+        mReusePort = other.mReusePort;
 
         other.mListenSocket = -1;
     }
@@ -31,6 +32,11 @@ ListenerSocket &ListenerSocket::operator=(ListenerSocket &&other) noexcept
     return *this;
 }
 
+void ListenerSocket::SetReusePort(bool enable) noexcept
+{
+    mReusePort = enable;
+}
+
 eListenerSocketError ListenerSocket::Open()
 {
     Close();
@@ -43,6 +49,17 @@ eListenerSocketError ListenerSocket::Open()
     }
     std::printf("[ListenerSocket::Open] socket fd=%d\n", mListenSocket);
 
+    if (mReusePort)
+    {
+        int one = 1;
+        if (::setsockopt(mListenSocket, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) < 0)
+        {
+            std::perror("[ListenerSocket::Open] SO_REUSEPORT failed");
+            Close();
+            return ListenerSocket_OptionFailed;
+        }
+    }
+
     int flags = ::fcntl(mListenSocket, F_GETFL, 0);
     if (flags >= 0)
     {
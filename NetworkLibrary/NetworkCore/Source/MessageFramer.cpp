@@ -26,11 +26,34 @@ eFrameError MessageFramer::Encode(const void* data, std::size_t len, std::vector
     return eFrameError::Framer_Ok;
 }
 
+eFrameError MessageFramer::EncodeHeader(std::size_t len, std::uint8_t (&out)[kHeaderSize]){
+    if(len > kMaxPayload) return eFrameError::Framer_Overflow;
+    WriteU32BE(out, static_cast<std::uint32_t>(len));
+    return eFrameError::Framer_Ok;
+}
+
 eFrameError MessageFramer::PopFrame(RecvBuffer &rb, Frame &out){
     if(!rb.IsOpen()) return eFrameError::Framer_NotOpen;
     const std::size_t available = rb.WriteSpace();
     if(available < kHeaderSize) return eFrameError::Framer_NeedMore;
 
+    // 프레임 전체가 연속 구간에 있으면 scratch peek 없이 ring 메모리에서 바로 꺼낸다.
+    const std::uint8_t* contiguous = nullptr;
+    std::size_t contiguousLen = 0;
+    if(rb.PeekContiguous(contiguous, contiguousLen) == RecvBuf_Ok && contiguousLen >= kHeaderSize){
+        const std::uint32_t len = ReadU32BE(contiguous);
+        if(len > kMaxPayload) return eFrameError::Framer_Overflow;
+
+        const std::size_t total = kHeaderSize + static_cast<std::size_t>(len);
+        if(available < total) return eFrameError::Framer_NeedMore;
+
+        if(contiguousLen >= total){
+            out.payload.assign(contiguous + kHeaderSize, contiguous + total);
+            if(rb.Consume(total) != RecvBuf_Ok) return eFrameError::Framer_BufferError;
+            return eFrameError::Framer_Ok;
+        }
+    }
+
     std::uint8_t hdr[kHeaderSize]{};
     std::size_t outPeek = 0;
     {
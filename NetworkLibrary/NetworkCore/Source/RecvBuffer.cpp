@@ -1,7 +1,7 @@
 #include "RecvBuffer.h"
 
-RecvBuffer::RecvBuffer(size_t bufSize)
-    : mRingBuffer(std::make_unique<RingBuffer>(bufSize))
+RecvBuffer::RecvBuffer(size_t bufSize, eRingBufferMode mode)
+    : mRingBuffer(std::make_unique<RingBuffer>(bufSize, mode))
     , mIsOpen(false)
 {
 }
@@ -158,6 +158,77 @@ eRecvBufferError RecvBuffer::Write(const void *src, size_t len, size_t &outWrite
     return RecvBuf_Ok;
 }
 
+eRecvBufferError RecvBuffer::PeekContiguous(const std::uint8_t*& outData, size_t& outLen) const
+{
+    outData = nullptr;
+    outLen  = 0;
+
+    if (!mIsOpen) {
+        return RecvBuf_NotOpen;
+    }
+    if (!mRingBuffer) {
+        return RecvBuf_InternalError;
+    }
+    if (mRingBuffer->IsEmpty()) {
+        return RecvBuf_Underflow;
+    }
+
+    outData = mRingBuffer->ReadRegion(outLen);
+    return RecvBuf_Ok;
+}
+
+eRecvBufferError RecvBuffer::GetReadableSpans(struct iovec* outSpans, int maxSpans, int& outCount) const
+{
+    outCount = 0;
+
+    if (!mIsOpen) {
+        return RecvBuf_NotOpen;
+    }
+    if (!mRingBuffer) {
+        return RecvBuf_InternalError;
+    }
+    if (outSpans == nullptr || maxSpans <= 0) {
+        return RecvBuf_InvalidArgs;
+    }
+
+    outCount = mRingBuffer->GetReadableSpans(outSpans, maxSpans);
+    return RecvBuf_Ok;
+}
+
+eRecvBufferError RecvBuffer::GetWritableSpans(struct iovec* outSpans, int maxSpans, int& outCount)
+{
+    outCount = 0;
+
+    if (!mIsOpen) {
+        return RecvBuf_NotOpen;
+    }
+    if (!mRingBuffer) {
+        return RecvBuf_InternalError;
+    }
+    if (outSpans == nullptr || maxSpans <= 0) {
+        return RecvBuf_InvalidArgs;
+    }
+
+    outCount = mRingBuffer->GetWritableSpans(outSpans, maxSpans);
+    return RecvBuf_Ok;
+}
+
+eRecvBufferError RecvBuffer::CommitWrite(size_t len)
+{
+    if (!mIsOpen) {
+        return RecvBuf_NotOpen;
+    }
+    if (!mRingBuffer) {
+        return RecvBuf_InternalError;
+    }
+    if (len > mRingBuffer->FreeSpace()) {
+        return RecvBuf_Overflow;
+    }
+
+    mRingBuffer->CommitWrite(len);
+    return RecvBuf_Ok;
+}
+
 size_t RecvBuffer::BufSize() const noexcept
 {
     if (!mRingBuffer) {
@@ -202,3 +273,30 @@ bool RecvBuffer::IsFull() const
     }
     return mRingBuffer->IsFull();
 }
+
+bool RecvBuffer::IsMirrored() const
+{
+    if (!mRingBuffer) {
+        return false;
+    }
+    return mRingBuffer->IsMirrored();
+}
+
+void RecvBuffer::SetLazyStorage(bool lazy) noexcept
+{
+    if (mRingBuffer) {
+        mRingBuffer->SetLazy(lazy);
+    }
+}
+
+void RecvBuffer::ReleaseIdleStorage() noexcept
+{
+    if (mRingBuffer) {
+        mRingBuffer->ReleaseIfEmpty();
+    }
+}
+
+bool RecvBuffer::HasStorage() const noexcept
+{
+    return mRingBuffer && mRingBuffer->HasStorage();
+}
@@ -1,10 +1,33 @@
 #include "RingBuffer.h"
+#include "RingStoragePool.h"
 
 #include <cstring>
+#include <sys/mman.h>
+#include <unistd.h>
 
-RingBuffer::RingBuffer(size_t bufSize)
-    : mBufSize(bufSize), mBuf(bufSize ? std::make_unique<std::uint8_t[]>(bufSize) : nullptr), mIsFull(false), mReadPos(0), mWritePos(0)
+RingBuffer::RingBuffer(size_t bufSize, eRingBufferMode mode)
+    : mReadPos(0), mWritePos(0), mBufSize(0), mMask(0)
 {
+    if (bufSize == 0) {
+        return;
+    }
+
+    // 용량은 storage 를 갖기 전에 확정해 둔다 (lazy 모드에서도 BufSize/FreeSpace 가 일정하도록)
+    mBufSize = bufSize;
+    if (mode == RingBuffer_Mirrored) {
+        const long pageSize = ::sysconf(_SC_PAGESIZE);
+        if (pageSize > 0) {
+            size_t capacity = RoundUpPowerOfTwo(bufSize);
+            if (capacity < static_cast<size_t>(pageSize)) {
+                capacity = static_cast<size_t>(pageSize);
+            }
+            mBufSize      = capacity;
+            mWantMirrored = true;
+        }
+    }
+    mMask = IsPowerOfTwo(mBufSize) ? mBufSize - 1 : 0;
+
+    EnsureStorage();
 }
 
 RingBuffer::~RingBuffer()
@@ -13,44 +36,158 @@ RingBuffer::~RingBuffer()
 }
 
 RingBuffer::RingBuffer(RingBuffer&& other) noexcept
-    : mBuf(std::move(other.mBuf)), mBufSize(other.mBufSize), mReadPos(other.mReadPos), mWritePos(other.mWritePos), mIsFull(other.mIsFull)
+    : mBuf(other.mBuf), mIsMirrored(other.mIsMirrored), mWantMirrored(other.mWantMirrored), mLazy(other.mLazy), mReadPos(other.mReadPos), mWritePos(other.mWritePos), mBufSize(other.mBufSize), mMask(other.mMask)
 {
-    other.mBufSize = 0;
-    other.mReadPos  = 0;
-    other.mWritePos = 0;
-    other.mIsFull   = false;
+    other.mBuf        = nullptr;
+    other.mIsMirrored = false;
+    other.mBufSize    = 0;
+    other.mMask       = 0;
+    other.mReadPos    = 0;
+    other.mWritePos   = 0;
 }
 
 RingBuffer& RingBuffer::operator=(RingBuffer&& other) noexcept
 {
     if (this != &other) {
-        mBuf       = std::move(other.mBuf);
-        mBufSize  = other.mBufSize;
-        mReadPos   = other.mReadPos;
-        mWritePos  = other.mWritePos;
-        mIsFull    = other.mIsFull;
-
-        other.mBufSize = 0;
-        other.mReadPos  = 0;
-        other.mWritePos = 0;
-        other.mIsFull   = false;
+        ReleaseStorage();
+
+        mBuf          = other.mBuf;
+        mIsMirrored   = other.mIsMirrored;
+        mWantMirrored = other.mWantMirrored;
+        mLazy         = other.mLazy;
+        mBufSize      = other.mBufSize;
+        mMask         = other.mMask;
+        mReadPos      = other.mReadPos;
+        mWritePos     = other.mWritePos;
+
+        other.mBuf        = nullptr;
+        other.mIsMirrored = false;
+        other.mBufSize    = 0;
+        other.mMask       = 0;
+        other.mReadPos    = 0;
+        other.mWritePos   = 0;
     }
     return *this;
 }
 
+bool RingBuffer::EnsureStorage() noexcept
+{
+    if (mBuf) {
+        return true;
+    }
+    if (mBufSize == 0) {
+        return false;
+    }
+
+    RingStoragePool::Block block;
+    if (RingStoragePool::Local().Acquire(mBufSize, mWantMirrored, block)) {
+        mBuf        = block.buf;
+        mIsMirrored = block.mirrored;
+        return true;
+    }
+
+    if (mWantMirrored && AllocateMirrored()) {
+        return true;
+    }
+    if (!mWantMirrored) {
+        return false;
+    }
+
+    // mirrored 매핑 실패 시 일반 heap(slab) 버퍼로 동작
+    mWantMirrored = false;
+    return EnsureStorage();
+}
+
+bool RingBuffer::AllocateMirrored() noexcept
+{
+    const size_t capacity = mBufSize;
+
+    const int fd = ::memfd_create("RingBuffer", MFD_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    if (::ftruncate(fd, static_cast<off_t>(capacity)) < 0) {
+        ::close(fd);
+        return false;
+    }
+
+    // 2배 크기의 주소 공간을 먼저 예약한 뒤 같은 fd 를 앞/뒤 절반에 겹쳐 매핑
+    void* base = ::mmap(nullptr, capacity * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+        ::close(fd);
+        return false;
+    }
+
+    auto* lower = static_cast<std::uint8_t*>(base);
+    void* first  = ::mmap(lower, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+    void* second = (first == MAP_FAILED)
+        ? MAP_FAILED
+        : ::mmap(lower + capacity, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+    ::close(fd);
+
+    if (first == MAP_FAILED || second == MAP_FAILED) {
+        ::munmap(base, capacity * 2);
+        return false;
+    }
+
+    mBuf        = lower;
+    mIsMirrored = true;
+    return true;
+}
+
+void RingBuffer::ReleaseStorage() noexcept
+{
+    if (!mBuf) {
+        return;
+    }
+
+    RingStoragePool::Block block;
+    block.buf      = mBuf;
+    block.capacity = mBufSize;
+    block.mirrored = mIsMirrored;
+    RingStoragePool::Local().Release(block);
+    mBuf = nullptr;
+}
+
+void RingBuffer::SetLazy(bool lazy) noexcept
+{
+    mLazy = lazy;
+    ReleaseIfEmpty();
+}
+
+void RingBuffer::ReleaseIfEmpty() noexcept
+{
+    if (mLazy && IsEmpty()) {
+        ReleaseStorage();
+    }
+}
+
+bool RingBuffer::IsLazy() const noexcept
+{
+    return mLazy;
+}
+
+bool RingBuffer::HasStorage() const noexcept
+{
+    return mBuf != nullptr;
+}
+
 void RingBuffer::Reset()
 {
     mReadPos  = 0;
     mWritePos = 0;
-    mIsFull   = false;
+    // lazy 모드는 비는 순간 저장 공간을 pool 로 돌려준다
+    if (mLazy) {
+        ReleaseStorage();
+    }
 }
 
 void RingBuffer::Close()
 {
     mReadPos  = 0;
     mWritePos = 0;
-    mIsFull   = false;
-    mBuf.reset();
+    ReleaseStorage();
 }
 
 size_t RingBuffer::BufSize() const noexcept
@@ -60,160 +197,220 @@ size_t RingBuffer::BufSize() const noexcept
 
 size_t RingBuffer::DataSpace() const noexcept
 {
-    if (mIsFull) {
-        return mBufSize;
-    }
-    if (mWritePos >= mReadPos) {
-        return mWritePos - mReadPos;
-    } else {
-        return mBufSize - (mReadPos - mWritePos);
-    }
+    return static_cast<size_t>(mWritePos - mReadPos);
 }
 size_t RingBuffer::FreeSpace() const noexcept
 {
-    if (mIsFull) {
-        return 0;
-    }
     return mBufSize - DataSpace();
 }
 bool RingBuffer::IsEmpty() const
 {
-    return !mIsFull && (mReadPos == mWritePos);
+    return mReadPos == mWritePos;
 }
 
 bool RingBuffer::IsFull() const
 {
-    return mIsFull;
+    return mBufSize != 0 && DataSpace() == mBufSize;
 }
 
-std::size_t RingBuffer::Read(void* dst, size_t len)
+bool RingBuffer::IsPowerOfTwo() const noexcept
 {
-    if (!mBuf || !dst || len == 0 || mBufSize == 0) {
-        return 0;
+    return mMask != 0;
+}
+
+bool RingBuffer::IsMirrored() const noexcept
+{
+    return mBuf ? mIsMirrored : mWantMirrored;
+}
+
+bool RingBuffer::IsPowerOfTwo(size_t value) noexcept
+{
+    return value > 1 && (value & (value - 1)) == 0;
+}
+
+size_t RingBuffer::RoundUpPowerOfTwo(size_t value) noexcept
+{
+    size_t cap = 2;
+    while (cap < value) {
+        cap <<= 1;
     }
+    return cap;
+}
 
-    std::size_t available = DataSpace();
-    if (available == 0) {
-        return 0;
+size_t RingBuffer::Index(std::uint64_t pos) const noexcept
+{
+    // power-of-two 모드에서는 나눗셈 없이 mask 한 번으로 끝난다.
+    if (mMask != 0) {
+        return static_cast<size_t>(pos & mMask);
     }
+    return static_cast<size_t>(pos % mBufSize);
+}
 
-    std::size_t toRead = (len < available) ? len : available;
-    auto* out = static_cast<std::uint8_t*>(dst);
+const std::uint8_t* RingBuffer::ReadRegion(size_t& outLen) const noexcept
+{
+    outLen = 0;
+    if (!mBuf) {
+        return nullptr;
+    }
 
-    std::size_t first    = toRead;
-    std::size_t untilEnd = mBufSize - mReadPos;
-    if (first > untilEnd) {
-        first = untilEnd;
+    const size_t idx       = Index(mReadPos);
+    const size_t available = DataSpace();
+    outLen = (mIsMirrored || available <= mBufSize - idx) ? available : mBufSize - idx;
+    return mBuf + idx;
+}
+
+std::uint8_t* RingBuffer::WriteRegion(size_t& outLen) noexcept
+{
+    outLen = 0;
+    if (!EnsureStorage()) {
+        return nullptr;
     }
 
-    std::memcpy(out, mBuf.get() + mReadPos, first);
-    mReadPos = (mReadPos + first) % mBufSize;
+    const size_t idx       = Index(mWritePos);
+    const size_t freeSpace = FreeSpace();
+    outLen = (mIsMirrored || freeSpace <= mBufSize - idx) ? freeSpace : mBufSize - idx;
+    return mBuf + idx;
+}
 
-    std::size_t readBytes = first;
+int RingBuffer::GetReadableSpans(struct iovec* outSpans, int maxSpans) const noexcept
+{
+    if (!outSpans || maxSpans <= 0) {
+        return 0;
+    }
 
-    std::size_t remain = toRead - first;
-    if (remain > 0) {
-        std::memcpy(out + first, mBuf.get() + mReadPos, remain);
-        mReadPos = (mReadPos + remain) % mBufSize;
-        readBytes += remain;
+    size_t firstLen = 0;
+    const std::uint8_t* first = ReadRegion(firstLen);
+    if (firstLen == 0) {
+        return 0;
     }
 
-    if (readBytes > 0) {
-        mIsFull = false;
+    outSpans[0].iov_base = const_cast<std::uint8_t*>(first);
+    outSpans[0].iov_len  = firstLen;
+
+    const size_t remain = DataSpace() - firstLen;
+    if (remain == 0 || maxSpans < 2) {
+        return 1;
     }
 
-    return readBytes;
+    outSpans[1].iov_base = mBuf;
+    outSpans[1].iov_len  = remain;
+    return 2;
 }
-std::size_t RingBuffer::Peek(void* dst, size_t len)
+
+int RingBuffer::GetWritableSpans(struct iovec* outSpans, int maxSpans) noexcept
 {
-    if (!mBuf || !dst || len == 0 || mBufSize == 0) {
+    if (!outSpans || maxSpans <= 0) {
         return 0;
     }
 
-    std::size_t available = DataSpace();
-    if (available == 0) {
+    size_t firstLen = 0;
+    std::uint8_t* first = WriteRegion(firstLen);
+    if (firstLen == 0) {
         return 0;
     }
 
-    std::size_t toPeek = (len < available) ? len : available;
-    auto* out = static_cast<std::uint8_t*>(dst);
-    std::size_t readPos = mReadPos;
+    outSpans[0].iov_base = first;
+    outSpans[0].iov_len  = firstLen;
 
-    std::size_t first    = toPeek;
-    std::size_t untilEnd = mBufSize - readPos;
-    if (first > untilEnd) {
-        first = untilEnd;
+    const size_t remain = FreeSpace() - firstLen;
+    if (remain == 0 || maxSpans < 2) {
+        return 1;
     }
 
-    std::memcpy(out, mBuf.get() + readPos, first);
-    readPos = (readPos + first) % mBufSize;
+    outSpans[1].iov_base = mBuf;
+    outSpans[1].iov_len  = remain;
+    return 2;
+}
 
-    std::size_t readBytes = first;
+std::size_t RingBuffer::CommitWrite(size_t len) noexcept
+{
+    const std::size_t freeSpace = FreeSpace();
+    const std::size_t committed = (len < freeSpace) ? len : freeSpace;
+    mWritePos += committed;
+    return committed;
+}
 
-    std::size_t remain = toPeek - first;
-    if (remain > 0) {
-        std::memcpy(out + first, mBuf.get() + readPos, remain);
-        readPos = (readPos + remain) % mBufSize;
-        readBytes += remain;
+void RingBuffer::CopyOut(std::uint64_t pos, void* dst, size_t len) const
+{
+    auto* out = static_cast<std::uint8_t*>(dst);
+    const size_t idx   = Index(pos);
+    if (mIsMirrored) {
+        std::memcpy(out, mBuf + idx, len);
+        return;
     }
 
-    return readBytes;
+    const size_t first = (len < mBufSize - idx) ? len : mBufSize - idx;
+
+    std::memcpy(out, mBuf + idx, first);
+    if (len > first) {
+        std::memcpy(out + first, mBuf, len - first);
+    }
 }
-void RingBuffer::Consume(size_t len)
+
+void RingBuffer::CopyIn(std::uint64_t pos, const void* src, size_t len)
 {
-   if (len == 0 || mBufSize == 0) {
+    auto* in = static_cast<const std::uint8_t*>(src);
+    const size_t idx   = Index(pos);
+    if (mIsMirrored) {
+        std::memcpy(mBuf + idx, in, len);
         return;
     }
 
-    std::size_t available = DataSpace();
-    if (available == 0) {
-        return;
+    const size_t first = (len < mBufSize - idx) ? len : mBufSize - idx;
+
+    std::memcpy(mBuf + idx, in, first);
+    if (len > first) {
+        std::memcpy(mBuf, in + first, len - first);
     }
+}
 
-    if (len >= available) {
+std::size_t RingBuffer::Read(void* dst, size_t len)
+{
+    std::size_t toRead = Peek(dst, len);
+    mReadPos += toRead;
+    if (mLazy && toRead != 0 && mReadPos == mWritePos) {
         Reset();
-        return;
     }
-
-    mReadPos = (mReadPos + len) % mBufSize;
-    mIsFull  = false;
+    return toRead;
 }
-std::size_t RingBuffer::Write(const void* src, size_t len)
+std::size_t RingBuffer::Peek(void* dst, size_t len)
 {
-    if (!mBuf || !src || len == 0 || mBufSize == 0) {
+    if (!mBuf || !dst) {
         return 0;
     }
 
-    std::size_t freeSpace = FreeSpace();
-    if (freeSpace == 0) {
+    const std::size_t available = DataSpace();
+    const std::size_t toPeek    = (len < available) ? len : available;
+    if (toPeek == 0) {
         return 0;
     }
 
-    std::size_t toWrite = (len < freeSpace) ? len : freeSpace;
-    auto* in = static_cast<const std::uint8_t*>(src);
-
-    // 첫 번째 연속 구간
-    std::size_t first    = toWrite;
-    std::size_t untilEnd = mBufSize - mWritePos;
-    if (first > untilEnd) {
-        first = untilEnd;
+    CopyOut(mReadPos, dst, toPeek);
+    return toPeek;
+}
+void RingBuffer::Consume(size_t len)
+{
+    const std::size_t available = DataSpace();
+    if (len >= available) {
+        Reset();
+        return;
     }
 
-    std::memcpy(mBuf.get() + mWritePos, in, first);
-    mWritePos = (mWritePos + first) % mBufSize;
-
-    std::size_t written = first;
-
-    std::size_t remain = toWrite - first;
-    if (remain > 0) {
-        std::memcpy(mBuf.get() + mWritePos, in + first, remain);
-        mWritePos = (mWritePos + remain) % mBufSize;
-        written  += remain;
+    mReadPos += len;
+}
+std::size_t RingBuffer::Write(const void* src, size_t len)
+{
+    if (!src || len == 0 || !EnsureStorage()) {
+        return 0;
     }
 
-    if (written > 0 && mWritePos == mReadPos) {
-        mIsFull = true;
+    const std::size_t freeSpace = FreeSpace();
+    const std::size_t toWrite   = (len < freeSpace) ? len : freeSpace;
+    if (toWrite == 0) {
+        return 0;
     }
 
-    return written;
-}
\ No newline at end of file
+    CopyIn(mWritePos, src, toWrite);
+    mWritePos += toWrite;
+    return toWrite;
+}
@@ -0,0 +1,108 @@
+#include "RingStoragePool.h"
+#include "SlabAllocator.h"
+
+#include <sys/mman.h>
+
+RingStoragePool::RingStoragePool(std::size_t maxCachedBytes)
+    : mMaxCachedBytes(maxCachedBytes)
+{
+}
+
+RingStoragePool::~RingStoragePool()
+{
+    Trim();
+}
+
+bool RingStoragePool::Acquire(std::size_t capacity, bool mirrored, Block& out) noexcept
+{
+    if (!mirrored) {
+        out.buf      = static_cast<std::uint8_t*>(SlabAllocator::Global().Allocate(capacity));
+        out.capacity = capacity;
+        out.mirrored = false;
+        return out.buf != nullptr;
+    }
+
+    // 최근에 돌려받은 블록부터 (cache 에 남아 있을 가능성이 높음)
+    for (std::size_t i = mFree.size(); i-- > 0;) {
+        if (mFree[i].capacity != capacity || mFree[i].mirrored != mirrored) {
+            continue;
+        }
+        out = mFree[i];
+        mFree[i] = mFree.back();
+        mFree.pop_back();
+        mCachedBytes -= capacity;
+        return true;
+    }
+    return false;
+}
+
+void RingStoragePool::Release(const Block& block) noexcept
+{
+    if (!block.buf) {
+        return;
+    }
+    if (!block.mirrored || mCachedBytes + block.capacity > mMaxCachedBytes) {
+        Free(block);
+        return;
+    }
+
+    try {
+        mFree.push_back(block);
+    } catch (...) {
+        Free(block);
+        return;
+    }
+    mCachedBytes += block.capacity;
+}
+
+void RingStoragePool::Trim() noexcept
+{
+    for (const Block& block : mFree) {
+        Free(block);
+    }
+    mFree.clear();
+    mCachedBytes = 0;
+}
+
+std::size_t RingStoragePool::CachedBlocks() const noexcept
+{
+    return mFree.size();
+}
+
+std::size_t RingStoragePool::CachedBytes() const noexcept
+{
+    return mCachedBytes;
+}
+
+std::size_t RingStoragePool::MaxCachedBytes() const noexcept
+{
+    return mMaxCachedBytes;
+}
+
+void RingStoragePool::SetMaxCachedBytes(std::size_t bytes) noexcept
+{
+    mMaxCachedBytes = bytes;
+    while (mCachedBytes > mMaxCachedBytes && !mFree.empty()) {
+        mCachedBytes -= mFree.back().capacity;
+        Free(mFree.back());
+        mFree.pop_back();
+    }
+}
+
+void RingStoragePool::Free(const Block& block) noexcept
+{
+    if (!block.buf) {
+        return;
+    }
+    if (block.mirrored) {
+        ::munmap(block.buf, block.capacity * 2);
+    } else {
+        SlabAllocator::Global().Free(block.buf, block.capacity);
+    }
+}
+
+RingStoragePool& RingStoragePool::Local()
+{
+    thread_local RingStoragePool pool;
+    return pool;
+}
@@ -0,0 +1,172 @@
+#include "SegmentPool.h"
+
+#include <cstring>
+#include <new>
+
+SegmentPool::SegmentPool(std::size_t maxCached)
+    : mMaxCached(maxCached)
+{
+}
+
+SegmentPool::~SegmentPool()
+{
+    Trim();
+}
+
+SendSegment* SegmentPool::NewDataSegment()
+{
+    void* raw = ::operator new(sizeof(SendSegment) + SendSegment::kCapacity, std::nothrow);
+    if (!raw) {
+        return nullptr;
+    }
+    return new (raw) SendSegment;
+}
+
+void SegmentPool::DeleteSegment(SendSegment* segment) noexcept
+{
+    if (segment->isShared) {
+        delete segment;
+        return;
+    }
+    segment->~SendSegment();
+    ::operator delete(segment);
+}
+
+SendSegment* SegmentPool::Acquire()
+{
+    SendSegment* segment = mFreeList;
+    if (segment) {
+        mFreeList = segment->next;
+        --mCached;
+    } else {
+        segment = NewDataSegment();
+        if (!segment) {
+            return nullptr;
+        }
+    }
+
+    segment->next     = nullptr;
+    segment->readPos  = 0;
+    segment->writePos = 0;
+    return segment;
+}
+
+SendSegment* SegmentPool::AcquireShared(SharedBuffer buffer, const void* prefix, std::size_t prefixLen)
+{
+    if (!buffer || prefixLen > SendSegment::kMaxPrefix || (prefix == nullptr && prefixLen != 0)) {
+        return nullptr;
+    }
+
+    SendSegment* segment = mSharedFreeList;
+    if (segment) {
+        mSharedFreeList = segment->next;
+        --mSharedCached;
+    } else {
+        segment = new (std::nothrow) SendSegment;
+        if (!segment) {
+            return nullptr;
+        }
+        segment->isShared = true;
+    }
+
+    segment->next      = nullptr;
+    segment->readPos   = 0;
+    segment->prefixLen = static_cast<std::uint8_t>(prefixLen);
+    if (prefixLen) {
+        std::memcpy(segment->prefix, prefix, prefixLen);
+    }
+    segment->writePos  = prefixLen + buffer->size();
+    segment->shared    = std::move(buffer);
+    return segment;
+}
+
+void SegmentPool::Release(SendSegment* segment) noexcept
+{
+    if (!segment) {
+        return;
+    }
+
+    if (segment->isShared) {
+        // payload 참조는 즉시 놓아서 마지막 구독자가 보내는 순간 해제되게 함
+        segment->shared.reset();
+        if (mSharedCached >= mMaxCached) {
+            delete segment;
+            return;
+        }
+        segment->next   = mSharedFreeList;
+        mSharedFreeList = segment;
+        ++mSharedCached;
+        return;
+    }
+
+    if (mCached >= mMaxCached) {
+        DeleteSegment(segment);
+        return;
+    }
+
+    segment->next = mFreeList;
+    mFreeList     = segment;
+    ++mCached;
+}
+
+void SegmentPool::Reserve(std::size_t count)
+{
+    while (mCached < count && mCached < mMaxCached) {
+        SendSegment* segment = NewDataSegment();
+        if (!segment) {
+            return;
+        }
+        segment->next = mFreeList;
+        mFreeList     = segment;
+        ++mCached;
+    }
+}
+
+void SegmentPool::Trim() noexcept
+{
+    while (mFreeList) {
+        SendSegment* next = mFreeList->next;
+        DeleteSegment(mFreeList);
+        mFreeList = next;
+    }
+    while (mSharedFreeList) {
+        SendSegment* next = mSharedFreeList->next;
+        DeleteSegment(mSharedFreeList);
+        mSharedFreeList = next;
+    }
+    mCached       = 0;
+    mSharedCached = 0;
+}
+
+std::size_t SegmentPool::CachedCount() const noexcept
+{
+    return mCached;
+}
+
+std::size_t SegmentPool::MaxCached() const noexcept
+{
+    return mMaxCached;
+}
+
+void SegmentPool::SetMaxCached(std::size_t maxCached) noexcept
+{
+    mMaxCached = maxCached;
+    while (mCached > mMaxCached && mFreeList) {
+        SendSegment* next = mFreeList->next;
+        DeleteSegment(mFreeList);
+        mFreeList = next;
+        --mCached;
+    }
+    while (mSharedCached > mMaxCached && mSharedFreeList) {
+        SendSegment* next = mSharedFreeList->next;
+        DeleteSegment(mSharedFreeList);
+        mSharedFreeList = next;
+        --mSharedCached;
+    }
+}
+
+SegmentPool& SegmentPool::Local()
+{
+    thread_local SegmentPool pool;
+    return pool;
+}
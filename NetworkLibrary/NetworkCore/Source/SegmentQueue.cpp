@@ -0,0 +1,313 @@
+#include "SegmentQueue.h"
+
+#include <cstring>
+#include <limits>
+
+SegmentQueue::SegmentQueue(size_t maxBytes, SegmentPool& pool)
+    : mPool(&pool), mMaxBytes(maxBytes)
+{
+}
+
+SegmentQueue::~SegmentQueue()
+{
+    Clear();
+}
+
+SegmentQueue::SegmentQueue(SegmentQueue&& other) noexcept
+    : mPool(other.mPool), mHead(other.mHead), mTail(other.mTail), mSize(other.mSize), mSegmentCount(other.mSegmentCount), mMaxBytes(other.mMaxBytes)
+{
+    other.mHead         = nullptr;
+    other.mTail         = nullptr;
+    other.mSize         = 0;
+    other.mSegmentCount = 0;
+}
+
+SegmentQueue& SegmentQueue::operator=(SegmentQueue&& other) noexcept
+{
+    if (this != &other) {
+        Clear();
+
+        mPool         = other.mPool;
+        mHead         = other.mHead;
+        mTail         = other.mTail;
+        mSize         = other.mSize;
+        mSegmentCount = other.mSegmentCount;
+        mMaxBytes     = other.mMaxBytes;
+
+        other.mHead         = nullptr;
+        other.mTail         = nullptr;
+        other.mSize         = 0;
+        other.mSegmentCount = 0;
+    }
+    return *this;
+}
+
+void SegmentQueue::Clear() noexcept
+{
+    while (mHead) {
+        PopHead();
+    }
+    mSize = 0;
+}
+
+SendSegment* SegmentQueue::AppendSegment()
+{
+    SendSegment* segment = mPool->Acquire();
+    if (!segment) {
+        return nullptr;
+    }
+
+    LinkTail(segment);
+    return segment;
+}
+
+void SegmentQueue::LinkTail(SendSegment* segment) noexcept
+{
+    if (mTail) {
+        mTail->next = segment;
+    } else {
+        mHead = segment;
+    }
+    mTail = segment;
+    ++mSegmentCount;
+}
+
+bool SegmentQueue::AppendShared(SharedBuffer buffer, const void* prefix, size_t prefixLen)
+{
+    if (!buffer) {
+        return false;
+    }
+
+    const size_t total = prefixLen + buffer->size();
+    if (total > FreeSpace()) {
+        return false;
+    }
+
+    SendSegment* segment = mPool->AcquireShared(std::move(buffer), prefix, prefixLen);
+    if (!segment) {
+        return false;
+    }
+
+    LinkTail(segment);
+    mSize += total;
+    return true;
+}
+
+bool SegmentQueue::PeekSharedHead(SharedBuffer& outBuffer, size_t& outPrefixRemain, size_t& outBodyOffset) const
+{
+    if (!mHead || !mHead->isShared || mHead->Readable() == 0) {
+        return false;
+    }
+
+    outBuffer       = mHead->shared;
+    outPrefixRemain = (mHead->readPos < mHead->prefixLen) ? mHead->prefixLen - mHead->readPos : 0;
+    outBodyOffset   = (mHead->readPos < mHead->prefixLen) ? 0 : mHead->readPos - mHead->prefixLen;
+    return true;
+}
+
+int SegmentQueue::SegmentSpans(const SendSegment* segment, struct iovec* outSpans, int maxSpans) noexcept
+{
+    if (maxSpans <= 0 || segment->Readable() == 0) {
+        return 0;
+    }
+
+    if (!segment->isShared) {
+        outSpans[0].iov_base = const_cast<std::uint8_t*>(segment->Data() + segment->readPos);
+        outSpans[0].iov_len  = segment->Readable();
+        return 1;
+    }
+
+    // shared: [prefix 남은 부분][body 남은 부분]
+    int count = 0;
+    const std::uint8_t* body = segment->shared->data();
+    if (segment->readPos < segment->prefixLen) {
+        outSpans[count].iov_base = const_cast<std::uint8_t*>(segment->prefix + segment->readPos);
+        outSpans[count].iov_len  = segment->prefixLen - segment->readPos;
+        ++count;
+        if (count < maxSpans && !segment->shared->empty()) {
+            outSpans[count].iov_base = const_cast<std::uint8_t*>(body);
+            outSpans[count].iov_len  = segment->shared->size();
+            ++count;
+        }
+        return count;
+    }
+
+    outSpans[0].iov_base = const_cast<std::uint8_t*>(body + (segment->readPos - segment->prefixLen));
+    outSpans[0].iov_len  = segment->Readable();
+    return 1;
+}
+
+void SegmentQueue::PopHead() noexcept
+{
+    SendSegment* segment = mHead;
+    mHead = segment->next;
+    if (!mHead) {
+        mTail = nullptr;
+    }
+    --mSegmentCount;
+    mPool->Release(segment);
+}
+
+std::size_t SegmentQueue::Write(const void* src, size_t len)
+{
+    if (!src) {
+        return 0;
+    }
+
+    const size_t freeSpace = FreeSpace();
+    size_t remain = (len < freeSpace) ? len : freeSpace;
+    auto* in = static_cast<const std::uint8_t*>(src);
+    size_t written = 0;
+
+    while (remain > 0) {
+        SendSegment* tail = mTail;
+        if (!tail || tail->Writable() == 0) {
+            tail = AppendSegment();
+            if (!tail) {
+                break;
+            }
+        }
+
+        const size_t chunk = (remain < tail->Writable()) ? remain : tail->Writable();
+        std::memcpy(tail->Data() + tail->writePos, in + written, chunk);
+        tail->writePos += chunk;
+        written += chunk;
+        remain  -= chunk;
+    }
+
+    mSize += written;
+    return written;
+}
+
+std::size_t SegmentQueue::Peek(void* dst, size_t len) const
+{
+    if (!dst) {
+        return 0;
+    }
+
+    auto* out = static_cast<std::uint8_t*>(dst);
+    size_t copied = 0;
+    for (const SendSegment* segment = mHead; segment && copied < len; segment = segment->next) {
+        struct iovec spans[2];
+        const int count = SegmentSpans(segment, spans, 2);
+        for (int i = 0; i < count && copied < len; ++i) {
+            size_t chunk = spans[i].iov_len;
+            if (chunk > len - copied) {
+                chunk = len - copied;
+            }
+            std::memcpy(out + copied, spans[i].iov_base, chunk);
+            copied += chunk;
+        }
+    }
+    return copied;
+}
+
+std::size_t SegmentQueue::Read(void* dst, size_t len)
+{
+    const size_t copied = Peek(dst, len);
+    Consume(copied);
+    return copied;
+}
+
+void SegmentQueue::Consume(size_t len) noexcept
+{
+    if (len > mSize) {
+        len = mSize;
+    }
+    mSize -= len;
+
+    while (len > 0 && mHead) {
+        const size_t readable = mHead->Readable();
+        if (len < readable) {
+            mHead->readPos += len;
+            return;
+        }
+
+        len -= readable;
+        PopHead();
+    }
+}
+
+int SegmentQueue::GetReadableSpans(struct iovec* outSpans, int maxSpans) const noexcept
+{
+    if (!outSpans) {
+        return 0;
+    }
+
+    int count = 0;
+    for (const SendSegment* segment = mHead; segment && count < maxSpans; segment = segment->next) {
+        count += SegmentSpans(segment, outSpans + count, maxSpans - count);
+    }
+    return count;
+}
+
+int SegmentQueue::GetWritableSpans(struct iovec* outSpans, int maxSpans)
+{
+    if (!outSpans || maxSpans <= 0 || FreeSpace() == 0) {
+        return 0;
+    }
+
+    SendSegment* tail = mTail;
+    if (!tail || tail->Writable() == 0) {
+        tail = AppendSegment();
+        if (!tail) {
+            return 0;
+        }
+    }
+
+    size_t len = tail->Writable();
+    if (len > FreeSpace()) {
+        len = FreeSpace();
+    }
+    outSpans[0].iov_base = tail->Data() + tail->writePos;
+    outSpans[0].iov_len  = len;
+    return 1;
+}
+
+std::size_t SegmentQueue::CommitWrite(size_t len) noexcept
+{
+    if (!mTail || mTail->isShared) {
+        return 0;
+    }
+
+    size_t committed = (len < mTail->Writable()) ? len : mTail->Writable();
+    if (committed > FreeSpace()) {
+        committed = FreeSpace();
+    }
+    mTail->writePos += committed;
+    mSize += committed;
+    return committed;
+}
+
+size_t SegmentQueue::MaxBytes() const noexcept
+{
+    return mMaxBytes;
+}
+
+size_t SegmentQueue::DataSpace() const noexcept
+{
+    return mSize;
+}
+
+size_t SegmentQueue::FreeSpace() const noexcept
+{
+    if (mMaxBytes == 0) {
+        return std::numeric_limits<size_t>::max() - mSize;
+    }
+    return (mSize < mMaxBytes) ? mMaxBytes - mSize : 0;
+}
+
+size_t SegmentQueue::SegmentCount() const noexcept
+{
+    return mSegmentCount;
+}
+
+bool SegmentQueue::IsEmpty() const noexcept
+{
+    return mSize == 0;
+}
+
+bool SegmentQueue::IsFull() const noexcept
+{
+    return mMaxBytes != 0 && mSize >= mMaxBytes;
+}
@@ -1,7 +1,8 @@
 #include "SendBuffer.h"
 
-SendBuffer::SendBuffer(size_t bufSize)
-    : mRingBuffer(std::make_unique<RingBuffer>(bufSize))
+SendBuffer::SendBuffer(size_t bufSize, eRingBufferMode mode, eSendBufferMode sendMode)
+    : mRingBuffer(sendMode == SendBufMode_Ring ? std::make_unique<RingBuffer>(bufSize, mode) : nullptr)
+    , mSegments(sendMode == SendBufMode_Segmented ? std::make_unique<SegmentQueue>(bufSize) : nullptr)
     , mIsOpen(false)
 {
 }
@@ -13,6 +14,7 @@ SendBuffer::~SendBuffer()
 
 SendBuffer::SendBuffer(SendBuffer&& other) noexcept
     : mRingBuffer(std::move(other.mRingBuffer))
+    , mSegments(std::move(other.mSegments))
     , mIsOpen(other.mIsOpen)
 {
     other.mIsOpen = false;
@@ -22,6 +24,7 @@ SendBuffer& SendBuffer::operator=(SendBuffer&& other) noexcept
 {
     if (this != &other) {
         mRingBuffer = std::move(other.mRingBuffer);
+        mSegments   = std::move(other.mSegments);
         mIsOpen     = other.mIsOpen;
 
         other.mIsOpen = false;
@@ -31,7 +34,17 @@ SendBuffer& SendBuffer::operator=(SendBuffer&& other) noexcept
 
 eSendBufferError SendBuffer::Open()
 {
-    if (mIsOpen || !mRingBuffer || mRingBuffer->BufSize() == 0) {
+    if (mIsOpen) {
+        return SendBuf_InternalError;
+    }
+
+    if (mSegments) {
+        mSegments->Clear();
+        mIsOpen = true;
+        return SendBuf_Ok;
+    }
+
+    if (!mRingBuffer || mRingBuffer->BufSize() == 0) {
         return SendBuf_InternalError;
     }
 
@@ -45,6 +58,11 @@ eSendBufferError SendBuffer::Reset()
     if (!mIsOpen) {
         return SendBuf_NotOpen;
     }
+
+    if (mSegments) {
+        mSegments->Clear();
+        return SendBuf_Ok;
+    }
     if (!mRingBuffer) {
         return SendBuf_InternalError;
     }
@@ -55,12 +73,12 @@ eSendBufferError SendBuffer::Reset()
 
 void SendBuffer::Close()
 {
-    if (!mRingBuffer) {
-        mIsOpen = false;
-        return;
+    if (mSegments) {
+        mSegments->Clear();
+    }
+    if (mRingBuffer) {
+        mRingBuffer->Reset();
     }
-
-    mRingBuffer->Reset();
     mIsOpen = false;
 }
 
@@ -71,19 +89,18 @@ eSendBufferError SendBuffer::Write(const void* src, size_t len, size_t& outWrite
     if (!mIsOpen) {
         return SendBuf_NotOpen;
     }
-    if (!mRingBuffer) {
+    if (!mRingBuffer && !mSegments) {
         return SendBuf_InternalError;
     }
     if (src == nullptr || len == 0) {
         return SendBuf_InvalidArgs;
     }
 
-    const size_t freeSpace = mRingBuffer->FreeSpace();
-    if (len > freeSpace) {
+    if (len > FreeSpace()) {
         return SendBuf_Overflow;
     }
 
-    outWrite = mRingBuffer->Write(src, len);
+    outWrite = mSegments ? mSegments->Write(src, len) : mRingBuffer->Write(src, len);
     if (outWrite != len) {
         return SendBuf_InternalError;
     }
@@ -91,6 +108,54 @@ eSendBufferError SendBuffer::Write(const void* src, size_t len, size_t& outWrite
     return SendBuf_Ok;
 }
 
+eSendBufferError SendBuffer::WriteShared(SharedBuffer buffer, const void* prefix, size_t prefixLen)
+{
+    if (!mIsOpen) {
+        return SendBuf_NotOpen;
+    }
+    if (!mRingBuffer && !mSegments) {
+        return SendBuf_InternalError;
+    }
+    if (!buffer || (prefix == nullptr && prefixLen != 0) || prefixLen > SendSegment::kMaxPrefix) {
+        return SendBuf_InvalidArgs;
+    }
+
+    const size_t total = prefixLen + buffer->size();
+    if (total == 0) {
+        return SendBuf_InvalidArgs;
+    }
+    if (total > FreeSpace()) {
+        return SendBuf_Overflow;
+    }
+
+    if (mSegments) {
+        return mSegments->AppendShared(std::move(buffer), prefix, prefixLen) ? SendBuf_Ok : SendBuf_InternalError;
+    }
+
+    size_t written = 0;
+    if (prefixLen > 0) {
+        written += mRingBuffer->Write(prefix, prefixLen);
+    }
+    if (!buffer->empty()) {
+        written += mRingBuffer->Write(buffer->data(), buffer->size());
+    }
+    return (written == total) ? SendBuf_Ok : SendBuf_InternalError;
+}
+
+eSendBufferError SendBuffer::PeekSharedHead(SharedBuffer& outBuffer, size_t& outPrefixRemain, size_t& outBodyOffset) const
+{
+    outPrefixRemain = 0;
+    outBodyOffset   = 0;
+
+    if (!mIsOpen) {
+        return SendBuf_NotOpen;
+    }
+    if (!mSegments || !mSegments->PeekSharedHead(outBuffer, outPrefixRemain, outBodyOffset)) {
+        return SendBuf_Underflow;
+    }
+    return SendBuf_Ok;
+}
+
 eSendBufferError SendBuffer::Read(void* dst, size_t len, size_t& outRead)
 {
     outRead = 0;
@@ -98,19 +163,18 @@ eSendBufferError SendBuffer::Read(void* dst, size_t len, size_t& outRead)
     if (!mIsOpen) {
         return SendBuf_NotOpen;
     }
-    if (!mRingBuffer) {
+    if (!mRingBuffer && !mSegments) {
         return SendBuf_InternalError;
     }
     if (dst == nullptr || len == 0) {
         return SendBuf_InvalidArgs;
     }
 
-    const size_t available = mRingBuffer->DataSpace();
-    if (available == 0) {
+    if (WriteSpace() == 0) {
         return SendBuf_Underflow;
     }
 
-    outRead = mRingBuffer->Read(dst, len);
+    outRead = mSegments ? mSegments->Read(dst, len) : mRingBuffer->Read(dst, len);
     return SendBuf_Ok;
 }
 
@@ -121,19 +185,18 @@ eSendBufferError SendBuffer::Peek(void* dst, size_t len, size_t& outPeek)
     if (!mIsOpen) {
         return SendBuf_NotOpen;
     }
-    if (!mRingBuffer) {
+    if (!mRingBuffer && !mSegments) {
         return SendBuf_InternalError;
     }
     if (dst == nullptr || len == 0) {
         return SendBuf_InvalidArgs;
     }
 
-    const size_t available = mRingBuffer->DataSpace();
-    if (available == 0) {
+    if (WriteSpace() == 0) {
         return SendBuf_Underflow;
     }
 
-    outPeek = mRingBuffer->Peek(dst, len);
+    outPeek = mSegments ? mSegments->Peek(dst, len) : mRingBuffer->Peek(dst, len);
     return SendBuf_Ok;
 }
 
@@ -142,21 +205,112 @@ eSendBufferError SendBuffer::Consume(size_t len)
     if (!mIsOpen) {
         return SendBuf_NotOpen;
     }
-    if (!mRingBuffer) {
+    if (!mRingBuffer && !mSegments) {
         return SendBuf_InternalError;
     }
 
-    const size_t available = mRingBuffer->DataSpace();
-    if (len > available) {
+    if (len > WriteSpace()) {
         return SendBuf_Underflow;
     }
 
-    mRingBuffer->Consume(len);
+    if (mSegments) {
+        mSegments->Consume(len);
+    } else {
+        mRingBuffer->Consume(len);
+    }
+    return SendBuf_Ok;
+}
+
+eSendBufferError SendBuffer::PeekContiguous(const std::uint8_t*& outData, size_t& outLen) const
+{
+    outData = nullptr;
+    outLen  = 0;
+
+    if (!mIsOpen) {
+        return SendBuf_NotOpen;
+    }
+    if (!mRingBuffer && !mSegments) {
+        return SendBuf_InternalError;
+    }
+    if (IsEmpty()) {
+        return SendBuf_Underflow;
+    }
+
+    if (mSegments) {
+        struct iovec span;
+        if (mSegments->GetReadableSpans(&span, 1) == 1) {
+            outData = static_cast<const std::uint8_t*>(span.iov_base);
+            outLen  = span.iov_len;
+        }
+        return SendBuf_Ok;
+    }
+
+    outData = mRingBuffer->ReadRegion(outLen);
+    return SendBuf_Ok;
+}
+
+eSendBufferError SendBuffer::GetReadableSpans(struct iovec* outSpans, int maxSpans, int& outCount) const
+{
+    outCount = 0;
+
+    if (!mIsOpen) {
+        return SendBuf_NotOpen;
+    }
+    if (!mRingBuffer && !mSegments) {
+        return SendBuf_InternalError;
+    }
+    if (outSpans == nullptr || maxSpans <= 0) {
+        return SendBuf_InvalidArgs;
+    }
+
+    outCount = mSegments ? mSegments->GetReadableSpans(outSpans, maxSpans)
+                         : mRingBuffer->GetReadableSpans(outSpans, maxSpans);
+    return SendBuf_Ok;
+}
+
+eSendBufferError SendBuffer::GetWritableSpans(struct iovec* outSpans, int maxSpans, int& outCount)
+{
+    outCount = 0;
+
+    if (!mIsOpen) {
+        return SendBuf_NotOpen;
+    }
+    if (!mRingBuffer && !mSegments) {
+        return SendBuf_InternalError;
+    }
+    if (outSpans == nullptr || maxSpans <= 0) {
+        return SendBuf_InvalidArgs;
+    }
+
+    outCount = mSegments ? mSegments->GetWritableSpans(outSpans, maxSpans)
+                         : mRingBuffer->GetWritableSpans(outSpans, maxSpans);
+    return SendBuf_Ok;
+}
+
+eSendBufferError SendBuffer::CommitWrite(size_t len)
+{
+    if (!mIsOpen) {
+        return SendBuf_NotOpen;
+    }
+    if (!mRingBuffer && !mSegments) {
+        return SendBuf_InternalError;
+    }
+    if (len > FreeSpace()) {
+        return SendBuf_Overflow;
+    }
+
+    const size_t committed = mSegments ? mSegments->CommitWrite(len) : mRingBuffer->CommitWrite(len);
+    if (committed != len) {
+        return SendBuf_Overflow;
+    }
     return SendBuf_Ok;
 }
 
 size_t SendBuffer::BufSize() const noexcept
 {
+    if (mSegments) {
+        return mSegments->MaxBytes();
+    }
     if (!mRingBuffer) {
         return 0;
     }
@@ -165,7 +319,13 @@ size_t SendBuffer::BufSize() const noexcept
 
 size_t SendBuffer::WriteSpace() const noexcept
 {
-    if (!mIsOpen || !mRingBuffer) {
+    if (!mIsOpen) {
+        return 0;
+    }
+    if (mSegments) {
+        return mSegments->DataSpace();
+    }
+    if (!mRingBuffer) {
         return 0;
     }
     return mRingBuffer->DataSpace();
@@ -173,7 +333,13 @@ size_t SendBuffer::WriteSpace() const noexcept
 
 size_t SendBuffer::FreeSpace() const noexcept
 {
-    if (!mIsOpen || !mRingBuffer) {
+    if (!mIsOpen) {
+        return 0;
+    }
+    if (mSegments) {
+        return mSegments->FreeSpace();
+    }
+    if (!mRingBuffer) {
         return 0;
     }
     return mRingBuffer->FreeSpace();
@@ -186,7 +352,13 @@ bool SendBuffer::IsOpen() const
 
 bool SendBuffer::IsEmpty() const
 {
-    if (!mIsOpen || !mRingBuffer) {
+    if (!mIsOpen) {
+        return true;
+    }
+    if (mSegments) {
+        return mSegments->IsEmpty();
+    }
+    if (!mRingBuffer) {
         return true;
     }
     return mRingBuffer->IsEmpty();
@@ -194,8 +366,46 @@ bool SendBuffer::IsEmpty() const
 
 bool SendBuffer::IsFull() const
 {
-    if (!mIsOpen || !mRingBuffer) {
+    if (!mIsOpen) {
+        return false;
+    }
+    if (mSegments) {
+        return mSegments->IsFull();
+    }
+    if (!mRingBuffer) {
         return false;
     }
     return mRingBuffer->IsFull();
 }
+
+bool SendBuffer::IsMirrored() const
+{
+    if (!mRingBuffer) {
+        return false;
+    }
+    return mRingBuffer->IsMirrored();
+}
+
+void SendBuffer::SetLazyStorage(bool lazy) noexcept
+{
+    if (mRingBuffer) {
+        mRingBuffer->SetLazy(lazy);
+    }
+}
+
+void SendBuffer::ReleaseIdleStorage() noexcept
+{
+    if (mRingBuffer) {
+        mRingBuffer->ReleaseIfEmpty();
+    }
+}
+
+bool SendBuffer::HasStorage() const noexcept
+{
+    return mRingBuffer && mRingBuffer->HasStorage();
+}
+
+eSendBufferMode SendBuffer::Mode() const noexcept
+{
+    return mSegments ? SendBufMode_Segmented : SendBufMode_Ring;
+}
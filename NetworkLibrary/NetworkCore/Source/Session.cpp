@@ -1,9 +1,11 @@
 #include "Session.h"
 #include "MessageFramer.h"
+#include <algorithm>
 #include <chrono>
+#include <cstring>
 
-Session::Session(size_t recvBufSize, size_t sendBufSize, Socket &&socket)
-    : mSocket(std::move(socket)), mRecvBuffer(recvBufSize), mSendBuffer(sendBufSize), mState(SessionState_Closed), mLastActive(std::chrono::steady_clock::now())
+Session::Session(size_t recvBufSize, size_t sendBufSize, Socket &&socket, eRingBufferMode bufferMode, eSendBufferMode sendMode)
+    : mSocket(std::move(socket)), mRecvBuffer(recvBufSize, bufferMode), mSendBuffer(sendBufSize, bufferMode, sendMode), mState(SessionState_Closed), mLastActive(std::chrono::steady_clock::now())
 {
 }
 Session::~Session()
@@ -12,12 +14,16 @@ Session::~Session()
 }
 
 Session::Session(Session &&other) noexcept
-    : mSocket(std::move(other.mSocket)), mRecvBuffer(std::move(other.mRecvBuffer)), mSendBuffer(std::move(other.mSendBuffer)), mState(other.mState), mRecvCallback(std::move(other.mRecvCallback)), mSendCallback(std::move(other.mSendCallback)), mCloseCallback(std::move(other.mCloseCallback)), mLastActive(other.mLastActive)
+    : mSocket(std::move(other.mSocket)), mRecvBuffer(std::move(other.mRecvBuffer)), mSendBuffer(std::move(other.mSendBuffer)), mState(other.mState), mRecvCallback(std::move(other.mRecvCallback)), mSendCallback(std::move(other.mSendCallback)), mCloseCallback(std::move(other.mCloseCallback)), mFrameCallback(std::move(other.mFrameCallback)), mWriteInterestCallback(std::move(other.mWriteInterestCallback)), mWatermarkCallback(std::move(other.mWatermarkCallback)), mMaxSendBatch(other.mMaxSendBatch), mIoBudget(other.mIoBudget), mReadRetry(other.mReadRetry), mWriteRetry(other.mWriteRetry), mSendInFlight(other.mSendInFlight), mSendLowWatermark(other.mSendLowWatermark), mSendHighWatermark(other.mSendHighWatermark), mSendPaused(other.mSendPaused), mZeroCopyThreshold(other.mZeroCopyThreshold), mZeroCopySeq(other.mZeroCopySeq), mZeroCopyPending(std::move(other.mZeroCopyPending)), mLastActive(other.mLastActive)
 {
     other.mState = SessionState_Closed;
+    other.mSendInFlight = 0;
     other.mSendCallback = nullptr;
     other.mRecvCallback = nullptr;
     other.mCloseCallback = nullptr;
+    other.mFrameCallback = nullptr;
+    other.mWriteInterestCallback = nullptr;
+    other.mWatermarkCallback = nullptr;
 }
 Session &Session::operator=(Session &&other) noexcept
 {
@@ -30,12 +36,30 @@ Session &Session::operator=(Session &&other) noexcept
         mRecvCallback = std::move(other.mRecvCallback);
         mSendCallback = std::move(other.mSendCallback);
         mCloseCallback = std::move(other.mCloseCallback);
+        mFrameCallback = std::move(other.mFrameCallback);
+        mWriteInterestCallback = std::move(other.mWriteInterestCallback);
+        mWatermarkCallback = std::move(other.mWatermarkCallback);
+        mMaxSendBatch = other.mMaxSendBatch;
+        mIoBudget = other.mIoBudget;
+        mReadRetry = other.mReadRetry;
+        mWriteRetry = other.mWriteRetry;
+        mSendInFlight = other.mSendInFlight;
+        mSendLowWatermark = other.mSendLowWatermark;
+        mSendHighWatermark = other.mSendHighWatermark;
+        mSendPaused = other.mSendPaused;
+        mZeroCopyThreshold = other.mZeroCopyThreshold;
+        mZeroCopySeq = other.mZeroCopySeq;
+        mZeroCopyPending = std::move(other.mZeroCopyPending);
         mLastActive = other.mLastActive;
 
         other.mState = SessionState_Closed;
+        other.mSendInFlight = 0;
         other.mSendCallback = nullptr;
         other.mRecvCallback = nullptr;
         other.mCloseCallback = nullptr;
+        other.mFrameCallback = nullptr;
+        other.mWriteInterestCallback = nullptr;
+        other.mWatermarkCallback = nullptr;
     }
     return *this;
 }
@@ -44,6 +68,8 @@ eSessionError Session::Open(size_t recvBufSize, size_t sendBufSize)
 {
     if (mState == SessionState_Open || mState == SessionState_Opening)
         return Session_AlreadyOpen;
+    if (mSendInFlight != 0)
+        return Session_InternalError;
 
     mState = SessionState_Opening;
 
@@ -83,15 +109,53 @@ void Session::Close()
 
     mState = SessionState_Closing;
 
+    // 커널이 아직 zerocopy buffer 로 보내고 있을 수 있음: 통지를 받을 socket 과 함께 넘긴다
+    if (!mZeroCopyPending.empty())
+    {
+        ZeroCopyLinger::Local().Adopt(std::move(mSocket), std::move(mZeroCopyPending));
+        mZeroCopyPending.clear();
+    }
     mSocket.Close();
     mRecvBuffer.Close();
-    mSendBuffer.Close();
+    // 커널이 아직 읽고 있는 송신 구간이 있으면 마지막 CompleteSend 때 닫는다
+    if (mSendInFlight == 0)
+        mSendBuffer.Close();
+    mSendPaused = false;
+    mReadRetry = false;
+    mWriteRetry = false;
 
     mState = SessionState_Closed;
 
     InvokeCloseCallback();
 }
 
+eSessionError Session::Reattach(Socket &&socket)
+{
+    if (mState != SessionState_Closed)
+        return Session_AlreadyOpen;
+    if (mSendInFlight != 0)
+        return Session_InternalError;
+
+    mSocket = std::move(socket);
+
+    mRecvCallback = nullptr;
+    mSendCallback = nullptr;
+    mCloseCallback = nullptr;
+    mFrameCallback = nullptr;
+    mWriteInterestCallback = nullptr;
+    mWatermarkCallback = nullptr;
+
+    mMaxSendBatch = kDefaultMaxSendBatch;
+    mIoBudget = 0;
+    mSendLowWatermark = 0;
+    mSendHighWatermark = 0;
+    // zerocopy 는 소켓 옵션이므로 새 소켓마다 EnableZeroCopy 를 다시 해야 함
+    mZeroCopyThreshold = 0;
+    mZeroCopySeq = 0;
+    mLastActive = std::chrono::steady_clock::now();
+    return Session_Ok;
+}
+
 bool Session::IsOpen() const
 {
     return mState == SessionState_Open && mSocket.IsOpen();
@@ -104,9 +168,17 @@ eSessionError Session::PollRecv()
         return Session_NotOpen;
     }
 
-    std::uint8_t tmpBuf[4096];
+    struct iovec spans[2];
+    int spanCount = 0;
+    eRecvBufferError rbErr = mRecvBuffer.GetWritableSpans(spans, 2, spanCount);
+    if (rbErr != RecvBuf_Ok || spanCount == 0)
+    {
+        Close();
+        return Session_RecvBufferError;
+    }
+
     size_t received = 0;
-    eSocketError err = mSocket.Recv(tmpBuf, sizeof(tmpBuf), received);
+    eSocketError err = mSocket.Readv(spans, spanCount, received);
     if (err != Socket_Ok)
     {
         Close();
@@ -119,9 +191,7 @@ eSessionError Session::PollRecv()
         return Session_PeerClosed;
     }
 
-    size_t written = 0;
-    eRecvBufferError rbErr = mRecvBuffer.Write(tmpBuf, received, written);
-    if (rbErr != RecvBuf_Ok || written != received)
+    if (mRecvBuffer.CommitWrite(received) != RecvBuf_Ok)
     {
         Close();
         return Session_RecvBufferError;
@@ -144,39 +214,8 @@ eSessionError Session::FlushSend()
         return Session_SendBufferError;
     }
 
-    if (mSendBuffer.IsEmpty())
-    {
-        return Session_Ok;
-    }
-
-    std::uint8_t tmpBuf[4096];
-    while (!mSendBuffer.IsEmpty())
-    {
-        size_t toSend = 0;
-        eSendBufferError sbErr = mSendBuffer.Read(tmpBuf, sizeof(tmpBuf), toSend);
-
-        if (sbErr != SendBuf_Ok || toSend == 0)
-        {
-            break;
-        }
-        if (sbErr != SendBuf_Ok)
-        {
-            return Session_SendBufferError;
-        }
-
-        size_t sent = 0;
-        eSocketError sErr = mSocket.Send(tmpBuf, toSend, sent);
-        if (sErr != Socket_Ok)
-        {
-            Close();
-            return Session_SocketError;
-        }
-
-        InvokeSendCallback(sent);
-    }
-
-    mLastActive = std::chrono::steady_clock::now();
-    return Session_Ok;
+    // 커널이 받아간 만큼만 consume, 나머지는 EPOLLOUT 에서 이어서 전송
+    return DrainSendBuffer();
 }
 eSessionError Session::QueueSend(const void *data, size_t len)
 {
@@ -191,17 +230,72 @@ eSessionError Session::QueueSend(const void *data, size_t len)
     eSendBufferError sbErr = mSendBuffer.Write(data, len, written);
     if (sbErr != SendBuf_Ok || written != len) return Session_SendBufferError;
     if (wasEmpty) InvokeWriteInterest(true);
+    UpdateSendWatermark();
 
     mLastActive = std::chrono::steady_clock::now();
     return Session_Ok;
 }
 
 eSessionError Session::SendFrame(const void* payload, std::size_t len){
-    std::vector<std::uint8_t> encoded;
-    const eFrameError fr = MessageFramer::Encode(payload, len, encoded);
+    if (!IsOpen())              return Session_NotOpen;
+    if (!mSendBuffer.IsOpen())  return Session_SendBufferError;
+    if (payload == nullptr && len != 0) return Session_InvalidArgs;
+
+    std::uint8_t header[MessageFramer::kHeaderSize];
+    const eFrameError fr = MessageFramer::EncodeHeader(len, header);
     if(fr != eFrameError::Framer_Ok)    return Session_InvalidArgs;
 
-    return QueueSend(encoded.data(), encoded.size());
+    // header 와 payload 를 임시 vector 없이 바로 send buffer 에 쓴다. 반쪽 프레임이 남지 않게 공간부터 확인.
+    if (mSendBuffer.FreeSpace() < sizeof(header) + len) return Session_SendBufferError;
+
+    const bool wasEmpty = mSendBuffer.IsEmpty();
+
+    size_t written = 0;
+    if (mSendBuffer.Write(header, sizeof(header), written) != SendBuf_Ok) return Session_SendBufferError;
+    if (len > 0 && mSendBuffer.Write(payload, len, written) != SendBuf_Ok) return Session_SendBufferError;
+    if (wasEmpty) InvokeWriteInterest(true);
+    UpdateSendWatermark();
+
+    mLastActive = std::chrono::steady_clock::now();
+    return Session_Ok;
+}
+
+eSessionError Session::QueueSendShared(SharedBuffer buffer)
+{
+    if (!IsOpen())              return Session_NotOpen;
+    if (!mSendBuffer.IsOpen())  return Session_SendBufferError;
+    if (!buffer)                return Session_InvalidArgs;
+    if (buffer->empty())        return Session_Ok;
+
+    const bool wasEmpty = mSendBuffer.IsEmpty();
+
+    if (mSendBuffer.WriteShared(std::move(buffer)) != SendBuf_Ok) return Session_SendBufferError;
+    if (wasEmpty) InvokeWriteInterest(true);
+    UpdateSendWatermark();
+
+    mLastActive = std::chrono::steady_clock::now();
+    return Session_Ok;
+}
+
+eSessionError Session::SendFrameShared(SharedBuffer payload)
+{
+    if (!IsOpen())              return Session_NotOpen;
+    if (!mSendBuffer.IsOpen())  return Session_SendBufferError;
+    if (!payload)               return Session_InvalidArgs;
+
+    std::uint8_t header[MessageFramer::kHeaderSize];
+    const eFrameError fr = MessageFramer::EncodeHeader(payload->size(), header);
+    if(fr != eFrameError::Framer_Ok)    return Session_InvalidArgs;
+
+    const bool wasEmpty = mSendBuffer.IsEmpty();
+
+    // frame header 는 segment 의 inline prefix 로 들어가고 payload 는 참조만 유지
+    if (mSendBuffer.WriteShared(std::move(payload), header, sizeof(header)) != SendBuf_Ok) return Session_SendBufferError;
+    if (wasEmpty) InvokeWriteInterest(true);
+    UpdateSendWatermark();
+
+    mLastActive = std::chrono::steady_clock::now();
+    return Session_Ok;
 }
 
 eSessionError Session::OnReadable()
@@ -211,11 +305,44 @@ eSessionError Session::OnReadable()
         return Session_NotOpen;
     }
 
-    std::uint8_t tmpBuf[4096];
+    mReadRetry = false;
+    // budget 이 없으면 기존처럼 ring 한 바퀴 분량까지만 읽는다
+    const size_t budget = mIoBudget ? mIoBudget : mRecvBuffer.BufSize();
+    size_t total = 0;
+
+    // ring 의 빈 구간 전체로 바로 readv (중간 stack 버퍼 없음)
     for (;;)
     {
+        struct iovec spans[2];
+        int spanCount = 0;
+        eRecvBufferError rbErr = mRecvBuffer.GetWritableSpans(spans, 2, spanCount);
+        if (rbErr != RecvBuf_Ok)
+        {
+            Close();
+            return Session_RecvBufferError;
+        }
+        if (spanCount == 0)
+        {
+            // ring 이 가득 참: budget 이 남았으면 콜백으로 비운 뒤 이어서 읽음.
+            // 콜백이 없으면 호출자가 비운 뒤 다시 불러야 함
+            if (total >= budget || mSendPaused || !HasRecvCallback())
+            {
+                mReadRetry = true;
+                break;
+            }
+            eSessionError d = DispatchRecv();
+            if (d != Session_Ok || !IsOpen())   return d;
+            continue;
+        }
+
+        size_t capacity = 0;
+        for (int i = 0; i < spanCount; ++i)
+        {
+            capacity += spans[i].iov_len;
+        }
+
         size_t received = 0;
-        eSocketError err = mSocket.Recv(tmpBuf, sizeof(tmpBuf), received);
+        eSocketError err = mSocket.Readv(spans, spanCount, received);
         if (err == Socket_WouldBlock)
         {
             break;
@@ -232,19 +359,52 @@ eSessionError Session::OnReadable()
             return Session_PeerClosed;
         }
 
-        size_t written = 0;
-        eRecvBufferError rbErr = mRecvBuffer.Write(tmpBuf, received, written);
-        if (rbErr != RecvBuf_Ok || written != received)
+        if (mRecvBuffer.CommitWrite(received) != RecvBuf_Ok)
         {
             Close();
             return Session_RecvBufferError;
         }
         mLastActive = std::chrono::steady_clock::now();
+
+        // short read 면 socket 이 비었으므로 EAGAIN 확인용 syscall 을 생략
+        if (received < capacity)
+        {
+            break;
+        }
+
+        total += received;
+        if (total >= budget)
+        {
+            mReadRetry = true;
+            break;
+        }
     }
 
+    eSessionError r = DispatchRecv();
+    // 콜백이 다 소비했으면 (또는 EAGAIN 만 받았으면) 다음 데이터까지 ring 을 반납
+    mRecvBuffer.ReleaseIdleStorage();
+    return r;
+}
+
+eSessionError Session::ResumeRecv()
+{
+    if (!IsOpen())              return Session_NotOpen;
+    if (mSendPaused)            return Session_Ok;
+    if (mRecvBuffer.IsEmpty())  return Session_Ok;
+
+    return DispatchRecv();
+}
+
+eSessionError Session::DispatchRecv()
+{
+    // 호출자가 RecvBuf 를 직접 소비하는 경우 (서버의 protocol handler)
+    if (!HasRecvCallback())
+        return Session_Ok;
+
     if(mFrameCallback){
         Frame f;
-        while(true){
+        // 송신 큐가 high watermark 를 넘으면 더 이상 요청을 처리하지 않고 recv buffer 에 남겨 둠
+        while(!mSendPaused && IsOpen()){
             const eFrameError r = MessageFramer::PopFrame(mRecvBuffer, f);
 
             if(r == eFrameError::Framer_Ok){
@@ -257,31 +417,90 @@ eSessionError Session::OnReadable()
             Close();
             return Session_RecvBufferError;
         }
-
-        return Session_Ok;
+    }
+    else
+    {
+        InvokeRecvCallback();
     }
 
-
-    InvokeRecvCallback();
+    // 소비 후에도 ring 이 가득 차 있으면 더 읽을 수 없음 (ring 보다 큰 프레임 등)
+    // paused 상태는 읽기 자체를 멈추므로 예외
+    if (mRecvBuffer.IsFull() && !mSendPaused)
+    {
+        Close();
+        return Session_RecvBufferError;
+    }
     return Session_Ok;
 }
 eSessionError Session::OnWritable()
 {
     if (!IsOpen())              return Session_NotOpen;
     if (!mSendBuffer.IsOpen())  return Session_SendBufferError;
+
+    return DrainSendBuffer();
+}
+
+eSessionError Session::DrainSendBuffer()
+{
+    mWriteRetry = false;
     if (mSendBuffer.IsEmpty())  return Session_Ok;
 
-    std::uint8_t tmpBuf[4096];
-    for (;;)
+    bool zeroCopyBlocked = false;
+    size_t total = 0;
+    while (!mSendBuffer.IsEmpty())
     {
-        if (mSendBuffer.IsEmpty())  break;
-        size_t peeked = 0;
-        eSendBufferError sbErr = mSendBuffer.Peek(tmpBuf, sizeof(tmpBuf), peeked);
-        if (sbErr != SendBuf_Ok)    return Session_SendBufferError;
-        if (peeked == 0)            break;
+        if (mIoBudget != 0 && total >= mIoBudget)
+        {
+            // 아직 커널 버퍼에 여유가 있을 수 있으므로 호출자가 다시 불러줘야 함
+            mWriteRetry = true;
+            break;
+        }
+
+        struct iovec spans[kMaxSendSpans];
+        int spanCount = 0;
+        size_t batch = 0;
+        int flags = 0;
+        SharedBuffer pinned;
+
+        if (mZeroCopyThreshold != 0 && !zeroCopyBlocked && PrepareZeroCopySpan(spans[0], pinned))
+        {
+            spanCount = 1;
+            batch = spans[0].iov_len;
+            flags = MSG_ZEROCOPY;
+        }
+        else
+        {
+            eSendBufferError sbErr = mSendBuffer.GetReadableSpans(spans, kMaxSendSpans, spanCount);
+            if (sbErr != SendBuf_Ok)    return Session_SendBufferError;
+            if (spanCount == 0)         break;
+
+            // 한 번의 syscall 이 mMaxSendBatch 를 넘지 않도록 span 을 자름
+            for (int i = 0; i < spanCount; ++i)
+            {
+                // zerocopy 대상이 될 큰 body 는 다음 번에 따로 보냄
+                if (i > 0 && mZeroCopyThreshold != 0 && !zeroCopyBlocked && spans[i].iov_len >= mZeroCopyThreshold)
+                {
+                    spanCount = i;
+                    break;
+                }
+                if (batch + spans[i].iov_len >= mMaxSendBatch)
+                {
+                    spans[i].iov_len = mMaxSendBatch - batch;
+                    batch = mMaxSendBatch;
+                    spanCount = i + 1;
+                    break;
+                }
+                batch += spans[i].iov_len;
+            }
+        }
 
         size_t sent = 0;
-        eSocketError sErr = mSocket.Send(tmpBuf, peeked, sent);
+        eSocketError sErr = mSocket.SendMsg(spans, spanCount, flags, sent);
+        if (sErr == Socket_NoBuffers)
+        {
+            zeroCopyBlocked = true;
+            continue;
+        }
         if (sErr == Socket_WouldBlock)  break;
         if (sErr != Socket_Ok) {
             Close();
@@ -290,22 +509,224 @@ eSessionError Session::OnWritable()
 
         if (sent > 0)
         {
+            total += sent;
+            // 성공한 MSG_ZEROCOPY 호출마다 커널이 순번을 하나씩 매김
+            if (pinned) mZeroCopyPending.push_back(ZeroCopyPin{mZeroCopySeq++, std::move(pinned), false});
+
             eSendBufferError cErr = mSendBuffer.Consume(sent);
             if (cErr != SendBuf_Ok)
             {
                 Close();
                 return Session_SendBufferError;
             }
+            UpdateSendWatermark();
+            if (!IsOpen())  return Session_Ok;
 
-            InvokeSendCallback(sent);
             mLastActive = std::chrono::steady_clock::now();
+            InvokeSendCallback(sent);
+            if (!IsOpen())  return Session_Ok;
         }
+
+        // 커널 송신 버퍼가 찼으면 EAGAIN 을 기다리지 않고 다음 EPOLLOUT 으로 넘김
+        if (sent < batch)   break;
     }
 
     if(mSendBuffer.IsEmpty())   InvokeWriteInterest(false);
     return Session_Ok;
 }
 
+eSessionError Session::DeliverRecv(const void *data, size_t len, size_t &outAccepted)
+{
+    outAccepted = 0;
+    if (!IsOpen())                  return Session_NotOpen;
+    if (data == nullptr && len != 0) return Session_InvalidArgs;
+
+    const auto *src = static_cast<const std::uint8_t *>(data);
+    bool drained = false;
+    while (outAccepted < len)
+    {
+        // OnReadable 과 같이 ring 의 빈 구간으로 바로 복사
+        struct iovec spans[2];
+        int spanCount = 0;
+        if (mRecvBuffer.GetWritableSpans(spans, 2, spanCount) != RecvBuf_Ok)
+        {
+            Close();
+            return Session_RecvBufferError;
+        }
+        if (spanCount == 0)
+        {
+            // ring 이 가득 참: 콜백으로 비운 뒤 이어서 넣음. 비워지지 않거나 멈췄으면 나머지는 호출자가 보관
+            if (mSendPaused || drained)
+                break;
+            eSessionError d = DispatchRecv();
+            if (d != Session_Ok || !IsOpen())   return d;
+            drained = true;
+            continue;
+        }
+
+        size_t copied = 0;
+        for (int i = 0; i < spanCount && outAccepted + copied < len; ++i)
+        {
+            const size_t n = std::min(spans[i].iov_len, len - outAccepted - copied);
+            std::memcpy(spans[i].iov_base, src + outAccepted + copied, n);
+            copied += n;
+        }
+        if (mRecvBuffer.CommitWrite(copied) != RecvBuf_Ok)
+        {
+            Close();
+            return Session_RecvBufferError;
+        }
+        outAccepted += copied;
+        drained = false;
+        mLastActive = std::chrono::steady_clock::now();
+    }
+
+    eSessionError r = DispatchRecv();
+    mRecvBuffer.ReleaseIdleStorage();
+    return r;
+}
+
+int Session::PrepareSend(struct iovec *outSpans, int maxSpans, size_t &outBytes)
+{
+    outBytes = 0;
+    if (!IsOpen() || mSendInFlight != 0 || !outSpans || maxSpans <= 0)
+        return 0;
+
+    int spanCount = 0;
+    if (mSendBuffer.GetReadableSpans(outSpans, maxSpans, spanCount) != SendBuf_Ok)
+        return 0;
+
+    size_t batch = 0;
+    for (int i = 0; i < spanCount; ++i)
+    {
+        if (batch + outSpans[i].iov_len >= mMaxSendBatch)
+        {
+            outSpans[i].iov_len = mMaxSendBatch - batch;
+            batch = mMaxSendBatch;
+            spanCount = i + 1;
+            break;
+        }
+        batch += outSpans[i].iov_len;
+    }
+
+    mSendInFlight = batch;
+    outBytes = batch;
+    return spanCount;
+}
+
+eSessionError Session::CompleteSend(size_t attempted, size_t sent)
+{
+    if (attempted > mSendInFlight)
+        attempted = mSendInFlight;
+    mSendInFlight -= attempted;
+
+    if (!IsOpen())
+    {
+        // Close 가 미뤄 둔 송신 buffer 정리
+        if (mState == SessionState_Closed && mSendInFlight == 0)
+            mSendBuffer.Close();
+        return Session_NotOpen;
+    }
+
+    if (sent > attempted)
+        sent = attempted;
+    if (sent > 0)
+    {
+        if (mSendBuffer.Consume(sent) != SendBuf_Ok)
+        {
+            Close();
+            return Session_SendBufferError;
+        }
+        UpdateSendWatermark();
+        if (!IsOpen())  return Session_Ok;
+
+        mLastActive = std::chrono::steady_clock::now();
+        InvokeSendCallback(sent);
+        if (!IsOpen())  return Session_Ok;
+    }
+
+    if (mSendInFlight == 0 && mSendBuffer.IsEmpty())
+        InvokeWriteInterest(false);
+    return Session_Ok;
+}
+
+bool Session::IsSendInFlight() const noexcept
+{
+    return mSendInFlight != 0;
+}
+
+bool Session::PrepareZeroCopySpan(struct iovec &outSpan, SharedBuffer &outPinned) const
+{
+    SharedBuffer head;
+    size_t prefixRemain = 0;
+    size_t bodyOffset = 0;
+    if (mSendBuffer.PeekSharedHead(head, prefixRemain, bodyOffset) != SendBuf_Ok) return false;
+    // prefix(frame header 등)는 segment 와 함께 재사용되는 메모리라 복사 경로로 먼저 보냄
+    if (prefixRemain != 0)  return false;
+
+    const size_t remain = head->size() - bodyOffset;
+    if (remain < mZeroCopyThreshold)   return false;
+
+    outSpan.iov_base = const_cast<std::uint8_t *>(head->data() + bodyOffset);
+    outSpan.iov_len  = (remain < mMaxSendBatch) ? remain : mMaxSendBatch;
+    outPinned = std::move(head);
+    return true;
+}
+
+eSessionError Session::OnError()
+{
+    if (!IsOpen())
+    {
+        return Session_NotOpen;
+    }
+
+    if (mZeroCopyThreshold != 0)
+    {
+        for (;;)
+        {
+            ZeroCopyCompletion completion;
+            eSocketError err = mSocket.ReadZeroCopyCompletion(completion);
+            if (err == Socket_WouldBlock)   break;
+            if (err != Socket_Ok)
+            {
+                Close();
+                return Session_SocketError;
+            }
+            CompleteZeroCopyPins(mZeroCopyPending, completion);
+        }
+    }
+
+    int soError = 0;
+    if (mSocket.GetPendingError(soError) != Socket_Ok || soError != 0)
+    {
+        Close();
+        return Session_SocketError;
+    }
+    return Session_Ok;
+}
+
+eSessionError Session::EnableZeroCopy(size_t threshold)
+{
+    if (!IsOpen())                                          return Session_NotOpen;
+    if (threshold == 0)                                     return Session_InvalidArgs;
+    // ring 은 보내자마자 덮어쓰이므로 완료 통지까지 메모리를 붙잡아 둘 수 없음
+    if (mSendBuffer.Mode() != SendBufMode_Segmented)        return Session_InvalidArgs;
+    if (mZeroCopyThreshold == 0 && mSocket.EnableZeroCopy() != Socket_Ok) return Session_SocketError;
+
+    mZeroCopyThreshold = threshold;
+    return Session_Ok;
+}
+
+bool Session::IsZeroCopyEnabled() const noexcept
+{
+    return mZeroCopyThreshold != 0;
+}
+
+size_t Session::PendingZeroCopyCount() const noexcept
+{
+    return mZeroCopyPending.size();
+}
+
 void Session::SetRecvCallback(RecvCallback callback)
 {
     mRecvCallback = std::move(callback);
@@ -324,6 +745,51 @@ void Session::SetFrameCallback(FrameCallback callback){
 void Session::SetWriteInterestCallback(WriteInterestCallback callback){
     mWriteInterestCallback = std::move(callback);
 }
+void Session::SetWatermarkCallback(WatermarkCallback callback){
+    mWatermarkCallback = std::move(callback);
+}
+eSessionError Session::SetSendWatermarks(size_t low, size_t high){
+    if (high != 0 && low >= high)   return Session_InvalidArgs;
+
+    mSendLowWatermark = low;
+    mSendHighWatermark = high;
+    UpdateSendWatermark();
+    return Session_Ok;
+}
+bool Session::IsSendPaused() const noexcept{
+    return mSendPaused;
+}
+void Session::UpdateSendWatermark(){
+    const size_t queued = mSendBuffer.WriteSpace();
+    bool paused = mSendPaused;
+    if (mSendHighWatermark == 0)            paused = false;
+    else if (!paused && queued >= mSendHighWatermark)   paused = true;
+    else if (paused && queued <= mSendLowWatermark)     paused = false;
+
+    if (paused == mSendPaused)  return;
+
+    mSendPaused = paused;
+    if (mWatermarkCallback)
+    {
+        mWatermarkCallback(*this, paused);
+    }
+}
+void Session::SetMaxSendBatch(size_t bytes) noexcept{
+    mMaxSendBatch = bytes ? bytes : kDefaultMaxSendBatch;
+}
+void Session::SetIoBudget(size_t bytes) noexcept{
+    mIoBudget = bytes;
+}
+void Session::SetLazyBuffers(bool lazy) noexcept{
+    mRecvBuffer.SetLazyStorage(lazy);
+    mSendBuffer.SetLazyStorage(lazy);
+}
+bool Session::NeedsReadRetry() const noexcept{
+    return mReadRetry;
+}
+bool Session::NeedsWriteRetry() const noexcept{
+    return mWriteRetry;
+}
 
 int Session::Fd() const
 {
@@ -365,6 +831,11 @@ bool Session::IsIdleTimeout(std::chrono::milliseconds timeout) const noexcept{
     return (now - mLastActive) > timeout;
 }
 
+bool Session::HasRecvCallback() const noexcept
+{
+    return mRecvCallback || mFrameCallback;
+}
+
 void Session::InvokeRecvCallback()
 {
     if (mRecvCallback)
@@ -0,0 +1,88 @@
+#include "SessionPool.h"
+
+SessionPool::SessionPool(std::size_t recvBufSize, std::size_t sendBufSize,
+                         eRingBufferMode bufferMode, eSendBufferMode sendMode,
+                         std::size_t maxCached)
+    : mRecvBufSize(recvBufSize), mSendBufSize(sendBufSize), mBufferMode(bufferMode), mSendMode(sendMode), mMaxCached(maxCached)
+{
+}
+
+Session SessionPool::NewSession(Socket&& socket) const
+{
+    return Session(mRecvBufSize, mSendBufSize, std::move(socket), mBufferMode, mSendMode);
+}
+
+Session SessionPool::Acquire(Socket&& socket)
+{
+    if (mFree.empty()) {
+        ++mMisses;
+        return NewSession(std::move(socket));
+    }
+
+    Session session = std::move(mFree.back());
+    mFree.pop_back();
+
+    // 재사용할 수 없는 세션(송신이 아직 커널에 걸려 있는 등)은 버리고 새로 만든다.
+    // Reattach 는 실패하면 socket 을 건드리지 않는다.
+    if (session.Reattach(std::move(socket)) != Session_Ok) {
+        ++mMisses;
+        return NewSession(std::move(socket));
+    }
+    ++mHits;
+    return session;
+}
+
+void SessionPool::Release(Session&& session)
+{
+    session.Close();
+    if (mFree.size() >= mMaxCached) {
+        return;
+    }
+    mFree.push_back(std::move(session));
+}
+
+void SessionPool::Reserve(std::size_t count)
+{
+    if (count > mMaxCached) {
+        count = mMaxCached;
+    }
+
+    mFree.reserve(mMaxCached);
+    while (mFree.size() < count) {
+        mFree.push_back(NewSession(Socket()));
+    }
+}
+
+void SessionPool::Trim() noexcept
+{
+    mFree.clear();
+    mFree.shrink_to_fit();
+}
+
+std::size_t SessionPool::CachedCount() const noexcept
+{
+    return mFree.size();
+}
+
+std::size_t SessionPool::MaxCached() const noexcept
+{
+    return mMaxCached;
+}
+
+void SessionPool::SetMaxCached(std::size_t maxCached)
+{
+    mMaxCached = maxCached;
+    if (mFree.size() > mMaxCached) {
+        mFree.erase(mFree.begin() + static_cast<std::ptrdiff_t>(mMaxCached), mFree.end());
+    }
+}
+
+std::size_t SessionPool::Hits() const noexcept
+{
+    return mHits;
+}
+
+std::size_t SessionPool::Misses() const noexcept
+{
+    return mMisses;
+}
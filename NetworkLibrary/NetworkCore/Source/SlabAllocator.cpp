@@ -0,0 +1,305 @@
+#include "SlabAllocator.h"
+
+#include <bit>
+#include <new>
+#include <sys/mman.h>
+
+#ifndef MAP_HUGETLB
+#define MAP_HUGETLB 0x40000
+#endif
+
+SlabAllocator::~SlabAllocator()
+{
+    for (const auto& chunk : mChunks) {
+        ::munmap(chunk.first, chunk.second);
+    }
+}
+
+SlabAllocator& SlabAllocator::Global()
+{
+    static SlabAllocator* global = new SlabAllocator();
+    return *global;
+}
+
+SlabAllocator::ThreadCache::~ThreadCache()
+{
+    if (!owner) {
+        return;
+    }
+    // 스레드가 끝나면 남은 블록을 공용 free list 로
+    for (int cls = 0; cls < kClassCount; ++cls) {
+        if (!head[cls]) {
+            continue;
+        }
+        FreeNode* tail = head[cls];
+        while (tail->next) {
+            tail = tail->next;
+        }
+        owner->ReturnToCentral(cls, head[cls], tail);
+        head[cls]  = nullptr;
+        count[cls] = 0;
+    }
+}
+
+SlabAllocator::ThreadCache& SlabAllocator::LocalCache() noexcept
+{
+    thread_local ThreadCache cache;
+    return cache;
+}
+
+int SlabAllocator::ClassIndex(std::size_t size) noexcept
+{
+    if (size <= (std::size_t{1} << kMinClassBits)) {
+        return 0;
+    }
+    const int bits = std::bit_width(size - 1);
+    return (bits > kMaxClassBits) ? -1 : bits - kMinClassBits;
+}
+
+std::size_t SlabAllocator::ClassSize(std::size_t size) noexcept
+{
+    const int cls = ClassIndex(size);
+    return (cls < 0) ? size : (std::size_t{1} << (cls + kMinClassBits));
+}
+
+void SlabAllocator::AddInUse(std::ptrdiff_t delta) noexcept
+{
+    const std::size_t now = mInUse.fetch_add(static_cast<std::size_t>(delta), std::memory_order_relaxed) + static_cast<std::size_t>(delta);
+    if (delta <= 0) {
+        return;
+    }
+    std::size_t high = mHighWater.load(std::memory_order_relaxed);
+    while (now > high && !mHighWater.compare_exchange_weak(high, now, std::memory_order_relaxed)) {
+    }
+}
+
+void* SlabAllocator::Allocate(std::size_t size) noexcept
+{
+    if (size == 0) {
+        return nullptr;
+    }
+
+    const int cls = ClassIndex(size);
+    if (cls < 0) {
+        // 최대 class 보다 큰 버퍼는 드물어서 그냥 heap 에서
+        void* block = ::operator new(size, std::nothrow);
+        if (block) {
+            mDirect.fetch_add(size, std::memory_order_relaxed);
+            AddInUse(static_cast<std::ptrdiff_t>(size));
+        }
+        return block;
+    }
+
+    const std::size_t classSize = std::size_t{1} << (cls + kMinClassBits);
+    ThreadCache& cache = LocalCache();
+    if (!cache.owner && this == &Global()) {
+        cache.owner = this;
+    }
+
+    FreeNode* node = nullptr;
+    if (cache.owner == this) {
+        if (!cache.head[cls]) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            cache.count[cls] = RefillLocked(cls, cache.head[cls]);
+        }
+        node = cache.head[cls];
+        if (node) {
+            cache.head[cls] = node->next;
+            --cache.count[cls];
+        }
+    } else {
+        std::lock_guard<std::mutex> lock(mMutex);
+        node = mFree[cls];
+        if (node) {
+            mFree[cls] = node->next;
+        } else {
+            node = reinterpret_cast<FreeNode*>(CarveLocked(classSize));
+        }
+    }
+
+    if (!node) {
+        return nullptr;
+    }
+    AddInUse(static_cast<std::ptrdiff_t>(classSize));
+    return node;
+}
+
+void SlabAllocator::Free(void* block, std::size_t size) noexcept
+{
+    if (!block) {
+        return;
+    }
+
+    const int cls = ClassIndex(size);
+    if (cls < 0) {
+        ::operator delete(block);
+        mDirect.fetch_sub(size, std::memory_order_relaxed);
+        AddInUse(-static_cast<std::ptrdiff_t>(size));
+        return;
+    }
+
+    const std::size_t classSize = std::size_t{1} << (cls + kMinClassBits);
+    AddInUse(-static_cast<std::ptrdiff_t>(classSize));
+
+    FreeNode* node = static_cast<FreeNode*>(block);
+    ThreadCache& cache = LocalCache();
+    if (cache.owner != this) {
+        ReturnToCentral(cls, node, node);
+        return;
+    }
+
+    node->next = cache.head[cls];
+    cache.head[cls] = node;
+    if (++cache.count[cls] <= kThreadCacheMax) {
+        return;
+    }
+
+    // 넘친 만큼 batch 로 공용 free list 에 돌려준다
+    FreeNode* head = cache.head[cls];
+    FreeNode* tail = head;
+    for (std::uint32_t i = 1; i < kBatch; ++i) {
+        tail = tail->next;
+    }
+    cache.head[cls] = tail->next;
+    cache.count[cls] -= kBatch;
+    tail->next = nullptr;
+    ReturnToCentral(cls, head, tail);
+}
+
+void SlabAllocator::ReturnToCentral(int cls, FreeNode* head, FreeNode* tail) noexcept
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    tail->next = mFree[cls];
+    mFree[cls] = head;
+}
+
+std::uint32_t SlabAllocator::RefillLocked(int cls, FreeNode*& outHead) noexcept
+{
+    const std::size_t classSize = std::size_t{1} << (cls + kMinClassBits);
+    // 큰 class 는 한 번에 하나만 (chunk 하나를 통째로 스레드 cache 에 묶어두지 않도록)
+    const std::uint32_t want = (classSize >= kChunkSize / kBatch) ? 1 : kBatch;
+
+    std::uint32_t got = 0;
+    FreeNode* head = nullptr;
+    while (got < want) {
+        FreeNode* node = mFree[cls];
+        if (node) {
+            mFree[cls] = node->next;
+        } else {
+            node = reinterpret_cast<FreeNode*>(CarveLocked(classSize));
+            if (!node) {
+                break;
+            }
+        }
+        node->next = head;
+        head = node;
+        ++got;
+    }
+    outHead = head;
+    return got;
+}
+
+std::uint8_t* SlabAllocator::CarveLocked(std::size_t classSize) noexcept
+{
+    // chunk 보다 큰 class 는 전용 chunk
+    if (classSize >= kChunkSize) {
+        std::uint8_t* block = MapChunk(classSize);
+        if (block) {
+            mCarved.fetch_add(classSize, std::memory_order_relaxed);
+        }
+        return block;
+    }
+
+    // 같은 class 블록끼리 페이지를 덜 나눠 쓰도록 min(classSize, 4KB) 로 정렬
+    const std::size_t align = (classSize < 4096) ? classSize : 4096;
+    auto cur = reinterpret_cast<std::uintptr_t>(mBumpCur);
+    cur = (cur + align - 1) & ~(static_cast<std::uintptr_t>(align) - 1);
+
+    if (!mBumpCur || cur + classSize > reinterpret_cast<std::uintptr_t>(mBumpEnd)) {
+        std::uint8_t* chunk = MapChunk(kChunkSize);
+        if (!chunk) {
+            return nullptr;
+        }
+        mBumpCur = chunk;
+        mBumpEnd = chunk + kChunkSize;
+        cur = reinterpret_cast<std::uintptr_t>(mBumpCur);
+    }
+
+    auto* block = reinterpret_cast<std::uint8_t*>(cur);
+    mBumpCur = block + classSize;
+    mCarved.fetch_add(classSize, std::memory_order_relaxed);
+    return block;
+}
+
+std::uint8_t* SlabAllocator::MapChunk(std::size_t size) noexcept
+{
+    const eSlabBacking backing = mBacking.load(std::memory_order_relaxed);
+
+    if (backing == SlabBacking_HugeTlb && size % kChunkSize == 0) {
+        void* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED) {
+            mChunks.emplace_back(p, size);
+            mReserved.fetch_add(size, std::memory_order_relaxed);
+            mHugeTlbChunks.fetch_add(1, std::memory_order_relaxed);
+            return static_cast<std::uint8_t*>(p);
+        }
+        // 예약된 hugepage 가 없으면 THP 로 시도
+    }
+
+    if (backing == SlabBacking_Default) {
+        void* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) {
+            return nullptr;
+        }
+        mChunks.emplace_back(p, size);
+        mReserved.fetch_add(size, std::memory_order_relaxed);
+        return static_cast<std::uint8_t*>(p);
+    }
+
+    // THP 는 2MB 정렬된 구간에만 붙으므로 여유를 두고 잡은 뒤 앞뒤를 잘라낸다
+    const std::size_t span = size + kChunkSize;
+    void* raw = ::mmap(nullptr, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+        return nullptr;
+    }
+    auto begin   = reinterpret_cast<std::uintptr_t>(raw);
+    auto aligned = (begin + kChunkSize - 1) & ~(static_cast<std::uintptr_t>(kChunkSize) - 1);
+    if (aligned > begin) {
+        ::munmap(raw, aligned - begin);
+    }
+    const std::uintptr_t tail = begin + span - (aligned + size);
+    if (tail > 0) {
+        ::munmap(reinterpret_cast<void*>(aligned + size), tail);
+    }
+
+    void* p = reinterpret_cast<void*>(aligned);
+    (void)::madvise(p, size, MADV_HUGEPAGE);
+    mChunks.emplace_back(p, size);
+    mReserved.fetch_add(size, std::memory_order_relaxed);
+    return static_cast<std::uint8_t*>(p);
+}
+
+void SlabAllocator::SetBacking(eSlabBacking backing) noexcept
+{
+    mBacking.store(backing, std::memory_order_relaxed);
+}
+
+eSlabBacking SlabAllocator::Backing() const noexcept
+{
+    return mBacking.load(std::memory_order_relaxed);
+}
+
+SlabStats SlabAllocator::Stats() const noexcept
+{
+    SlabStats stats;
+    stats.reservedBytes  = mReserved.load(std::memory_order_relaxed);
+    stats.directBytes    = mDirect.load(std::memory_order_relaxed);
+    stats.inUseBytes     = mInUse.load(std::memory_order_relaxed);
+    stats.highWaterBytes = mHighWater.load(std::memory_order_relaxed);
+    stats.hugeTlbChunks  = mHugeTlbChunks.load(std::memory_order_relaxed);
+
+    const std::size_t carved   = mCarved.load(std::memory_order_relaxed);
+    const std::size_t slabUsed = stats.inUseBytes - stats.directBytes;
+    stats.freeBytes = (carved > slabUsed) ? carved - slabUsed : 0;
+    return stats;
+}
@@ -4,6 +4,18 @@
 #include <errno.h>
 #include <unistd.h>
 #include <arpa/inet.h>
+#include <netinet/in.h>
+#include <linux/errqueue.h>
+
+#ifndef SO_ZEROCOPY
+#define SO_ZEROCOPY 60
+#endif
+#ifndef SO_EE_ORIGIN_ZEROCOPY
+#define SO_EE_ORIGIN_ZEROCOPY 5
+#endif
+#ifndef SO_EE_CODE_ZEROCOPY_COPIED
+#define SO_EE_CODE_ZEROCOPY_COPIED 1
+#endif
 
 Socket::Socket()
     : mSocketFd{-1}
@@ -169,6 +181,177 @@ eSocketError Socket::Recv(void *buffer, std::size_t maxLength, std::size_t &outR
     return Socket_Ok;
 }
 
+eSocketError Socket::Readv(const struct iovec *spans, int spanCount, std::size_t &outReceived)
+{
+    outReceived = 0;
+
+    if (!IsOpen())
+    {
+        return Socket_InvalidState;
+    }
+
+    ssize_t received = ::readv(mSocketFd, spans, spanCount);
+    if (received < 0)
+    {
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            return Socket_WouldBlock;
+        }
+        return Socket_RecvFailed;
+    }
+
+    outReceived = static_cast<std::size_t>(received);
+    return Socket_Ok;
+}
+
+eSocketError Socket::Writev(const struct iovec *spans, int spanCount, std::size_t &outSent)
+{
+    return SendMsg(spans, spanCount, 0, outSent);
+}
+
+eSocketError Socket::SendMsg(const struct iovec *spans, int spanCount, int flags, std::size_t &outSent)
+{
+    outSent = 0;
+
+    if (!IsOpen())
+    {
+        return Socket_InvalidState;
+    }
+
+    // writev 와 동일하지만 끊긴 peer 에 SIGPIPE 가 나지 않도록 sendmsg 사용
+    msghdr msg{};
+    msg.msg_iov    = const_cast<struct iovec *>(spans);
+    msg.msg_iovlen = static_cast<size_t>(spanCount);
+
+    ssize_t sent = ::sendmsg(mSocketFd, &msg, flags | MSG_NOSIGNAL);
+    if (sent < 0)
+    {
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            return Socket_WouldBlock;
+        }
+        if (errno == ENOBUFS && (flags & MSG_ZEROCOPY))
+        {
+            // optmem 한도 초과: 완료 통지가 회수될 때까지 복사 경로로 보내면 됨
+            return Socket_NoBuffers;
+        }
+        return Socket_SendFailed;
+    }
+
+    outSent = static_cast<std::size_t>(sent);
+    return Socket_Ok;
+}
+
+eSocketError Socket::EnableZeroCopy()
+{
+    if (!IsOpen())
+    {
+        return Socket_InvalidState;
+    }
+
+    int one = 1;
+    if (::setsockopt(mSocketFd, SOL_SOCKET, SO_ZEROCOPY, &one, sizeof(one)) < 0)
+    {
+        return Socket_OptionFailed;
+    }
+    return Socket_Ok;
+}
+
+eSocketError Socket::ReadZeroCopyCompletion(ZeroCopyCompletion &out)
+{
+    if (!IsOpen())
+    {
+        return Socket_InvalidState;
+    }
+
+    for (;;)
+    {
+        char control[128];
+        msghdr msg{};
+        msg.msg_control    = control;
+        msg.msg_controllen = sizeof(control);
+
+        if (::recvmsg(mSocketFd, &msg, MSG_ERRQUEUE) < 0)
+        {
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                return Socket_WouldBlock;
+            }
+            return Socket_RecvFailed;
+        }
+
+        for (cmsghdr *cm = CMSG_FIRSTHDR(&msg); cm != nullptr; cm = CMSG_NXTHDR(&msg, cm))
+        {
+            const bool isRecvErr = (cm->cmsg_level == SOL_IP && cm->cmsg_type == IP_RECVERR) ||
+                                   (cm->cmsg_level == SOL_IPV6 && cm->cmsg_type == IPV6_RECVERR);
+            if (!isRecvErr)
+            {
+                continue;
+            }
+
+            const auto *ee = reinterpret_cast<const sock_extended_err *>(CMSG_DATA(cm));
+            if (ee->ee_errno != 0 || ee->ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+            {
+                continue;
+            }
+
+            out.lo     = ee->ee_info;
+            out.hi     = ee->ee_data;
+            out.copied = (ee->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0;
+            return Socket_Ok;
+        }
+        // zerocopy 가 아닌 통지(ICMP 등)는 버리고 다음 항목 확인
+    }
+}
+
+eSocketError Socket::GetPendingError(int &outError)
+{
+    outError = 0;
+
+    if (!IsOpen())
+    {
+        return Socket_InvalidState;
+    }
+
+    socklen_t len = sizeof(outError);
+    if (::getsockopt(mSocketFd, SOL_SOCKET, SO_ERROR, &outError, &len) < 0)
+    {
+        return Socket_OptionFailed;
+    }
+    return Socket_Ok;
+}
+
+eSocketError Socket::ShutdownWrite()
+{
+    if (!IsOpen())
+    {
+        return Socket_InvalidState;
+    }
+
+    if (::shutdown(mSocketFd, SHUT_WR) < 0 && errno != ENOTCONN)
+    {
+        return Socket_OptionFailed;
+    }
+    return Socket_Ok;
+}
+
+eSocketError Socket::Abort()
+{
+    if (!IsOpen())
+    {
+        return Socket_InvalidState;
+    }
+
+    // AF_UNSPEC 로 connect 하면 TCP 는 RST 를 보내고 연결을 끊는다 (tcp_disconnect)
+    sockaddr addr{};
+    addr.sa_family = AF_UNSPEC;
+    if (::connect(mSocketFd, &addr, sizeof(addr)) < 0)
+    {
+        return Socket_OptionFailed;
+    }
+    return Socket_Ok;
+}
+
 eSocketError Socket::SetBlocking(bool blocking)
 {
     if (!IsOpen())
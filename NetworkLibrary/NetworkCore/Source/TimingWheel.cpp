@@ -0,0 +1,237 @@
+#include "TimingWheel.h"
+
+#include <bit>
+
+TimerNode::~TimerNode()
+{
+    if (wheel) {
+        wheel->Cancel(*this);
+    }
+}
+
+TimingWheel::TimingWheel(std::chrono::milliseconds tick, Clock::time_point start)
+    : mTick(tick.count() > 0 ? tick : std::chrono::milliseconds(1)), mStart(start)
+{
+    for (int level = 0; level < kLevels; ++level) {
+        for (int slot = 0; slot < kSlots; ++slot) {
+            TimerNode& head = mSlots[level][slot];
+            head.prev = &head;
+            head.next = &head;
+        }
+    }
+}
+
+TimingWheel::~TimingWheel()
+{
+    // 아직 걸려 있는 노드가 나중에 소멸될 때 이 wheel 을 건드리지 않도록 끊어둔다.
+    for (int level = 0; level < kLevels; ++level) {
+        for (int slot = 0; slot < kSlots; ++slot) {
+            TimerNode& head = mSlots[level][slot];
+            TimerNode* node = head.next;
+            while (node != &head) {
+                TimerNode* next = node->next;
+                node->prev  = nullptr;
+                node->next  = nullptr;
+                node->wheel = nullptr;
+                node = next;
+            }
+            head.prev = &head;
+            head.next = &head;
+        }
+    }
+}
+
+std::uint64_t TimingWheel::ToTick(Clock::time_point t) const noexcept
+{
+    if (t <= mStart) {
+        return 0;
+    }
+    return static_cast<std::uint64_t>((t - mStart) / mTick);
+}
+
+void TimingWheel::Schedule(TimerNode& node, std::chrono::milliseconds delay)
+{
+    if (node.wheel) {
+        node.wheel->Cancel(node);
+    }
+
+    // 최소 1 tick 뒤로 올림해서 일찍 만료되는 일이 없게 한다.
+    std::uint64_t ticks = 0;
+    if (delay.count() > 0) {
+        ticks = static_cast<std::uint64_t>((delay.count() + mTick.count() - 1) / mTick.count());
+    }
+
+    constexpr std::uint64_t kMaxTicks = (std::uint64_t{1} << (kSlotBits * kLevels)) - 1;
+    if (ticks > kMaxTicks) {
+        ticks = kMaxTicks;
+    }
+
+    node.expireTick = mCurrentTick + ticks;
+    node.wheel      = this;
+    Link(node);
+    ++mSize;
+}
+
+void TimingWheel::Cancel(TimerNode& node) noexcept
+{
+    if (node.wheel != this) {
+        return;
+    }
+
+    Unlink(node);
+    node.wheel = nullptr;
+    --mSize;
+}
+
+void TimingWheel::Link(TimerNode& node)
+{
+    const std::uint64_t expire = (node.expireTick < mCurrentTick) ? mCurrentTick : node.expireTick;
+    const std::uint64_t delta  = expire - mCurrentTick;
+
+    int level = 0;
+    while (level < kLevels - 1 && delta >= (std::uint64_t{1} << (kSlotBits * (level + 1)))) {
+        ++level;
+    }
+    const int slot = static_cast<int>((expire >> (kSlotBits * level)) & (kSlots - 1));
+
+    TimerNode& head = mSlots[level][slot];
+    node.level = level;
+    node.slot  = slot;
+    node.prev  = head.prev;
+    node.next  = &head;
+    head.prev->next = &node;
+    head.prev       = &node;
+    mOccupied[level] |= (std::uint64_t{1} << slot);
+}
+
+void TimingWheel::Unlink(TimerNode& node) noexcept
+{
+    node.prev->next = node.next;
+    node.next->prev = node.prev;
+    node.prev = nullptr;
+    node.next = nullptr;
+
+    TimerNode& head = mSlots[node.level][node.slot];
+    if (head.next == &head) {
+        mOccupied[node.level] &= ~(std::uint64_t{1} << node.slot);
+    }
+}
+
+void TimingWheel::Cascade(int level, int slot)
+{
+    TimerNode& head = mSlots[level][slot];
+    if (head.next == &head) {
+        return;
+    }
+
+    // slot 을 통째로 떼어낸 뒤 하위 level 로 다시 분배
+    TimerNode* node = head.next;
+    head.prev->next = nullptr;
+    head.prev = &head;
+    head.next = &head;
+    mOccupied[level] &= ~(std::uint64_t{1} << slot);
+
+    while (node) {
+        TimerNode* next = node->next;
+        Link(*node);
+        node = next;
+    }
+}
+
+std::size_t TimingWheel::Advance(Clock::time_point now, const ExpireCallback& onExpire)
+{
+    const std::uint64_t target = ToTick(now);
+    std::size_t expired = 0;
+
+    if (mSize == 0) {
+        if (target >= mCurrentTick) {
+            mCurrentTick = target + 1;
+        }
+        return 0;
+    }
+
+    while (mCurrentTick <= target) {
+        const int index = static_cast<int>(mCurrentTick & (kSlots - 1));
+
+        // level0 이 한 바퀴 돌 때마다 상위 level 의 해당 slot 을 내려보낸다.
+        if (index == 0) {
+            for (int level = 1; level < kLevels; ++level) {
+                const int slot = static_cast<int>((mCurrentTick >> (kSlotBits * level)) & (kSlots - 1));
+                Cascade(level, slot);
+                if (slot != 0) {
+                    break;
+                }
+            }
+        }
+
+        TimerNode& head = mSlots[0][index];
+        while (head.next != &head) {
+            TimerNode& node = *head.next;
+            Unlink(node);
+            node.wheel = nullptr;
+            --mSize;
+            ++expired;
+            if (onExpire) {
+                onExpire(node);
+            }
+        }
+
+        ++mCurrentTick;
+        if (mSize == 0 && mCurrentTick <= target) {
+            mCurrentTick = target + 1;
+        }
+    }
+    return expired;
+}
+
+int TimingWheel::NextTimeoutMs(Clock::time_point now, int maxMs) const
+{
+    if (mSize == 0) {
+        return maxMs;
+    }
+
+    // slot bitmap 을 현재 위치 기준으로 회전시켜 가장 가까운 비어있지 않은 slot 을 찾는다.
+    std::uint64_t nextTick = ~std::uint64_t{0};
+    for (int level = 0; level < kLevels; ++level) {
+        if (mOccupied[level] == 0) {
+            continue;
+        }
+
+        const int shift = kSlotBits * level;
+        const int cur   = static_cast<int>((mCurrentTick >> shift) & (kSlots - 1));
+        const std::uint64_t rotated = std::rotr(mOccupied[level], cur);
+        const int ahead = std::countr_zero(rotated);
+
+        std::uint64_t tick = ((mCurrentTick >> shift) + static_cast<std::uint64_t>(ahead)) << shift;
+        if (tick < mCurrentTick) {
+            // 이번 주기의 cascade 지점은 이미 지났으니 한 바퀴 뒤
+            tick += std::uint64_t{kSlots} << shift;
+        }
+        if (tick < nextTick) {
+            nextTick = tick;
+        }
+    }
+
+    const auto due = mStart + mTick * static_cast<std::int64_t>(nextTick);
+    if (due <= now) {
+        return 0;
+    }
+
+    const auto waitMs = std::chrono::ceil<std::chrono::milliseconds>(due - now).count();
+    return (waitMs < maxMs) ? static_cast<int>(waitMs) : maxMs;
+}
+
+std::size_t TimingWheel::Size() const noexcept
+{
+    return mSize;
+}
+
+bool TimingWheel::IsEmpty() const noexcept
+{
+    return mSize == 0;
+}
+
+std::chrono::milliseconds TimingWheel::Tick() const noexcept
+{
+    return mTick;
+}
@@ -0,0 +1,86 @@
+#include "ZeroCopyLinger.h"
+
+void CompleteZeroCopyPins(std::deque<ZeroCopyPin> &pins, const ZeroCopyCompletion &completion)
+{
+    const std::uint32_t span = completion.hi - completion.lo;
+    for (auto &pin : pins)
+    {
+        if (static_cast<std::uint32_t>(pin.seq - completion.lo) <= span)
+        {
+            pin.done = true;
+            pin.buffer.reset();
+        }
+    }
+
+    while (!pins.empty() && pins.front().done)
+    {
+        pins.pop_front();
+    }
+}
+
+ZeroCopyLinger::~ZeroCopyLinger()
+{
+    // 스레드 종료: 더 기다릴 수 없으므로 끊고 이미 온 통지만 회수한다
+    for (auto &entry : mEntries)
+    {
+        if (!entry.aborted)
+            entry.socket.Abort();
+        Drain(entry);
+    }
+}
+
+void ZeroCopyLinger::Drain(Entry &entry)
+{
+    while (!entry.pins.empty())
+    {
+        ZeroCopyCompletion completion;
+        if (entry.socket.ReadZeroCopyCompletion(completion) != Socket_Ok)
+            break;
+        CompleteZeroCopyPins(entry.pins, completion);
+    }
+}
+
+void ZeroCopyLinger::Adopt(Socket &&socket, std::deque<ZeroCopyPin> &&pins)
+{
+    Entry entry{std::move(socket), std::move(pins), std::chrono::steady_clock::now() + kAbortAfter, false};
+    Drain(entry);
+    if (entry.pins.empty())
+        return; // 이미 다 끝났으면 entry 와 함께 socket 도 닫힌다
+
+    entry.socket.ShutdownWrite();
+    mEntries.push_back(std::move(entry));
+}
+
+void ZeroCopyLinger::Poll(std::chrono::steady_clock::time_point now)
+{
+    for (size_t i = 0; i < mEntries.size();)
+    {
+        Entry &entry = mEntries[i];
+        Drain(entry);
+        if (entry.pins.empty())
+        {
+            if (i + 1 != mEntries.size())
+                entry = std::move(mEntries.back());
+            mEntries.pop_back();
+            continue;
+        }
+
+        if (!entry.aborted && now >= entry.deadline)
+        {
+            entry.socket.Abort();
+            entry.aborted = true;
+        }
+        ++i;
+    }
+}
+
+std::size_t ZeroCopyLinger::Count() const noexcept
+{
+    return mEntries.size();
+}
+
+ZeroCopyLinger &ZeroCopyLinger::Local()
+{
+    thread_local ZeroCopyLinger linger;
+    return linger;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "EpollServer.h"
+
+enum eAcceptBalance
+{
+    AcceptBalance_RoundRobin = 0,
+    AcceptBalance_LeastConnections,
+};
+
+struct AcceptorStats
+{
+    std::uint64_t accepted = 0;
+    std::uint64_t acceptErrors = 0;
+    double acceptsPerSec = 0.0;                 // Run 시작 이후 평균
+    std::vector<std::uint64_t> handedOff;       // worker 별 누적 전달 수
+    std::vector<size_t> activeConnections;      // worker 별 현재 연결 수
+};
+
+// 하나의 acceptor 스레드가 listener 에서 accept 하고, 연결을 worker EpollServer 의
+// MPSC queue 로 넘긴 뒤 eventfd 로 깨운다. 연결이 적고 오래 유지될 때 reuseport 보다 고르게 분산된다.
+class AcceptorServer
+{
+public:
+    AcceptorServer(uint16_t port, size_t workerCount, size_t recvBufSize, size_t sendBufSize,
+                   eAcceptBalance balance = AcceptBalance_LeastConnections);
+    ~AcceptorServer();
+
+    AcceptorServer(const AcceptorServer &) = delete;
+    AcceptorServer &operator=(const AcceptorServer &) = delete;
+
+    void ForEachWorker(const std::function<void(EpollServer &)> &fn);
+    // 0 이면 주기적인 통계 출력 안 함
+    void SetStatsLogInterval(std::chrono::seconds interval);
+
+    bool Start();
+    // worker 들은 별도 스레드, accept loop 는 호출 스레드에서 돈다.
+    void Run();
+    void Stop();
+
+    AcceptorStats Stats() const;
+
+private:
+    size_t PickWorker();
+    void AcceptPending();
+    // accept 실패(EMFILE 등) 후 잠시 listener 를 epoll 에서 빼 둔다
+    void PauseAccept();
+    void WatchListener(bool watch);
+    void LogStats() const;
+
+private:
+    ListenerSocket mListener;
+    int mEpollFd = -1;
+    int mWakeFd = -1;
+    std::atomic<bool> mRunning{false};
+    eAcceptBalance mBalance;
+    size_t mNextWorker = 0;
+    std::chrono::seconds mStatsInterval{0};
+    std::chrono::steady_clock::time_point mStartTime;
+    bool mAcceptPaused = false;
+    std::chrono::steady_clock::time_point mAcceptResumeAt;
+
+    std::vector<std::unique_ptr<EpollServer>> mWorkers;
+    std::vector<std::thread> mThreads;
+
+    std::atomic<std::uint64_t> mAccepted{0};
+    std::atomic<std::uint64_t> mAcceptErrors{0};
+    std::unique_ptr<std::atomic<std::uint64_t>[]> mHandedOff;
+};
@@ -1,36 +1,161 @@
 #pragma once
 
-#include <unordered_map>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <vector>
 #include <sys/epoll.h>
 #include "ListenerSocket.h"
 #include "Session.h"
 #include "HttpParser.h"
-class EpollServer
+#include "TimingWheel.h"
+#include "MpscQueue.h"
+#include "EpollTriggerMode.h"
+#include "SessionPool.h"
+#include "ProtocolHandler.h"
+#include "ServerLoop.h"
+class EpollServer : public ServerLoop
 {
 public:
-    struct HttpConnState{
-        HttpParser parser;
-        bool closeAfterSend = false;
+    // 프로토콜 상태 + epoll 관심/재처리 상태
+    struct ConnState{
+        ProtocolState protocol;
+        size_t listener = 0; // 연결을 받은 listener (mListeners 인덱스) → protocol handler
+        bool readPaused = false;
+        bool writeInterest = false;
+        bool outArmed = false; // level 모드에서 EPOLLOUT 이 실제로 등록되어 있는지
+        // edge-triggered 에서 이벤트 없이 다시 처리해야 할 읽기/쓰기 (mPendingIo)
+        bool pendingRead = false;
+        bool pendingWrite = false;
+        bool ioQueued = false;
+        TimerNode idleTimer; // userData = fd
+    };
+
+    // fd 로 바로 찾는 연결 record. Session 과 프로토콜 상태를 같은 곳에 inline 으로 둔다.
+    struct ConnSlot{
+        std::optional<Session> session;
+        ConnState conn;
+        // 재사용될 때마다 증가. epoll data.u64 상위 32bit 에 넣어 fd 재사용 후 도착한 이벤트를 걸러낸다.
+        uint32_t generation = 0;
     };
 
     EpollServer(uint16_t port, size_t recvBufSize, size_t sendBufSize);
-    ~EpollServer();
+    ~EpollServer() override;
 
-    bool Start();
-    void Run();
-    void Stop();
+    bool Start() override;
+    void Run() override;
+    // 다른 스레드에서 불러도 됨 (eventfd 로 epoll_wait 을 깨움)
+    void Stop() override;
 
     void UpdateWriteInterest(int fd, bool enable);
+    void UpdateReadInterest(int fd, bool enable);
+    void SetBufferMode(eRingBufferMode mode);
+    // Segmented 모드에서는 sendBufSize 대신 maxQueuedBytes 가 연결당 송신 큐 상한 (0 = 무제한)
+    void SetSendBufferMode(eSendBufferMode mode, size_t maxQueuedBytes = 0);
+    // Segmented 모드에서 bytes 이상인 응답 body 는 MSG_ZEROCOPY 로 전송 (0 = 끔)
+    void SetZeroCopyThreshold(size_t bytes);
+    // 연결당 송신 큐가 high 를 넘으면 EPOLLIN 을 끄고 요청 파싱을 멈췄다가 low 이하에서 재개 (high 0 = 끔)
+    void SetSendWatermarks(size_t low, size_t high);
+    void SetIdleTimeout(std::chrono::milliseconds timeout);
+    // Start 전에 설정. multi-reactor 모드에서 스레드마다 같은 포트로 listener 를 연다.
+    void SetReusePort(bool enable);
+    // 요청/쓰기 관심 변경마다 찍는 디버그 로그 (stdout 는 스레드 간 공유 자원이라 기본은 끔)
+    void SetVerbose(bool verbose);
+    // false 면 listener 를 열지 않는 worker 로 동작하고 EnqueueConnection 으로만 연결을 받는다.
+    void SetListenEnabled(bool enable);
+    // Start 전에 설정. Edge 계열은 IN/OUT 을 한 번만 등록하고 쓰기 관심 토글에 epoll_ctl 을 쓰지 않는다.
+    void SetTriggerMode(eEpollTriggerMode mode);
+    // 연결 하나가 wakeup 한 번에 읽고 쓸 최대 바이트 (0 = EAGAIN 까지). 남은 일은 같은 loop 의 다음 회차로 넘긴다.
+    void SetIoBudget(size_t bytes);
+    // level 모드에서 응답을 바로 EPOLLOUT 에 걸지 않고 loop 회차 끝에 세션당 writev 한 번으로 내보낸다.
+    // 커널 버퍼가 가득 차서 남은 경우에만 EPOLLOUT 을 등록. (edge 계열은 원래 이렇게 동작)
+    void SetDeferredFlush(bool enable);
+    // 닫힌 세션을 버퍼째 최대 maxCached 개 보관해 재사용하고, Run 시작 때 loop 스레드에서 prewarm 개를 미리 만든다. (0 = pool 끔)
+    void SetSessionPool(size_t maxCached, size_t prewarm = 0);
+    // 연결별 recv/send ring 을 데이터가 있을 때만 들고 있게 한다 (idle keep-alive 가 많을 때)
+    void SetLazyBuffers(bool lazy);
+    // Start 전에 설정. 생성자 port 의 기본 listener 에 거는 프로토콜 (기본 HTTP)
+    void SetProtocol(eServerProtocol protocol);
+    void SetProtocolHandler(ProtocolHandler handler);
+    // Start 전에 설정. 같은 loop 안에서 다른 port 로 다른 프로토콜을 받는다 (SetReusePort 는 모든 listener 에 적용)
+    void AddListener(uint16_t port, ProtocolHandler handler);
+
+    // acceptor 스레드에서 호출: 연결을 넘기고 eventfd 로 이 loop 를 깨운다. 기본 listener 의 프로토콜로 처리.
+    bool EnqueueConnection(Socket &&clientSocket);
+    // 다른 스레드에서 읽어도 되는 부하 지표 (열린 연결 + 아직 넘겨받지 않은 연결)
+    size_t LoadEstimate() const noexcept;
+    size_t ConnectionCount() const noexcept override;
 private:
-    void HandleNewConnection();
-    void HandleClientEvent(int fd, uint32_t events);
+    // Tests/Test_EpollServer.cpp 가 loop 한 회차의 단계를 직접 호출한다
+    friend class EpollServerTest;
+
+    struct Listener{
+        ListenerSocket socket;
+        ProtocolHandler handler;
+    };
+
+    void HandleNewConnection(size_t listener);
+    bool AdoptConnection(Socket &&clientSocket, size_t listener);
+    // Session 콜백 대신 연결의 handler 로 직접 dispatch
+    eSessionError ReadReady(ConnSlot &slot);
+    eSessionError WriteReady(ConnSlot &slot);
+    const ProtocolHandler &HandlerOf(const ConnSlot &slot) const noexcept;
+    size_t FindListener(int fd) const noexcept; // 없으면 SIZE_MAX
+    void DrainIncoming();
+    void HandleClientEvent(uint64_t tag, uint32_t events);
+    ConnSlot *FindSlot(int fd) noexcept;
+    ConnSlot &AcquireSlot(int fd);
+    Session *FindSession(int fd) noexcept;
+    void ReleaseSlot(ConnSlot &slot);
+    size_t SessionSendBufSize() const;
+    static uint64_t MakeEventTag(int fd, uint32_t generation) noexcept;
+    void ReapClosedSessions();
+    void ApplyInterest(int fd);
+    uint32_t BuildInterest(const ConnState &st) const;
+    void SchedulePendingIo(int fd, bool read, bool write);
+    void ScheduleRetries(int fd, Session &sess);
+    void ProcessPendingIo();
+    void ResumePausedSessions();
+    void ExpireIdleSessions();
+    void Shutdown();
 
     int mEpollFd;
-    bool mRunning;
-    ListenerSocket mListener;
+    int mWakeFd = -1;
+    std::atomic<bool> mRunning;
+    bool mVerbose = false;
+    bool mListenEnabled = true;
+    bool mReusePort = false;
+    std::vector<Listener> mListeners; // [0] 은 생성자 port
     size_t mRecvBufSize;
     size_t mSendBufSize;
+    eRingBufferMode mBufferMode = RingBuffer_Heap;
+    eSendBufferMode mSendBufferMode = SendBufMode_Ring;
+    size_t mSendQueueLimit = 0;
+    size_t mZeroCopyThreshold = 0;
+    size_t mSendLowWatermark = 0;
+    size_t mSendHighWatermark = 0;
+    eEpollTriggerMode mTriggerMode = EpollTrigger_Level;
+    size_t mIoBudget = 0;
+    size_t mPoolMaxCached = SessionPool::kDefaultMaxCached;
+    size_t mPoolPrewarm = 0;
+    bool mLazyBuffers = false;
+    bool mDeferredFlush = false;
+    std::optional<SessionPool> mSessionPool; // Start 에서 버퍼 설정이 확정된 뒤 생성
+    std::chrono::milliseconds mIdleTimeout{std::chrono::seconds(30)};
+    TimingWheel mIdleTimers;
+
+    // fd 번호로 인덱싱하는 slot table. TimerNode 와 콜백이 slot 주소를 잡고 있으므로
+    // 재할당 없이 256 개 단위 page 로만 늘린다.
+    static constexpr int kSlotPageBits = 8;
+    static constexpr int kSlotPageSize = 1 << kSlotPageBits;
+    std::vector<std::unique_ptr<ConnSlot[]>> mSlotPages;
+    std::vector<int> mClosedFds;
+    std::vector<int> mResumedFds;
+    std::vector<int> mPendingIo;
+    std::vector<int> mPendingIoScratch;
 
-    std::unordered_map<int, std::unique_ptr<Session>> mSessions;
-    std::unordered_map<int, HttpConnState> mHttpStates;
+    MpscQueue<Socket> mIncoming;
+    std::atomic<size_t> mPendingHandoffs{0};
+    std::atomic<size_t> mConnectionCount{0};
 };
\ No newline at end of file
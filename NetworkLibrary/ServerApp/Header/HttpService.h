@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include "HttpParser.h"
+#include "Session.h"
+
+// 연결 하나의 HTTP 상태 (HttpHandler::State)
+struct HttpSessionState
+{
+    HttpParser parser;
+    bool closeAfterSend = false;
+
+    // OnHeaders 부터 OnBodyEnd 까지 (body 가 여러 recv 에 걸칠 수 있음)
+    bool inBody = false;
+    bool echoBody = false;     // /echo: 받은 body 조각을 그대로 응답 body 로 보냄
+    bool chunkedReply = false; // 길이를 모르는 요청 (chunked) 이라 응답도 chunked
+
+    void Reset()
+    {
+        parser.Reset();
+        closeAfterSend = false;
+        inBody = false;
+        echoBody = false;
+        chunkedReply = false;
+    }
+};
+
+// 요청 파싱 → 라우팅(/health, /echo) → 응답 큐잉.
+// 요청은 HttpParser::TryParseStream 으로 받아 body 를 모으지 않는다. /echo 는 받은 조각을 바로 돌려보내므로
+// 업로드 크기와 무관하게 연결당 메모리는 recv buffer + 송신 watermark 정도.
+// HttpHandler 가 감싸서 EpollServer / UringServer 양쪽에서 쓴다.
+class HttpService
+{
+public:
+    // bytes 이상인 응답 body 는 zerocopy 가 켜진 세션에서 참조로 넣는다 (0 = 끔)
+    void SetZeroCopyThreshold(size_t bytes);
+    void SetVerbose(bool verbose);
+
+    void OnRecv(Session &s, RecvBuffer &rb, HttpSessionState &st) const;
+    void OnSent(Session &s, HttpSessionState &st) const;
+
+    // header 만으로 답하는 route. req.body 는 보지 않는다 (TryParseStream 의 view 는 항상 비어 있음)
+    static void Route(const HttpRequestView &req, HttpResponse &resp);
+
+private:
+    class StreamExchange;
+
+    bool QueueResponse(Session &s, HttpResponse &resp, bool keepAlive) const;
+    bool QueueBody(Session &s, std::string_view data) const;
+
+    size_t mZeroCopyThreshold = 0;
+    bool mVerbose = false;
+};
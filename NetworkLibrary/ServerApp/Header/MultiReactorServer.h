@@ -0,0 +1,39 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "EpollServer.h"
+#include "ServerLoop.h"
+
+// 스레드마다 독립된 loop(epoll 또는 io_uring, SO_REUSEPORT listener, 세션 테이블)를 하나씩 돌린다.
+// 연결 분산은 커널의 reuseport 해시에 맡기며, 요청 경로에서 스레드 간 공유 상태는 없다.
+class MultiReactorServer
+{
+public:
+    // index 번째 reactor 를 만든다. reuseport 설정까지 factory 가 맡는다.
+    using LoopFactory = std::function<std::unique_ptr<ServerLoop>(size_t index)>;
+
+    MultiReactorServer(uint16_t port, size_t reactorCount, size_t recvBufSize, size_t sendBufSize);
+    MultiReactorServer(size_t reactorCount, const LoopFactory &factory);
+    ~MultiReactorServer();
+
+    MultiReactorServer(const MultiReactorServer &) = delete;
+    MultiReactorServer &operator=(const MultiReactorServer &) = delete;
+
+    // Start 전에 각 reactor 설정 (버퍼 모드, watermark 등). epoll reactor 로 만든 경우에만 해당
+    void ForEachReactor(const std::function<void(EpollServer &)> &fn);
+
+    bool Start();
+    // reactor 0 은 호출 스레드에서, 나머지는 별도 스레드에서 돌리고 모두 끝날 때까지 대기
+    void Run();
+    void Stop();
+
+    size_t ReactorCount() const noexcept;
+
+private:
+    std::vector<std::unique_ptr<ServerLoop>> mReactors;
+    std::vector<EpollServer *> mEpollReactors;
+    std::vector<std::thread> mThreads;
+};
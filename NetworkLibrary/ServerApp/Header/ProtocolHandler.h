@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <variant>
+#include "HttpService.h"
+#include "Session.h"
+
+// 연결에 거는 프로토콜. MakeProtocolHandler 로 기본 handler 를 만든다.
+enum eServerProtocol
+{
+    ServerProtocol_Http = 0,
+    // [len(4, big-endian)][payload] 프레임을 그대로 돌려보냄 (MessageFramer)
+    ServerProtocol_FramedEcho,
+};
+
+// protocol handler 는 아래 hook 을 가진 값 타입이다. listener 마다 하나씩 두고 ProtocolHandler variant 로
+// 정적 dispatch 하므로 hot path 에 std::function / virtual 호출이 없다. 연결별 상태는 State 로 따로 둔다.
+//   kFramed           : true 면 MessageFramer 로 잘라 OnFrame, false 면 OnData 에 RecvBuffer 를 그대로 넘김
+//   OnData            : 받은 데이터 (소비한 만큼 RecvBuffer 에서 읽어 냄)
+//   OnFrame           : 완성된 frame 하나
+//   OnWritableDrained : 송신 큐가 비었음
+//   OnClose           : 세션이 닫힘 (State 는 이후 Reset 되어 다음 연결에 재사용)
+struct HttpHandler
+{
+    using State = HttpSessionState;
+    static constexpr bool kFramed = false;
+
+    HttpService service;
+
+    void OnData(Session &s, RecvBuffer &rb, State &st) const { service.OnRecv(s, rb, st); }
+    void OnFrame(Session &, const std::uint8_t *, std::size_t, State &) const {}
+    void OnWritableDrained(Session &s, State &st) const { service.OnSent(s, st); }
+    void OnClose(Session &, State &) const {}
+};
+
+struct FramedEchoHandler
+{
+    struct State
+    {
+        void Reset() {}
+    };
+    static constexpr bool kFramed = true;
+
+    void OnData(Session &, RecvBuffer &, State &) const {}
+    void OnFrame(Session &s, const std::uint8_t *payload, std::size_t len, State &) const
+    {
+        // 송신 한도를 넘어 echo 가 빠지면 frame 순서가 어긋나므로 연결을 끊는다
+        if (s.SendFrame(payload, len) != Session_Ok)
+            s.Close();
+    }
+    void OnWritableDrained(Session &, State &) const {}
+    void OnClose(Session &, State &) const {}
+};
+
+// 새 프로토콜은 여기와 ProtocolState 에 같은 순서로 추가
+using ProtocolHandler = std::variant<HttpHandler, FramedEchoHandler>;
+using ProtocolState = std::variant<HttpHandler::State, FramedEchoHandler::State>;
+
+ProtocolHandler MakeProtocolHandler(eServerProtocol protocol);
+
+// HttpHandler 의 HttpService 설정 (다른 handler 는 무시)
+void ConfigureHttp(ProtocolHandler &handler, size_t zeroCopyThreshold, bool verbose);
+
+// state 를 handler 에 맞는 초기 상태로 바꾼다 (연결을 받을 때와 slot 을 재사용할 때)
+void ResetProtocolState(const ProtocolHandler &handler, ProtocolState &state);
+
+// Session 콜백을 쓰지 않는 loop 용. OnReadable / OnWritable 뒤에 직접 부른다.
+void DispatchRecv(const ProtocolHandler &handler, Session &session, ProtocolState &state);
+void DispatchWritableDrained(const ProtocolHandler &handler, Session &session, ProtocolState &state);
+void DispatchClose(const ProtocolHandler &handler, Session &session, ProtocolState &state);
+
+// Session 이 dispatch 하는 loop (UringServer 의 DeliverRecv) 용으로 recv/frame/send 콜백에 연결한다.
+// handler 와 state 는 세션이 닫힐 때까지 주소가 바뀌면 안 된다. close 콜백은 loop 가 직접 건다.
+void BindSessionCallbacks(const ProtocolHandler &handler, Session &session, ProtocolState &state);
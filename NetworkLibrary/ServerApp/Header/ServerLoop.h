@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+
+// 이벤트 루프 backend 공통 인터페이스 (EpollServer, UringServer).
+// 연결 처리는 ProtocolHandler 로 붙으므로 backend 를 바꿔도 그대로다.
+class ServerLoop
+{
+public:
+    virtual ~ServerLoop() = default;
+
+    virtual bool Start() = 0;
+    // 호출 스레드에서 Stop 까지 loop 를 돈다
+    virtual void Run() = 0;
+    // 다른 스레드에서 불러도 됨
+    virtual void Stop() = 0;
+    virtual size_t ConnectionCount() const noexcept = 0;
+};
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+#include <sys/socket.h>
+#include "ProtocolHandler.h"
+#include "IoUring.h"
+#include "ListenerSocket.h"
+#include "ServerLoop.h"
+#include "Session.h"
+#include "TimingWheel.h"
+
+// io_uring 기반 이벤트 루프. EpollServer 와 같은 Session / ProtocolHandler 를 쓰고 I/O 제출 방식만 다르다.
+//  - accept : multishot accept 하나로 연결마다 다시 걸지 않음
+//  - recv   : 연결당 multishot recv + provided buffer ring. 커널이 고른 버퍼를 Session::DeliverRecv 로 넘기고 바로 반납
+//  - send   : Session::PrepareSend 구간을 sendmsg 여러 개로 나눠 IOSQE_IO_LINK 로 묶어 한 번에 제출
+// 연결 record 는 sqe user_data 에 주소로 들어가므로, 걸려 있는 요청이 모두 끝날 때까지 해제하지 않는다.
+class UringServer : public ServerLoop
+{
+public:
+    static constexpr int kMaxLinkedSends = 4;
+    static constexpr unsigned kDefaultRingEntries = 4096;
+    static constexpr unsigned kDefaultRecvBufferCount = 1024;
+    static constexpr size_t kDefaultRecvBufferSize = 16 * 1024;
+
+    struct ConnState{
+        ProtocolState protocol;
+        TimerNode idleTimer; // userData = Conn 주소
+        // paused 동안 도착한 데이터 (multishot 은 취소가 닿기 전까지 더 올 수 있음)
+        std::vector<std::uint8_t> stash;
+        bool recvArmed = false;     // multishot recv 의 마지막 cqe 를 아직 못 받음
+        bool flushQueued = false;
+        bool closeQueued = false;
+        bool sendBroken = false;    // 링크 체인 중간이 짧게 끝남 → 뒤 순서가 어긋나므로 연결 종료
+        int sendsInFlight = 0;
+        int sendHead = 0;
+        size_t sendAttempted[kMaxLinkedSends]{};
+        msghdr msgs[kMaxLinkedSends]{};
+        iovec spans[kMaxLinkedSends * Session::kMaxSendSpans]{};
+    };
+
+    struct Conn{
+        std::optional<Session> session;
+        ConnState state;
+        size_t index = 0; // mConns 안의 위치 (swap-remove 용)
+    };
+
+    UringServer(uint16_t port, size_t recvBufSize, size_t sendBufSize);
+    ~UringServer() override;
+
+    UringServer(const UringServer &) = delete;
+    UringServer &operator=(const UringServer &) = delete;
+
+    bool Start() override;
+    void Run() override;
+    // 다른 스레드에서 불러도 됨 (eventfd read 완료로 loop 를 깨움)
+    void Stop() override;
+    size_t ConnectionCount() const noexcept override;
+
+    // 아래 설정은 Start 전에
+    void SetReusePort(bool enable);
+    void SetVerbose(bool verbose);
+    void SetProtocol(eServerProtocol protocol);
+    void SetProtocolHandler(ProtocolHandler handler);
+    void SetBufferMode(eRingBufferMode mode);
+    void SetSendBufferMode(eSendBufferMode mode, size_t maxQueuedBytes = 0);
+    void SetSendWatermarks(size_t low, size_t high);
+    void SetIdleTimeout(std::chrono::milliseconds timeout);
+    void SetLazyBuffers(bool lazy);
+    // SQ 크기와 provided buffer ring (개수는 2의 거듭제곱). 버퍼가 모두 쓰이면 recv 가 -ENOBUFS 로 끝나 다시 건다.
+    void SetRingEntries(unsigned entries);
+    void SetRecvBuffers(unsigned count, size_t bufSize);
+    // 닫힌 연결 record 를 Session 버퍼째 최대 maxCached 개 보관해 재사용
+    void SetConnectionCache(size_t maxCached);
+
+private:
+    enum eOp : std::uint64_t
+    {
+        Op_Recv = 1,
+        Op_Send = 2,
+    };
+
+    void ArmAccept();
+    void ArmWake();
+    void ArmRecv(Conn &conn);
+    void CancelOps(Conn &conn, eOp op);
+    void QueueFlush(Conn &conn);
+    void FlushSends();
+    void Flush(Conn &conn);
+
+    void HandleCqe(const io_uring_cqe &cqe);
+    void HandleAccept(const io_uring_cqe &cqe);
+    void HandleRecv(Conn &conn, const io_uring_cqe &cqe);
+    void HandleSend(Conn &conn, const io_uring_cqe &cqe);
+    void DeliverStash(Conn &conn);
+
+    bool AdoptConnection(int fd);
+    Conn &AcquireConn();
+    void ReleaseConn(Conn &conn);
+    bool HasOpsInFlight(const Conn &conn) const noexcept;
+    void ResumePausedSessions();
+    void ExpireIdleSessions();
+    void ReapClosedSessions();
+    void Shutdown();
+
+    static std::uint64_t MakeTag(Conn &conn, eOp op) noexcept;
+
+private:
+    IoUring mRing;
+    IoUringBufferRing mRecvRing;
+    ListenerSocket mListener;
+    int mWakeFd = -1;
+    std::uint64_t mWakeValue = 0;
+    std::atomic<bool> mRunning{false};
+    bool mVerbose = false;
+    bool mAcceptArmed = false;
+    bool mWakeArmed = false;
+
+    size_t mRecvBufSize;
+    size_t mSendBufSize;
+    eRingBufferMode mBufferMode = RingBuffer_Heap;
+    eSendBufferMode mSendBufferMode = SendBufMode_Ring;
+    size_t mSendQueueLimit = 0;
+    size_t mSendLowWatermark = 0;
+    size_t mSendHighWatermark = 0;
+    bool mLazyBuffers = false;
+    ProtocolHandler mHandler;
+    unsigned mRingEntries = kDefaultRingEntries;
+    unsigned mRecvBufferCount = kDefaultRecvBufferCount;
+    size_t mRecvBufferSize = kDefaultRecvBufferSize;
+    size_t mMaxCachedConns = 1024;
+    std::chrono::milliseconds mIdleTimeout{std::chrono::seconds(30)};
+    TimingWheel mIdleTimers;
+
+    std::vector<std::unique_ptr<Conn>> mConns;     // 요청이 걸려 있을 수 있는 모든 연결 (닫히는 중 포함)
+    std::vector<std::unique_ptr<Conn>> mFreeConns;
+    std::vector<Conn *> mDirty;
+    std::vector<Conn *> mResumed;
+    std::vector<Conn *> mClosed;
+
+    std::atomic<size_t> mConnectionCount{0};
+};
@@ -0,0 +1,259 @@
+#include "AcceptorServer.h"
+#include "SlabAllocator.h"
+#include <algorithm>
+#include <iostream>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+// accept 가 실패했을 때 listener 를 다시 보기까지 쉬는 시간
+static constexpr std::chrono::milliseconds kAcceptBackoff{100};
+
+AcceptorServer::AcceptorServer(uint16_t port, size_t workerCount,
+                               size_t recvBufSize, size_t sendBufSize,
+                               eAcceptBalance balance)
+    : mListener(port, 1024), mBalance(balance) {
+  if (workerCount == 0)
+    workerCount = 1;
+
+  mWorkers.reserve(workerCount);
+  for (size_t i = 0; i < workerCount; ++i) {
+    auto worker = std::make_unique<EpollServer>(port, recvBufSize, sendBufSize);
+    worker->SetListenEnabled(false);
+    mWorkers.push_back(std::move(worker));
+  }
+
+  mHandedOff = std::make_unique<std::atomic<std::uint64_t>[]>(workerCount);
+  for (size_t i = 0; i < workerCount; ++i)
+    mHandedOff[i].store(0, std::memory_order_relaxed);
+}
+
+AcceptorServer::~AcceptorServer() {
+  Stop();
+  for (auto &t : mThreads) {
+    if (t.joinable())
+      t.join();
+  }
+  if (mEpollFd != -1)
+    ::close(mEpollFd);
+  if (mWakeFd != -1)
+    ::close(mWakeFd);
+}
+
+void AcceptorServer::ForEachWorker(
+    const std::function<void(EpollServer &)> &fn) {
+  for (auto &worker : mWorkers)
+    fn(*worker);
+}
+
+void AcceptorServer::SetStatsLogInterval(std::chrono::seconds interval) {
+  mStatsInterval = interval;
+}
+
+bool AcceptorServer::Start() {
+  if (mListener.Open() != ListenerSocket_Ok) {
+    std::cerr << "Listener open failed\n";
+    return false;
+  }
+
+  mEpollFd = ::epoll_create1(0);
+  mWakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (mEpollFd < 0 || mWakeFd < 0) {
+    std::perror("acceptor epoll/eventfd");
+    return false;
+  }
+
+  epoll_event ev{};
+  ev.events = EPOLLIN;
+  ev.data.fd = mListener.GetFd();
+  if (::epoll_ctl(mEpollFd, EPOLL_CTL_ADD, mListener.GetFd(), &ev) < 0) {
+    std::perror("epoll_ctl ADD listener");
+    return false;
+  }
+
+  ev.data.fd = mWakeFd;
+  if (::epoll_ctl(mEpollFd, EPOLL_CTL_ADD, mWakeFd, &ev) < 0) {
+    std::perror("epoll_ctl ADD wake");
+    return false;
+  }
+
+  for (size_t i = 0; i < mWorkers.size(); ++i) {
+    if (!mWorkers[i]->Start()) {
+      std::cerr << "Worker " << i << " start failed\n";
+      return false;
+    }
+  }
+
+  mRunning = true;
+  return true;
+}
+
+void AcceptorServer::Run() {
+  for (auto &worker : mWorkers) {
+    EpollServer *w = worker.get();
+    mThreads.emplace_back([w] { w->Run(); });
+  }
+
+  mStartTime = std::chrono::steady_clock::now();
+  auto nextLog = mStartTime + mStatsInterval;
+
+  constexpr int MAX_EVENTS = 8;
+  epoll_event events[MAX_EVENTS];
+
+  while (mRunning) {
+    int timeoutMs = 1000;
+    if (mStatsInterval.count() > 0) {
+      const auto wait = std::chrono::ceil<std::chrono::milliseconds>(
+                            nextLog - std::chrono::steady_clock::now())
+                            .count();
+      timeoutMs = static_cast<int>(std::clamp<long long>(wait, 0, 1000));
+    }
+    if (mAcceptPaused) {
+      const auto wait = std::chrono::ceil<std::chrono::milliseconds>(
+                            mAcceptResumeAt - std::chrono::steady_clock::now())
+                            .count();
+      timeoutMs = std::min(timeoutMs, static_cast<int>(std::max<long long>(wait, 0)));
+    }
+
+    int n = ::epoll_wait(mEpollFd, events, MAX_EVENTS, timeoutMs);
+    if (n < 0) {
+      if (errno == EINTR)
+        continue;
+      std::perror("epoll_wait");
+      break;
+    }
+
+    for (int i = 0; i < n; ++i) {
+      if (events[i].data.fd == mListener.GetFd()) {
+        AcceptPending();
+      } else if (events[i].data.fd == mWakeFd) {
+        std::uint64_t value = 0;
+        (void)::read(mWakeFd, &value, sizeof(value));
+      }
+    }
+
+    if (mAcceptPaused && std::chrono::steady_clock::now() >= mAcceptResumeAt) {
+      mAcceptPaused = false;
+      WatchListener(true);
+    }
+
+    if (mStatsInterval.count() > 0 &&
+        std::chrono::steady_clock::now() >= nextLog) {
+      LogStats();
+      nextLog += mStatsInterval;
+    }
+  }
+
+  mListener.Close();
+  for (auto &worker : mWorkers)
+    worker->Stop();
+  for (auto &t : mThreads) {
+    if (t.joinable())
+      t.join();
+  }
+  mThreads.clear();
+}
+
+void AcceptorServer::Stop() {
+  mRunning = false;
+  if (mWakeFd >= 0) {
+    const std::uint64_t one = 1;
+    (void)::write(mWakeFd, &one, sizeof(one));
+  }
+}
+
+void AcceptorServer::AcceptPending() {
+  for (;;) {
+    Socket clientSocket;
+    eListenerSocketError err = mListener.Accept(clientSocket);
+    if (err == ListenerSocket_WouldBlock)
+      break;
+    if (err != ListenerSocket_Ok) {
+      mAcceptErrors.fetch_add(1, std::memory_order_relaxed);
+      PauseAccept();
+      break;
+    }
+
+    const size_t index = PickWorker();
+    if (mWorkers[index]->EnqueueConnection(std::move(clientSocket))) {
+      mAccepted.fetch_add(1, std::memory_order_relaxed);
+      mHandedOff[index].fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+}
+
+void AcceptorServer::PauseAccept() {
+  // EMFILE/ENFILE 이면 연결이 backlog 에 그대로 남아 level-triggered listener 가 곧바로 다시 깨운다.
+  // 그대로 두면 accept 실패만 반복하며 CPU 를 태우므로 fd 가 풀릴 시간을 준다.
+  if (mAcceptPaused)
+    return;
+  mAcceptPaused = true;
+  mAcceptResumeAt = std::chrono::steady_clock::now() + kAcceptBackoff;
+  WatchListener(false);
+}
+
+void AcceptorServer::WatchListener(bool watch) {
+  epoll_event ev{};
+  ev.events = watch ? static_cast<uint32_t>(EPOLLIN) : 0u;
+  ev.data.fd = mListener.GetFd();
+  ::epoll_ctl(mEpollFd, EPOLL_CTL_MOD, mListener.GetFd(), &ev);
+}
+
+size_t AcceptorServer::PickWorker() {
+  if (mBalance == AcceptBalance_RoundRobin) {
+    const size_t index = mNextWorker;
+    mNextWorker = (mNextWorker + 1) % mWorkers.size();
+    return index;
+  }
+
+  // least-connections: 동률이면 round-robin 위치부터 찾아서 한쪽으로 쏠리지 않게 함
+  size_t best = mNextWorker;
+  size_t bestLoad = mWorkers[best]->LoadEstimate();
+  for (size_t k = 1; k < mWorkers.size(); ++k) {
+    const size_t i = (mNextWorker + k) % mWorkers.size();
+    const size_t load = mWorkers[i]->LoadEstimate();
+    if (load < bestLoad) {
+      best = i;
+      bestLoad = load;
+    }
+  }
+  mNextWorker = (best + 1) % mWorkers.size();
+  return best;
+}
+
+AcceptorStats AcceptorServer::Stats() const {
+  AcceptorStats stats;
+  stats.accepted = mAccepted.load(std::memory_order_relaxed);
+  stats.acceptErrors = mAcceptErrors.load(std::memory_order_relaxed);
+
+  const double elapsed = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - mStartTime)
+                             .count();
+  if (elapsed > 0.0)
+    stats.acceptsPerSec = static_cast<double>(stats.accepted) / elapsed;
+
+  stats.handedOff.reserve(mWorkers.size());
+  stats.activeConnections.reserve(mWorkers.size());
+  for (size_t i = 0; i < mWorkers.size(); ++i) {
+    stats.handedOff.push_back(mHandedOff[i].load(std::memory_order_relaxed));
+    stats.activeConnections.push_back(mWorkers[i]->ConnectionCount());
+  }
+  return stats;
+}
+
+void AcceptorServer::LogStats() const {
+  const AcceptorStats stats = Stats();
+  std::cout << "[Acceptor] accepted=" << stats.accepted
+            << " errors=" << stats.acceptErrors
+            << " rate=" << stats.acceptsPerSec << "/s workers=";
+  for (size_t i = 0; i < stats.activeConnections.size(); ++i) {
+    std::cout << (i ? " " : "") << stats.activeConnections[i] << "/"
+              << stats.handedOff[i];
+  }
+  // ring 버퍼 slab 사용량 (KB)
+  const SlabStats slab = SlabAllocator::Global().Stats();
+  std::cout << " (active/total) slab inUse=" << slab.inUseBytes / 1024
+            << "K free=" << slab.freeBytes / 1024
+            << "K high=" << slab.highWaterBytes / 1024
+            << "K reserved=" << slab.reservedBytes / 1024 << "K" << std::endl;
+}
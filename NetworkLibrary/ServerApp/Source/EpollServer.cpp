@@ -1,26 +1,43 @@
 #include "EpollServer.h"
+#include "ZeroCopyLinger.h"
 #include <chrono>
+#include <cstdint>
 #include <fcntl.h>
 #include <iostream>
 #include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <unistd.h>
 
 EpollServer::EpollServer(uint16_t port, size_t recvBufSize, size_t sendBufSize)
-    : mEpollFd(-1), mRunning(false), mListener(port, 100),
-      mRecvBufSize(recvBufSize), mSendBufSize(sendBufSize) {}
+    : mEpollFd(-1), mRunning(false), mRecvBufSize(recvBufSize),
+      mSendBufSize(sendBufSize) {
+  mListeners.push_back(Listener{ListenerSocket(port, 100), HttpHandler{}});
+}
 
 EpollServer::~EpollServer() {
   Stop();
+  Shutdown();
   if (mEpollFd != -1) {
     close(mEpollFd);
     mEpollFd = -1;
   }
+  if (mWakeFd != -1) {
+    close(mWakeFd);
+    mWakeFd = -1;
+  }
 }
 
 bool EpollServer::Start() {
-  if (mListener.Open() != ListenerSocket_Ok) {
-    std::cerr << "Listener open failed\n";
-    return false;
+  for (Listener &l : mListeners)
+    ConfigureHttp(l.handler, mZeroCopyThreshold, mVerbose);
+
+  if (mListenEnabled) {
+    for (Listener &l : mListeners) {
+      if (l.socket.Open() != ListenerSocket_Ok) {
+        std::cerr << "Listener open failed\n";
+        return false;
+      }
+    }
   }
 
   mEpollFd = ::epoll_create1(0);
@@ -29,200 +46,492 @@ bool EpollServer::Start() {
     return false;
   }
 
-  epoll_event ev{};
-  ev.events = EPOLLIN;
-  ev.data.fd = mListener.GetFd();
+  if (mListenEnabled) {
+    for (Listener &l : mListeners) {
+      epoll_event ev{};
+      ev.events = EPOLLIN;
+      ev.data.fd = l.socket.GetFd();
+
+      if (::epoll_ctl(mEpollFd, EPOLL_CTL_ADD, l.socket.GetFd(), &ev) < 0) {
+        std::perror("epoll_ctl ADD listener");
+        return false;
+      }
+    }
+  }
 
-  if (::epoll_ctl(mEpollFd, EPOLL_CTL_ADD, mListener.GetFd(), &ev) < 0) {
-    std::perror("epoll_ctl ADD listener");
+  mWakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (mWakeFd < 0) {
+    std::perror("eventfd");
     return false;
   }
 
+  epoll_event wakeEv{};
+  wakeEv.events = EPOLLIN;
+  wakeEv.data.fd = mWakeFd;
+  if (::epoll_ctl(mEpollFd, EPOLL_CTL_ADD, mWakeFd, &wakeEv) < 0) {
+    std::perror("epoll_ctl ADD wake");
+    return false;
+  }
+
+  // prewarm 은 Run 에서 (Start 는 보통 다른 스레드에서 불린다)
+  if (mPoolMaxCached != 0)
+    mSessionPool.emplace(mRecvBufSize, SessionSendBufSize(), mBufferMode,
+                         mSendBufferMode, mPoolMaxCached);
+
   mRunning = true;
   return true;
 }
 void EpollServer::UpdateWriteInterest(int fd, bool enable) {
-  epoll_event ev{};
-  ev.data.fd = fd;
-  ev.events = EPOLLIN | EPOLLERR | EPOLLHUP;
+  ConnSlot *slot = FindSlot(fd);
+  if (!slot || !slot->session)
+    return;
+  ConnState &st = slot->conn;
+  st.writeInterest = enable;
+  if (mTriggerMode == EpollTrigger_Level) {
+    if (!enable) {
+      if (st.outArmed) {
+        st.outArmed = false;
+        ApplyInterest(fd);
+      }
+      return;
+    }
+    if (!mDeferredFlush) {
+      st.outArmed = true;
+      ApplyInterest(fd);
+      return;
+    }
+    // dirty 목록에 올려 두고 이번 회차 끝에 한 번에 writev
+    SchedulePendingIo(fd, false, true);
+    return;
+  }
+  // edge 에서는 이미 writable 이면 새 edge 가 오지 않으므로 직접 flush 를 예약.
+  // oneshot 은 다음 re-arm 때 OUT 이 반영된다.
+  if (enable)
+    SchedulePendingIo(fd, false, true);
+}
+
+void EpollServer::UpdateReadInterest(int fd, bool enable) {
+  ConnSlot *slot = FindSlot(fd);
+  if (!slot || !slot->session)
+    return;
+  slot->conn.readPaused = !enable;
+  if (mTriggerMode == EpollTrigger_Level) {
+    ApplyInterest(fd);
+    return;
+  }
+  // 멈춰 있는 동안 socket 에 쌓인 데이터는 edge 가 이미 지나갔으므로 직접 읽는다.
   if (enable)
-    ev.events |= EPOLLOUT;
+    SchedulePendingIo(fd, true, false);
+}
+
+uint32_t EpollServer::BuildInterest(const ConnState &st) const {
+  uint32_t events = EPOLLERR | EPOLLHUP | EpollTriggerFlags(mTriggerMode);
+  if (mTriggerMode == EpollTrigger_Edge) {
+    // 한 번 등록으로 끝: 멈춘 읽기는 이벤트를 무시하는 것으로 처리
+    return events | EPOLLIN | EPOLLOUT;
+  }
+  if (!st.readPaused)
+    events |= EPOLLIN;
+  // level 은 실제로 막혔을 때만, oneshot 은 보낼 게 있으면 OUT
+  const bool wantOut = (mTriggerMode == EpollTrigger_Level) ? st.outArmed
+                                                            : st.writeInterest;
+  if (wantOut)
+    events |= EPOLLOUT;
+  return events;
+}
+
+void EpollServer::ApplyInterest(int fd) {
+  ConnSlot *slot = FindSlot(fd);
+  if (!slot || !slot->session)
+    return;
+
+  epoll_event ev{};
+  ev.data.u64 = MakeEventTag(fd, slot->generation);
+  ev.events = BuildInterest(slot->conn);
 
   ::epoll_ctl(mEpollFd, EPOLL_CTL_MOD, fd, &ev);
 }
 
-void EpollServer::HandleNewConnection() {
+void EpollServer::SchedulePendingIo(int fd, bool read, bool write) {
+  ConnSlot *slot = FindSlot(fd);
+  if (!slot || !slot->session)
+    return;
+  ConnState &st = slot->conn;
+  st.pendingRead |= read;
+  st.pendingWrite |= write;
+  if (!st.ioQueued) {
+    st.ioQueued = true;
+    mPendingIo.push_back(fd);
+  }
+}
+
+void EpollServer::ScheduleRetries(int fd, Session &sess) {
+  // level 모드는 남은 데이터가 있으면 epoll 이 계속 알려준다.
+  if (mTriggerMode == EpollTrigger_Level || !sess.IsOpen())
+    return;
+
+  ConnSlot *slot = FindSlot(fd);
+  if (!slot)
+    return;
+  const bool read = sess.NeedsReadRetry() && !slot->conn.readPaused;
+  const bool write = sess.NeedsWriteRetry();
+  if (read || write)
+    SchedulePendingIo(fd, read, write);
+}
+
+void EpollServer::ProcessPendingIo() {
+  // 처리 중에 새로 예약되는 fd 는 다음 회차로 넘긴다 (한 연결이 loop 를 붙잡지 않도록).
+  mPendingIoScratch.swap(mPendingIo);
+  for (int fd : mPendingIoScratch) {
+    ConnSlot *slot = FindSlot(fd);
+    if (!slot)
+      continue;
+    ConnState &st = slot->conn;
+    const bool read = st.pendingRead;
+    const bool write = st.pendingWrite;
+    st.pendingRead = false;
+    st.pendingWrite = false;
+    st.ioQueued = false;
+
+    if (!slot->session || !slot->session->IsOpen())
+      continue;
+    Session &sess = *slot->session;
+
+    if (write && WriteReady(*slot) == Session_SocketError)
+      continue;
+    if (read && sess.IsOpen() && !st.readPaused)
+      (void)ReadReady(*slot);
+
+    ScheduleRetries(fd, sess);
+    if (mTriggerMode == EpollTrigger_EdgeOneShot && sess.IsOpen())
+      ApplyInterest(fd);
+
+    // deferred flush 로 다 못 보냈으면 (EAGAIN / budget) 그때서야 EPOLLOUT 등록
+    if (mTriggerMode == EpollTrigger_Level && sess.IsOpen() &&
+        sess.HasPendingSend() && !st.outArmed) {
+      st.outArmed = true;
+      ApplyInterest(fd);
+    }
+  }
+  mPendingIoScratch.clear();
+}
+
+void EpollServer::SetBufferMode(eRingBufferMode mode) { mBufferMode = mode; }
+
+void EpollServer::SetSendBufferMode(eSendBufferMode mode,
+                                    size_t maxQueuedBytes) {
+  mSendBufferMode = mode;
+  mSendQueueLimit = maxQueuedBytes;
+}
+
+void EpollServer::SetZeroCopyThreshold(size_t bytes) {
+  mZeroCopyThreshold = bytes;
+}
+
+void EpollServer::SetReusePort(bool enable) {
+  mReusePort = enable;
+  for (Listener &l : mListeners)
+    l.socket.SetReusePort(enable);
+}
+
+void EpollServer::SetVerbose(bool verbose) { mVerbose = verbose; }
+
+void EpollServer::SetListenEnabled(bool enable) { mListenEnabled = enable; }
+
+void EpollServer::SetTriggerMode(eEpollTriggerMode mode) {
+  mTriggerMode = mode;
+}
+
+void EpollServer::SetIoBudget(size_t bytes) { mIoBudget = bytes; }
+
+void EpollServer::SetSessionPool(size_t maxCached, size_t prewarm) {
+  mPoolMaxCached = maxCached;
+  mPoolPrewarm = prewarm;
+}
+
+void EpollServer::SetLazyBuffers(bool lazy) { mLazyBuffers = lazy; }
+
+void EpollServer::SetDeferredFlush(bool enable) { mDeferredFlush = enable; }
+
+void EpollServer::SetProtocol(eServerProtocol protocol) {
+  mListeners[0].handler = MakeProtocolHandler(protocol);
+}
+
+void EpollServer::SetProtocolHandler(ProtocolHandler handler) {
+  mListeners[0].handler = std::move(handler);
+}
+
+void EpollServer::AddListener(uint16_t port, ProtocolHandler handler) {
+  Listener &l = mListeners.emplace_back(
+      Listener{ListenerSocket(port, 100), std::move(handler)});
+  l.socket.SetReusePort(mReusePort);
+}
+
+size_t EpollServer::SessionSendBufSize() const {
+  // Segmented 모드에서는 sendBufSize 대신 큐 상한을 넘긴다
+  return (mSendBufferMode == SendBufMode_Segmented) ? mSendQueueLimit
+                                                    : mSendBufSize;
+}
+
+void EpollServer::SetIdleTimeout(std::chrono::milliseconds timeout) {
+  mIdleTimeout = timeout;
+}
+
+void EpollServer::SetSendWatermarks(size_t low, size_t high) {
+  mSendLowWatermark = low;
+  mSendHighWatermark = high;
+}
+
+void EpollServer::ResumePausedSessions() {
+  // watermark 콜백은 send 경로 안에서 불리므로 recv 재처리는 이벤트 처리 후에 몰아서 한다.
+  for (std::size_t i = 0; i < mResumedFds.size(); ++i) {
+    ConnSlot *slot = FindSlot(mResumedFds[i]);
+    if (slot && slot->session && slot->session->IsOpen() &&
+        !slot->session->IsSendPaused())
+      DispatchRecv(HandlerOf(*slot), *slot->session, slot->conn.protocol);
+  }
+  mResumedFds.clear();
+}
+
+void EpollServer::HandleNewConnection(size_t listener) {
   for (;;) {
     Socket clientSocket;
-    eListenerSocketError acceptErr = mListener.Accept(clientSocket);
-    if (acceptErr == ListenerSocket_AcceptFailed) {
+    eListenerSocketError acceptErr =
+        mListeners[listener].socket.Accept(clientSocket);
+    if (acceptErr == ListenerSocket_WouldBlock ||
+        acceptErr == ListenerSocket_AcceptFailed) {
       break;
     } else if (acceptErr != ListenerSocket_Ok) {
       std::cerr << "Accept failed\n";
       break;
     }
 
-    clientSocket.SetBlocking(false);
-    auto session = std::make_unique<Session>(mRecvBufSize, mSendBufSize,
-                                             std::move(clientSocket));
-    if (session->Open(mRecvBufSize, mSendBufSize) != Session_Ok) {
-      continue;
-    }
-
-    int fd = session->Fd();
-
-    // Common TCP/IP Server
-    // session->SetRecvCallback([](Session& s, RecvBuffer& rb){
-    //     //TODO Handle RecvCallback
-    //     std::uint8_t buf[4096];
-
-    //     while (!rb.IsEmpty())
-    //     {
-    //         std::size_t readBytes = 0;
-    //         eRecvBufferError err = rb.Read(buf, sizeof(buf), readBytes);
-    //         if (err != RecvBuf_Ok || readBytes == 0)
-    //             break;
-
-    //         eSessionError se = s.QueueSend(buf, readBytes);
-    //         if (se != Session_Ok)
-    //         {
-    //             break;
-    //         }
-    //     }
-    // });
-
-    // HTTP Server
-    session->SetRecvCallback([this](Session &s, RecvBuffer &rb) {
-      auto &st = mHttpStates[s.Fd()];
-
-      while (true) {
-        HttpRequest req;
-        std::string perr;
-
-        std::cout << "[HTTP] recv callback fd=" << s.Fd() << "\n";
-
-
-        HttpParser::Result r = st.parser.TryParse(rb, req, &perr);
-
-        if (r == HttpParser::Result::Http_NeedMore)
-          break;
-
-        if (r == HttpParser::Result::Http_Error) {
-          HttpResponse resp;
-          resp.status = 400;
-          resp.reason = "Bad Request";
-          resp.SetTextBody("bad request");
-
-          auto bytes = BuildHttpResponseBytes(resp, /*keepAlive=*/false);
-          (void)s.QueueSend(bytes.data(), bytes.size());
-
-          st.closeAfterSend = true;
-          break;
-        }
-
-        // ---------- Connection: close 처리 ----------
-        bool keepAlive = true;
-        if (auto c = req.Header("connection")) {
-          std::string v(*c);
-          for (auto &ch : v)
-            ch = (char)std::tolower((unsigned char)ch);
-          if (v.find("close") != std::string::npos) {
-            keepAlive = false;
-            st.closeAfterSend = true;
-          }
-        }
-        // HTTP/1.0 기본 close 정책까지 반영하고 싶으면:
-        // if (req.version == "HTTP/1.0") keepAlive = false;
-
-        // ---------- 라우팅 (/health, /echo) ----------
-        HttpResponse resp;
-
-        if (req.method == "GET" && req.target == "/health") {
-          resp.status = 200;
-          resp.reason = "OK";
-          resp.SetTextBody("ok");
-        } else if (req.method == "POST" && req.target == "/echo") {
-          resp.status = 200;
-          resp.reason = "OK";
-          resp.headers["Content-Type"] = "application/octet-stream";
-          resp.body = std::move(req.body);
-        } else if (req.method == "GET" &&
-                   req.target.rfind("/echo?msg=", 0) == 0) {
-          std::string msg = req.target.substr(std::string("/echo?msg=").size());
-          resp.status = 200;
-          resp.reason = "OK";
-          resp.SetTextBody(msg);
-        } else {
-          resp.status = 404;
-          resp.reason = "Not Found";
-          resp.SetTextBody("not found");
-        }
-
-        auto bytes = BuildHttpResponseBytes(resp, keepAlive);
-        (void)s.QueueSend(bytes.data(), bytes.size());
-
-        // 루프 계속 → 같은 recv 덩어리 안에 다음 요청이 붙어왔으면 계속 파싱
-        // 가능
-        continue;
-      }
-    });
+    AdoptConnection(std::move(clientSocket), listener);
+  }
+}
 
-    // HTTP Server
-    session->SetSendCallback([this](Session &s, size_t /*sent*/) {
-      auto it = mHttpStates.find(s.Fd());
-      if (it == mHttpStates.end())
-        return;
+bool EpollServer::AdoptConnection(Socket &&clientSocket, size_t listener) {
+  clientSocket.SetBlocking(false);
+  const int fd = clientSocket.GetFd();
+  if (fd < 0)
+    return false;
 
-      // 마지막 바이트를 보낸 순간 sent 콜백이 오므로 여기서 비었는지 검사 가능
-      if (it->second.closeAfterSend && !s.HasPendingSend()) {
-        s.Close();
-      }
-    });
-    session->SetCloseCallback([this](Session &s) {
-      int fd = s.Fd();
-      ::epoll_ctl(mEpollFd, EPOLL_CTL_DEL, fd, nullptr);
-      mSessions.erase(fd);
-
-      //HTTP Server
-      mHttpStates.erase(fd);
-    });
-
-    // Common TCP/IP Server
-    // session->SetFrameCallback([](Session &s, const std::uint8_t *p,
-    //                              std::size_t n) { s.SendFrame(p, n); });
-    session->SetWriteInterestCallback([this](Session &s, bool enable) {
-       this->UpdateWriteInterest(s.Fd(), enable);
+  ConnSlot &slot = AcquireSlot(fd);
+  // 같은 fd 번호가 재사용된 경우 아직 정리되지 않은 이전 세션을 먼저 제거
+  if (slot.session) {
+    ReleaseSlot(slot);
+    mConnectionCount.fetch_sub(1, std::memory_order_relaxed);
+  }
+  ++slot.generation;
+
+  const size_t sendBufSize = SessionSendBufSize();
+  Session &session =
+      mSessionPool
+          ? slot.session.emplace(mSessionPool->Acquire(std::move(clientSocket)))
+          : slot.session.emplace(mRecvBufSize, sendBufSize,
+                                 std::move(clientSocket), mBufferMode,
+                                 mSendBufferMode);
+  if (session.Open(mRecvBufSize, sendBufSize) != Session_Ok) {
+    ReleaseSlot(slot);
+    return false;
+  }
+  if (mZeroCopyThreshold != 0 && mSendBufferMode == SendBufMode_Segmented) {
+    // 지원하지 않는 커널이면 복사 경로 그대로 사용
+    (void)session.EnableZeroCopy(mZeroCopyThreshold);
+  }
+  if (mSendHighWatermark != 0) {
+    session.SetSendWatermarks(mSendLowWatermark, mSendHighWatermark);
+  }
+  session.SetIoBudget(mIoBudget);
+  session.SetLazyBuffers(mLazyBuffers);
+
+  // slot 은 page 에 고정되어 있으므로 콜백이 주소를 잡아도 된다.
+  ConnState *state = &slot.conn;
+  // recv/send 콜백은 걸지 않는다: ReadReady/WriteReady 가 handler 로 직접 dispatch
+  state->listener = listener;
+  ResetProtocolState(HandlerOf(slot), state->protocol);
+
+  // Close 시점에는 socket 이 이미 닫혀 s.Fd() 가 -1 이므로 accept 때의 fd 를 캡처.
+  // 콜백은 Session 호출 스택 안에서 불리므로 삭제는 루프 끝(ReapClosedSessions)으로 미룬다.
+  session.SetCloseCallback([this, fd, state](Session &s) {
+    DispatchClose(mListeners[state->listener].handler, s, state->protocol);
+    ::epoll_ctl(mEpollFd, EPOLL_CTL_DEL, fd, nullptr);
+    mClosedFds.push_back(fd);
+  });
+
+  session.SetWatermarkCallback([this, fd](Session & /*s*/, bool aboveHigh) {
+    UpdateReadInterest(fd, !aboveHigh);
+    if (!aboveHigh)
+      mResumedFds.push_back(fd);
+  });
+  session.SetWriteInterestCallback([this](Session &s, bool enable) {
+     this->UpdateWriteInterest(s.Fd(), enable);
+     if (mVerbose)
        std::cout << "[HTTP] write interest " << (enable ? "ON" : "OFF")
-          << " fd=" << s.Fd() << "\n";
-    });
+                 << " fd=" << s.Fd() << "\n";
+  });
 
-    epoll_event ev{};
-    ev.events = EPOLLIN | EPOLLERR | EPOLLHUP;
-    ev.data.fd = session->Fd();
+  state->idleTimer.userData = static_cast<std::uint64_t>(fd);
 
-    if (::epoll_ctl(mEpollFd, EPOLL_CTL_ADD, fd, &ev) < 0) {
-      std::perror("epoll_ctl ADD client");
-      continue;
+  epoll_event ev{};
+  ev.events = BuildInterest(*state);
+  ev.data.u64 = MakeEventTag(fd, slot.generation);
+
+  if (::epoll_ctl(mEpollFd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+    std::perror("epoll_ctl ADD client");
+    ReleaseSlot(slot);
+    return false;
+  }
+
+  mIdleTimers.Schedule(state->idleTimer, mIdleTimeout);
+  mConnectionCount.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+bool EpollServer::EnqueueConnection(Socket &&clientSocket) {
+  if (mWakeFd < 0)
+    return false;
+
+  mPendingHandoffs.fetch_add(1, std::memory_order_relaxed);
+  mIncoming.Push(std::move(clientSocket));
+
+  const std::uint64_t one = 1;
+  (void)::write(mWakeFd, &one, sizeof(one));
+  return true;
+}
+
+void EpollServer::DrainIncoming() {
+  Socket clientSocket;
+  while (mIncoming.TryPop(clientSocket)) {
+    mPendingHandoffs.fetch_sub(1, std::memory_order_relaxed);
+    AdoptConnection(std::move(clientSocket), 0);
+  }
+}
+
+size_t EpollServer::LoadEstimate() const noexcept {
+  return mConnectionCount.load(std::memory_order_relaxed) +
+         mPendingHandoffs.load(std::memory_order_relaxed);
+}
+
+size_t EpollServer::ConnectionCount() const noexcept {
+  return mConnectionCount.load(std::memory_order_relaxed);
+}
+
+EpollServer::ConnSlot *EpollServer::FindSlot(int fd) noexcept {
+  if (fd < 0)
+    return nullptr;
+  const size_t page = static_cast<size_t>(fd) >> kSlotPageBits;
+  if (page >= mSlotPages.size() || !mSlotPages[page])
+    return nullptr;
+  return &mSlotPages[page][fd & (kSlotPageSize - 1)];
+}
+
+EpollServer::ConnSlot &EpollServer::AcquireSlot(int fd) {
+  const size_t page = static_cast<size_t>(fd) >> kSlotPageBits;
+  if (page >= mSlotPages.size())
+    mSlotPages.resize(page + 1);
+  if (!mSlotPages[page])
+    mSlotPages[page] = std::make_unique<ConnSlot[]>(kSlotPageSize);
+  return mSlotPages[page][fd & (kSlotPageSize - 1)];
+}
+
+Session *EpollServer::FindSession(int fd) noexcept {
+  ConnSlot *slot = FindSlot(fd);
+  if (!slot || !slot->session || !slot->session->IsOpen())
+    return nullptr;
+  return &*slot->session;
+}
+
+void EpollServer::ReleaseSlot(ConnSlot &slot) {
+  // generation 은 유지해서 다음 연결이 이어서 증가시킨다.
+  if (slot.session && mSessionPool)
+    mSessionPool->Release(std::move(*slot.session));
+  slot.session.reset();
+  ConnState &st = slot.conn;
+  mIdleTimers.Cancel(st.idleTimer);
+  ResetProtocolState(HandlerOf(slot), st.protocol);
+  st.readPaused = false;
+  st.writeInterest = false;
+  st.outArmed = false;
+  st.pendingRead = false;
+  st.pendingWrite = false;
+  st.ioQueued = false;
+}
+
+uint64_t EpollServer::MakeEventTag(int fd, uint32_t generation) noexcept {
+  return (static_cast<uint64_t>(generation) << 32) |
+         static_cast<uint32_t>(fd);
+}
+
+void EpollServer::ReapClosedSessions() {
+  for (int fd : mClosedFds) {
+    ConnSlot *slot = FindSlot(fd);
+    if (slot && slot->session && !slot->session->IsOpen()) {
+      ReleaseSlot(*slot);
+      mConnectionCount.fetch_sub(1, std::memory_order_relaxed);
     }
+  }
+  mClosedFds.clear();
+}
+
+const ProtocolHandler &
+EpollServer::HandlerOf(const ConnSlot &slot) const noexcept {
+  return mListeners[slot.conn.listener].handler;
+}
 
-    mSessions.emplace(fd, std::move(session));
+size_t EpollServer::FindListener(int fd) const noexcept {
+  for (size_t i = 0; i < mListeners.size(); ++i) {
+    if (mListeners[i].socket.GetFd() == fd)
+      return i;
   }
+  return SIZE_MAX;
 }
 
-void EpollServer::HandleClientEvent(int fd, uint32_t events) {
-  auto it = mSessions.find(fd);
-  if (it == mSessions.end())
+eSessionError EpollServer::ReadReady(ConnSlot &slot) {
+  Session &sess = *slot.session;
+  const eSessionError r = sess.OnReadable();
+  DispatchRecv(HandlerOf(slot), sess, slot.conn.protocol);
+  return r;
+}
+
+eSessionError EpollServer::WriteReady(ConnSlot &slot) {
+  Session &sess = *slot.session;
+  const eSessionError w = sess.OnWritable();
+  if (sess.IsOpen() && !sess.HasPendingSend())
+    DispatchWritableDrained(HandlerOf(slot), sess, slot.conn.protocol);
+  return w;
+}
+
+void EpollServer::HandleClientEvent(uint64_t tag, uint32_t events) {
+  const int fd = static_cast<int>(static_cast<uint32_t>(tag));
+  const uint32_t generation = static_cast<uint32_t>(tag >> 32);
+
+  // 같은 epoll_wait 결과 안에서 닫히고 fd 가 재사용된 경우 이전 연결의 이벤트는 버린다.
+  ConnSlot *slot = FindSlot(fd);
+  if (!slot || !slot->session || slot->generation != generation)
     return;
 
-  Session &sess = *(it->second);
+  Session &sess = *slot->session;
+  ConnState &cs = slot->conn;
 
-  if (events & (EPOLLERR | EPOLLHUP)) {
+  // 이벤트가 온 연결만 idle timer 를 다시 건다 (O(1))
+  mIdleTimers.Schedule(cs.idleTimer, mIdleTimeout);
+
+  if (events & EPOLLHUP) {
     sess.Close();
     return;
   }
 
-  if (events & EPOLLIN) {
-    eSessionError r = sess.OnReadable();
+  // zerocopy 완료 통지도 EPOLLERR 로 오므로 바로 닫지 않고 error queue 부터 회수
+  if (events & EPOLLERR) {
+    if (sess.OnError() != Session_Ok) {
+      return;
+    }
+  }
+
+  // edge 모드에서는 IN 을 끄지 않으므로 멈춘 동안의 이벤트는 무시 (재개 시 SchedulePendingIo)
+  if ((events & EPOLLIN) && !cs.readPaused) {
+    eSessionError r = ReadReady(*slot);
     if (r == Session_PeerClosed || r == Session_SocketError ||
         r == Session_RecvBufferError) {
       return;
@@ -230,22 +539,41 @@ void EpollServer::HandleClientEvent(int fd, uint32_t events) {
   }
 
   if (events & EPOLLOUT) {
-    eSessionError w = sess.OnWritable();
+    eSessionError w = WriteReady(*slot);
     if (w == Session_SocketError) {
       return;
     }
   }
+
+  ScheduleRetries(fd, sess);
+  if (mTriggerMode == EpollTrigger_EdgeOneShot && sess.IsOpen())
+    ApplyInterest(fd);
 }
 
 void EpollServer::Run() {
   constexpr int MAX_EVENTS = 64;
   epoll_event events[MAX_EVENTS];
 
-  constexpr auto kIdleTimeout = std::chrono::seconds(30);
-  constexpr int kTickMs = 1000;
+  // 타이머가 없을 때도 Stop() 을 확인할 수 있도록 대기 상한을 둔다.
+  constexpr int kMaxWaitMs = 1000;
+  // 닫힌 연결의 zerocopy 완료 통지는 epoll 에 걸려 있지 않으므로 자주 확인한다
+  constexpr int kLingerWaitMs = 10;
+  ZeroCopyLinger &linger = ZeroCopyLinger::Local();
+
+  // Segmented 송신 큐는 만든 스레드의 SegmentPool::Local() 에 묶이므로 세션은 이 loop 스레드에서 만든다.
+  // Start 를 부른 스레드에서 만들면 모든 reactor 가 그 스레드의 pool 을 동시에 쓰게 된다.
+  if (mSessionPool)
+    mSessionPool->Reserve(mPoolPrewarm);
 
   while (mRunning) {
-    int n = ::epoll_wait(mEpollFd, events, MAX_EVENTS, kTickMs);
+    // edge 모드에서 budget 때문에 남겨둔 일이 있으면 기다리지 않고 이벤트만 확인
+    const int timeoutMs =
+        (!mPendingIo.empty() || !mResumedFds.empty())
+            ? 0
+            : mIdleTimers.NextTimeoutMs(TimingWheel::Clock::now(),
+                                        linger.Count() != 0 ? kLingerWaitMs
+                                                            : kMaxWaitMs);
+    int n = ::epoll_wait(mEpollFd, events, MAX_EVENTS, timeoutMs);
     if (n < 0) {
       if (errno == EINTR)
         continue;
@@ -254,37 +582,66 @@ void EpollServer::Run() {
     }
 
     for (int i = 0; i < n; ++i) {
-      int fd = events[i].data.fd;
+      // listener/wake 는 data.fd, 클라이언트는 generation 이 붙은 data.u64
+      const uint64_t tag = events[i].data.u64;
+      const int fd = static_cast<int>(static_cast<uint32_t>(tag));
       uint32_t ev = events[i].events;
 
-      if (fd == mListener.GetFd()) {
-        HandleNewConnection();
+      const size_t listener = mListenEnabled ? FindListener(fd) : SIZE_MAX;
+      if (listener != SIZE_MAX) {
+        HandleNewConnection(listener);
+      } else if (fd == mWakeFd) {
+        // Stop() 또는 acceptor 의 연결 전달
+        std::uint64_t value = 0;
+        (void)::read(mWakeFd, &value, sizeof(value));
+        DrainIncoming();
       } else {
-        HandleClientEvent(fd, ev);
+        HandleClientEvent(tag, ev);
       }
     }
 
-    const auto now = std::chrono::steady_clock::now();
-    for (auto it = mSessions.begin(); it != mSessions.end();) {
-      Session &s = *(it->second);
-      if (s.IsIdleTimeout(std::chrono::duration_cast<std::chrono::milliseconds>(
-              kIdleTimeout))) {
-        auto victim = it++;
-        victim->second->Close();
-        continue;
-      }
-
-      it++;
-    }
+    ProcessPendingIo();
+    ResumePausedSessions();
+    ExpireIdleSessions();
+    ReapClosedSessions();
+    linger.Poll();
   }
+
+  // loop 스레드 안에서 정리 (Stop 은 다른 스레드에서 불릴 수 있으므로 자원을 건드리지 않음)
+  Shutdown();
+}
+
+void EpollServer::ExpireIdleSessions() {
+  // 만료된 slot 의 세션만 방문. Close 는 close 콜백을 통해 ReapClosedSessions 에서 정리된다.
+  mIdleTimers.Advance(TimingWheel::Clock::now(), [this](TimerNode &node) {
+    Session *sess = FindSession(static_cast<int>(node.userData));
+    if (sess)
+      sess->Close();
+  });
 }
 
 void EpollServer::Stop() {
   mRunning = false;
-  if (mEpollFd >= 0) {
-    ::close(mEpollFd);
-    mEpollFd = -1;
+  if (mWakeFd >= 0) {
+    const std::uint64_t one = 1;
+    (void)::write(mWakeFd, &one, sizeof(one));
+  }
+}
+
+void EpollServer::Shutdown() {
+  for (Listener &l : mListeners)
+    l.socket.Close();
+  for (auto &page : mSlotPages) {
+    if (!page)
+      continue;
+    for (int i = 0; i < kSlotPageSize; ++i)
+      ReleaseSlot(page[i]);
   }
-  mListener.Close();
-  mSessions.clear();
+  if (mSessionPool)
+    mSessionPool->Trim();
+  mConnectionCount.store(0, std::memory_order_relaxed);
+  mClosedFds.clear();
+  mResumedFds.clear();
+  mPendingIo.clear();
+  mPendingIoScratch.clear();
 }
@@ -0,0 +1,209 @@
+#include "HttpService.h"
+#include <charconv>
+#include <cstdio>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+bool ContainsIgnoreCase(std::string_view haystack, std::string_view needle) {
+  for (size_t i = 0; i + needle.size() <= haystack.size(); ++i) {
+    if (EqualsIgnoreCase(haystack.substr(i, needle.size()), needle))
+      return true;
+  }
+  return false;
+}
+
+} // namespace
+
+void HttpService::SetZeroCopyThreshold(size_t bytes) {
+  mZeroCopyThreshold = bytes;
+}
+
+void HttpService::SetVerbose(bool verbose) { mVerbose = verbose; }
+
+// TryParseStream 에서 요청 조각을 받아 응답으로 바꾼다. OnRecv 마다 stack 에 만들고,
+// 요청 사이에 남는 상태는 HttpSessionState 에 둔다.
+class HttpService::StreamExchange final : public HttpStreamHandler {
+public:
+  StreamExchange(const HttpService &service, Session &s, HttpSessionState &st)
+      : mService(service), mSession(s), mState(st) {}
+
+  void OnHeaders(const HttpRequestView &req) override {
+    mState.inBody = true;
+
+    // ---------- Connection: close 처리 ----------
+    bool keepAlive = true;
+    if (auto c = req.Header(HttpHeader::Connection)) {
+      if (ContainsIgnoreCase(*c, "close")) {
+        keepAlive = false;
+        mState.closeAfterSend = true;
+      }
+    }
+    // HTTP/1.0 기본 close 정책까지 반영하고 싶으면:
+    // if (req.version == "HTTP/1.0") keepAlive = false;
+
+    if (req.method == "POST" && req.target == "/echo") {
+      // body 를 모으지 않고 도착하는 대로 돌려보냄. 길이를 알면 그대로, 모르면 chunked 로
+      HttpResponse resp;
+      resp.headers["Content-Type"] = "application/octet-stream";
+      // parser 가 Transfer-Encoding(chunked 만) 과 Content-Length 값을 이미 검증함
+      std::optional<size_t> length = 0;
+      if (req.Header(HttpHeader::TransferEncoding)) {
+        length = std::nullopt;
+      } else if (auto cl = req.Header(HttpHeader::ContentLength)) {
+        size_t n = 0;
+        std::from_chars(cl->data(), cl->data() + cl->size(), n);
+        length = n;
+      }
+
+      mState.echoBody = true;
+      mState.chunkedReply = !length.has_value();
+      const auto head = BuildHttpStreamHead(resp, keepAlive, length);
+      if (mSession.QueueSend(head.data(), head.size()) != Session_Ok)
+        mSession.Close();
+      return;
+    }
+
+    // 나머지 route 는 body 를 쓰지 않으므로 header 만으로 응답하고 body 는 버림
+    HttpResponse resp;
+    Route(req, resp);
+    if (!mService.QueueResponse(mSession, resp, keepAlive)) {
+      // 송신 큐 상한을 넘는 응답: 더 보낼 방법이 없으므로 연결 종료
+      mSession.Close();
+    }
+  }
+
+  bool OnBodyChunk(std::string_view data) override {
+    if (mState.echoBody && mSession.IsOpen()) {
+      bool ok = true;
+      if (mState.chunkedReply) {
+        char size[24];
+        const int n = std::snprintf(size, sizeof(size), "%zx\r\n", data.size());
+        ok = mSession.QueueSend(size, static_cast<size_t>(n)) == Session_Ok &&
+             mService.QueueBody(mSession, data) &&
+             mSession.QueueSend("\r\n", 2) == Session_Ok;
+      } else {
+        ok = mService.QueueBody(mSession, data);
+      }
+      if (!ok)
+        mSession.Close();
+    }
+    // 송신 큐가 high watermark 를 넘으면 남은 body 는 recv buffer 에 둠 (watermark 콜백이 다시 부름)
+    return mSession.IsOpen() && !mSession.IsSendPaused();
+  }
+
+  void OnBodyEnd() override {
+    if (mState.echoBody && mState.chunkedReply && mSession.IsOpen() &&
+        mSession.QueueSend("0\r\n\r\n", 5) != Session_Ok)
+      mSession.Close();
+    mState.inBody = false;
+    mState.echoBody = false;
+    mState.chunkedReply = false;
+    // 응답이 body 보다 먼저 다 나갔으면 OnSent 가 더 오지 않으므로 여기서 닫음
+    if (mState.closeAfterSend && mSession.IsOpen() &&
+        !mSession.HasPendingSend())
+      mSession.Close();
+  }
+
+private:
+  const HttpService &mService;
+  Session &mSession;
+  HttpSessionState &mState;
+};
+
+void HttpService::OnRecv(Session &s, RecvBuffer &rb,
+                         HttpSessionState &st) const {
+  StreamExchange exchange(*this, s, st);
+  while (s.IsOpen()) {
+    // 상대가 응답을 읽지 않고 요청만 밀어넣는 경우: 큐가 빠질 때까지 파싱 중단
+    if (s.IsSendPaused())
+      break;
+
+    if (mVerbose)
+      std::cout << "[HTTP] recv callback fd=" << s.Fd() << "\n";
+
+    std::string perr;
+    const HttpParser::Result r = st.parser.TryParseStream(rb, exchange, &perr);
+    if (r == HttpParser::Result::Http_NeedMore)
+      break;
+
+    if (r != HttpParser::Result::Http_Ok) {
+      if (st.inBody) {
+        // 응답을 이미 보내기 시작했으므로 400 을 끼워 넣을 수 없음
+        st.inBody = false;
+        st.closeAfterSend = true;
+        if (!s.HasPendingSend())
+          s.Close();
+        break;
+      }
+
+      HttpResponse resp;
+      resp.status = 400;
+      resp.reason = "Bad Request";
+      resp.SetTextBody("bad request");
+
+      st.closeAfterSend = true;
+      if (!QueueResponse(s, resp, /*keepAlive=*/false))
+        s.Close();
+      break;
+    }
+
+    // 루프 계속 → 같은 recv 덩어리 안에 다음 요청이 붙어왔으면 계속 파싱 가능
+  }
+}
+
+void HttpService::OnSent(Session &s, HttpSessionState &st) const {
+  // 마지막 바이트를 보낸 순간 sent 콜백이 오므로 여기서 비었는지 검사 가능.
+  // body 를 다 받기 전이면 기다림: 상대가 보내는 중에 닫으면 RST 로 응답이 잘림
+  if (st.closeAfterSend && !st.inBody && !s.HasPendingSend()) {
+    s.Close();
+  }
+}
+
+void HttpService::Route(const HttpRequestView &req, HttpResponse &resp) {
+  // ---------- 라우팅 (/health, /echo?msg=) ----------
+  // POST /echo 는 body 를 흘려 보내야 하므로 StreamExchange::OnHeaders 가 먼저 처리한다
+  constexpr std::string_view kEchoQuery = "/echo?msg=";
+  if (req.method == "GET" && req.target == "/health") {
+    resp.status = 200;
+    resp.reason = "OK";
+    resp.SetTextBody("ok");
+  } else if (req.method == "GET" && req.target.rfind(kEchoQuery, 0) == 0) {
+    resp.status = 200;
+    resp.reason = "OK";
+    resp.SetTextBody(req.target.substr(kEchoQuery.size()));
+  } else {
+    resp.status = 404;
+    resp.reason = "Not Found";
+    resp.SetTextBody("not found");
+  }
+}
+
+bool HttpService::QueueResponse(Session &s, HttpResponse &resp,
+                                bool keepAlive) const {
+  // 큰 body 는 복사 없이 참조로 넣어서 MSG_ZEROCOPY 경로를 타게 함
+  if (s.IsZeroCopyEnabled() && resp.body.size() >= mZeroCopyThreshold) {
+    auto head = BuildHttpResponseHead(resp, keepAlive);
+    if (s.QueueSend(head.data(), head.size()) != Session_Ok)
+      return false;
+    return s.QueueSendShared(MakeSharedBuffer(std::move(resp.body))) ==
+           Session_Ok;
+  }
+
+  auto bytes = BuildHttpResponseBytes(resp, keepAlive);
+  return s.QueueSend(bytes.data(), bytes.size()) == Session_Ok;
+}
+
+bool HttpService::QueueBody(Session &s, std::string_view data) const {
+  // QueueResponse 와 같은 기준. 조각은 recv buffer 를 가리키므로 zerocopy 는 한 번 복사해 넘긴다
+  if (s.IsZeroCopyEnabled() && mZeroCopyThreshold > 0 &&
+      data.size() >= mZeroCopyThreshold)
+    return s.QueueSendShared(MakeSharedBuffer(
+               std::vector<std::uint8_t>(data.begin(), data.end()))) ==
+           Session_Ok;
+  return s.QueueSend(data.data(), data.size()) == Session_Ok;
+}
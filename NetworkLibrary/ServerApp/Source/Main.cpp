@@ -1,8 +1,108 @@
-#include "EpollServer.h"
+#include "AcceptorServer.h"
+#include "MultiReactorServer.h"
+#include "SlabAllocator.h"
+#include "UringServer.h"
 
-int main()
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+static eEpollTriggerMode gTriggerMode = EpollTrigger_Level;
+// reuseport 모드에서 같은 loop 가 HTTP(8080) 와 함께 받는 framed echo port
+static constexpr uint16_t kFramedEchoPort = 9090;
+
+static eEpollTriggerMode ParseTriggerMode(const char *name)
+{
+    if (std::strcmp(name, "edge") == 0)
+        return EpollTrigger_Edge;
+    if (std::strcmp(name, "oneshot") == 0)
+        return EpollTrigger_EdgeOneShot;
+    return EpollTrigger_Level;
+}
+
+static void ConfigureReactor(EpollServer &reactor)
 {
-    EpollServer server(8080, 64 * 1024, 64 * 1024); // recv/send buf size 예시
+    // 큰 응답도 보낼 수 있도록 송신은 segment 체인 사용 (연결당 최대 16MB)
+    reactor.SetSendBufferMode(SendBufMode_Segmented, 16 * 1024 * 1024);
+    reactor.SetZeroCopyThreshold(Session::kDefaultZeroCopyThreshold);
+    // 응답을 읽지 않는 클라이언트는 4MB 쌓이면 요청 처리를 멈추고 1MB 아래로 빠지면 재개
+    reactor.SetSendWatermarks(1 * 1024 * 1024, 4 * 1024 * 1024);
+    // 짧은 연결이 반복돼도 accept 경로에서 버퍼 할당이 없도록 닫힌 세션을 재사용
+    reactor.SetSessionPool(1024, 64);
+    // keep-alive 로 놀고 있는 연결은 recv ring 을 들고 있지 않음
+    reactor.SetLazyBuffers(true);
+    reactor.SetTriggerMode(gTriggerMode);
+    // 파이프라인된 응답을 모아 loop 회차당 writev 한 번, EPOLLOUT 은 막혔을 때만
+    reactor.SetDeferredFlush(true);
+    // edge 모드에서 큰 업로드/다운로드 하나가 다른 연결을 굶기지 않도록 wakeup 당 256KB 까지만 처리
+    if (gTriggerMode != EpollTrigger_Level)
+        reactor.SetIoBudget(256 * 1024);
+}
+
+static std::unique_ptr<ServerLoop> MakeUringReactor(size_t /*index*/)
+{
+    auto reactor = std::make_unique<UringServer>(8080, 64 * 1024, 64 * 1024);
+    reactor->SetReusePort(true);
+    // epoll reactor 와 같은 송신 큐 / backpressure / idle 정책 (zerocopy 는 epoll 전용)
+    reactor->SetSendBufferMode(SendBufMode_Segmented, 16 * 1024 * 1024);
+    reactor->SetSendWatermarks(1 * 1024 * 1024, 4 * 1024 * 1024);
+    reactor->SetLazyBuffers(true);
+    return reactor;
+}
+
+int main(int argc, char **argv)
+{
+    // ServerApp [reactor 수] [reuseport|acceptor|uring] [level|edge|oneshot]
+    // reuseport: reactor 마다 SO_REUSEPORT listener (기본)
+    // acceptor : accept 전용 스레드가 least-connections 로 worker 에 분배
+    // uring    : reuseport 와 같은 배치에 epoll 대신 io_uring loop (multishot accept/recv, linked send)
+    // reuseport 모드는 9090 에서 framed echo 도 같은 reactor 로 받는다
+    size_t reactors = std::thread::hardware_concurrency();
+    if (argc > 1)
+        reactors = static_cast<size_t>(std::strtoul(argv[1], nullptr, 10));
+    const bool useAcceptor = (argc > 2 && std::strcmp(argv[2], "acceptor") == 0);
+    bool useUring = (argc > 2 && std::strcmp(argv[2], "uring") == 0);
+    if (argc > 3)
+        gTriggerMode = ParseTriggerMode(argv[3]);
+
+    // 연결 버퍼를 2MB 정렬 chunk 에 모아 THP 로 TLB miss 를 줄인다
+    SlabAllocator::Global().SetBacking(SlabBacking_TransparentHuge);
+
+    if (useUring && !IoUring::IsSupported())
+    {
+        std::cerr << "io_uring unavailable, falling back to epoll\n";
+        useUring = false;
+    }
+
+    if (useUring)
+    {
+        MultiReactorServer server(reactors, MakeUringReactor);
+        if (!server.Start())
+            return 1;
+
+        server.Run();
+        return 0;
+    }
+
+    if (useAcceptor)
+    {
+        AcceptorServer server(8080, reactors, 64 * 1024, 64 * 1024);
+        server.ForEachWorker(ConfigureReactor);
+        server.SetStatsLogInterval(std::chrono::seconds(10));
+
+        if (!server.Start())
+            return 1;
+
+        server.Run();
+        return 0;
+    }
+
+    MultiReactorServer server(8080, reactors, 64 * 1024, 64 * 1024); // recv/send buf size 예시
+    server.ForEachReactor([](EpollServer &reactor) {
+        ConfigureReactor(reactor);
+        reactor.AddListener(kFramedEchoPort, FramedEchoHandler{});
+    });
 
     if (!server.Start())
         return 1;
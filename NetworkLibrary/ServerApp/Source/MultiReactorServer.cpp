@@ -0,0 +1,76 @@
+#include "MultiReactorServer.h"
+#include <iostream>
+
+MultiReactorServer::MultiReactorServer(uint16_t port, size_t reactorCount,
+                                       size_t recvBufSize, size_t sendBufSize) {
+  if (reactorCount == 0)
+    reactorCount = 1;
+
+  mReactors.reserve(reactorCount);
+  for (size_t i = 0; i < reactorCount; ++i) {
+    auto reactor = std::make_unique<EpollServer>(port, recvBufSize, sendBufSize);
+    reactor->SetReusePort(true);
+    mEpollReactors.push_back(reactor.get());
+    mReactors.push_back(std::move(reactor));
+  }
+}
+
+MultiReactorServer::MultiReactorServer(size_t reactorCount,
+                                       const LoopFactory &factory) {
+  if (reactorCount == 0)
+    reactorCount = 1;
+
+  mReactors.reserve(reactorCount);
+  for (size_t i = 0; i < reactorCount; ++i)
+    mReactors.push_back(factory(i));
+}
+
+MultiReactorServer::~MultiReactorServer() {
+  Stop();
+  for (auto &t : mThreads) {
+    if (t.joinable())
+      t.join();
+  }
+}
+
+void MultiReactorServer::ForEachReactor(
+    const std::function<void(EpollServer &)> &fn) {
+  for (EpollServer *reactor : mEpollReactors)
+    fn(*reactor);
+}
+
+bool MultiReactorServer::Start() {
+  for (size_t i = 0; i < mReactors.size(); ++i) {
+    if (!mReactors[i]->Start()) {
+      std::cerr << "Reactor " << i << " start failed\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+void MultiReactorServer::Run() {
+  for (size_t i = 1; i < mReactors.size(); ++i) {
+    ServerLoop *reactor = mReactors[i].get();
+    mThreads.emplace_back([reactor] { reactor->Run(); });
+  }
+
+  mReactors[0]->Run();
+
+  // 한 reactor 가 끝나면 나머지도 같이 내린다.
+  Stop();
+  for (auto &t : mThreads) {
+    if (t.joinable())
+      t.join();
+  }
+  mThreads.clear();
+}
+
+void MultiReactorServer::Stop() {
+  for (auto &reactor : mReactors)
+    reactor->Stop();
+}
+
+size_t MultiReactorServer::ReactorCount() const noexcept {
+  return mReactors.size();
+}
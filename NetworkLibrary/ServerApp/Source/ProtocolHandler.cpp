@@ -0,0 +1,117 @@
+#include "ProtocolHandler.h"
+#include "MessageFramer.h"
+#include <type_traits>
+
+namespace {
+
+// handler 와 같은 자리의 state 를 꺼내 fn(handler, state) 호출.
+// ResetProtocolState 가 항상 짝을 맞춰 두므로 get_if 는 실패하지 않는다.
+template <typename Fn>
+void Visit(const ProtocolHandler &handler, ProtocolState &state, Fn &&fn) {
+  std::visit(
+      [&](const auto &h) {
+        using State = typename std::decay_t<decltype(h)>::State;
+        fn(h, *std::get_if<State>(&state));
+      },
+      handler);
+}
+
+template <typename Handler>
+void RecvFrames(const Handler &h, Session &s, typename Handler::State &st) {
+  Frame f;
+  // 송신 큐가 high watermark 를 넘으면 더 처리하지 않고 recv buffer 에 남겨 둠
+  while (!s.IsSendPaused() && s.IsOpen()) {
+    const eFrameError r = MessageFramer::PopFrame(s.RecvBuf(), f);
+    if (r == eFrameError::Framer_Ok) {
+      h.OnFrame(s, f.payload.data(), f.payload.size(), st);
+      continue;
+    }
+    if (r != eFrameError::Framer_NeedMore)
+      s.Close();
+    break;
+  }
+}
+
+} // namespace
+
+ProtocolHandler MakeProtocolHandler(eServerProtocol protocol) {
+  if (protocol == ServerProtocol_FramedEcho)
+    return FramedEchoHandler{};
+  return HttpHandler{};
+}
+
+void ConfigureHttp(ProtocolHandler &handler, size_t zeroCopyThreshold,
+                   bool verbose) {
+  if (HttpHandler *http = std::get_if<HttpHandler>(&handler)) {
+    http->service.SetZeroCopyThreshold(zeroCopyThreshold);
+    http->service.SetVerbose(verbose);
+  }
+}
+
+void ResetProtocolState(const ProtocolHandler &handler, ProtocolState &state) {
+  std::visit(
+      [&](const auto &h) {
+        using State = typename std::decay_t<decltype(h)>::State;
+        if (State *st = std::get_if<State>(&state))
+          st->Reset();
+        else
+          state.emplace<State>();
+      },
+      handler);
+}
+
+void DispatchRecv(const ProtocolHandler &handler, Session &session,
+                  ProtocolState &state) {
+  if (!session.IsOpen())
+    return;
+  Visit(handler, state, [&](const auto &h, auto &st) {
+    if constexpr (std::decay_t<decltype(h)>::kFramed)
+      RecvFrames(h, session, st);
+    else
+      h.OnData(session, session.RecvBuf(), st);
+  });
+  if (!session.IsOpen())
+    return;
+
+  RecvBuffer &rb = session.RecvBuf();
+  // 소비 후에도 ring 이 가득 차 있으면 더 읽을 수 없음 (ring 보다 큰 요청/프레임)
+  if (rb.IsFull() && !session.IsSendPaused()) {
+    session.Close();
+    return;
+  }
+  rb.ReleaseIdleStorage();
+}
+
+void DispatchWritableDrained(const ProtocolHandler &handler, Session &session,
+                             ProtocolState &state) {
+  Visit(handler, state,
+        [&](const auto &h, auto &st) { h.OnWritableDrained(session, st); });
+}
+
+void DispatchClose(const ProtocolHandler &handler, Session &session,
+                   ProtocolState &state) {
+  Visit(handler, state,
+        [&](const auto &h, auto &st) { h.OnClose(session, st); });
+}
+
+void BindSessionCallbacks(const ProtocolHandler &handler, Session &session,
+                          ProtocolState &state) {
+  Visit(handler, state, [&](const auto &h, auto &st) {
+    using Handler = std::decay_t<decltype(h)>;
+    const Handler *hp = &h;
+    auto *sp = &st;
+    if constexpr (Handler::kFramed) {
+      session.SetFrameCallback(
+          [hp, sp](Session &s, const std::uint8_t *p, std::size_t n) {
+            hp->OnFrame(s, p, n, *sp);
+          });
+    } else {
+      session.SetRecvCallback(
+          [hp, sp](Session &s, RecvBuffer &rb) { hp->OnData(s, rb, *sp); });
+    }
+    session.SetSendCallback([hp, sp](Session &s, size_t /*sent*/) {
+      if (!s.HasPendingSend())
+        hp->OnWritableDrained(s, *sp);
+    });
+  });
+}
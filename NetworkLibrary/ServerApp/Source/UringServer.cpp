@@ -0,0 +1,610 @@
+#include "UringServer.h"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace {
+// user_data: 연결 요청은 Conn 주소 | op (하위 3bit), 나머지는 주소 없이 고정 값
+constexpr std::uint64_t kOpMask = 0x7;
+constexpr std::uint64_t kTagAccept = 3;
+constexpr std::uint64_t kTagWake = 4;
+constexpr std::uint64_t kTagIgnore = 5; // cancel 요청 자체의 완료
+
+// 타이머가 없을 때도 Stop() 을 확인할 수 있도록 대기 상한을 둔다.
+constexpr int kMaxWaitMs = 1000;
+constexpr unsigned kCqeBatch = 256;
+} // namespace
+
+UringServer::UringServer(uint16_t port, size_t recvBufSize, size_t sendBufSize)
+    : mListener(port, 100), mRecvBufSize(recvBufSize),
+      mSendBufSize(sendBufSize) {}
+
+UringServer::~UringServer() {
+  Stop();
+  Shutdown();
+  if (mWakeFd != -1) {
+    close(mWakeFd);
+    mWakeFd = -1;
+  }
+}
+
+bool UringServer::Start() {
+  ConfigureHttp(mHandler, 0, mVerbose);
+  const eIoUringError ringErr = mRing.Open(mRingEntries);
+  if (ringErr != IoUring_Ok) {
+    std::cerr << "io_uring setup failed (" << ringErr << ")\n";
+    return false;
+  }
+  if (mRecvRing.Open(mRing, 0, mRecvBufferCount, mRecvBufferSize) !=
+      IoUring_Ok) {
+    std::cerr << "io_uring provided buffers not supported\n";
+    mRing.Close();
+    return false;
+  }
+
+  if (mListener.Open() != ListenerSocket_Ok) {
+    std::cerr << "Listener open failed\n";
+    return false;
+  }
+
+  // io_uring 은 O_NONBLOCK 인 파일의 read 를 바로 -EAGAIN 으로 끝내므로 blocking eventfd
+  mWakeFd = ::eventfd(0, EFD_CLOEXEC);
+  if (mWakeFd < 0) {
+    std::perror("eventfd");
+    return false;
+  }
+
+  mRunning = true;
+  ArmAccept();
+  ArmWake();
+  if (mRing.Submit() != IoUring_Ok) {
+    std::cerr << "io_uring submit failed\n";
+    mRunning = false;
+    return false;
+  }
+  return true;
+}
+
+void UringServer::SetReusePort(bool enable) { mListener.SetReusePort(enable); }
+
+void UringServer::SetVerbose(bool verbose) { mVerbose = verbose; }
+
+void UringServer::SetProtocol(eServerProtocol protocol) {
+  mHandler = MakeProtocolHandler(protocol);
+}
+
+void UringServer::SetProtocolHandler(ProtocolHandler handler) {
+  mHandler = std::move(handler);
+}
+
+void UringServer::SetBufferMode(eRingBufferMode mode) { mBufferMode = mode; }
+
+void UringServer::SetSendBufferMode(eSendBufferMode mode,
+                                    size_t maxQueuedBytes) {
+  mSendBufferMode = mode;
+  mSendQueueLimit = maxQueuedBytes;
+}
+
+void UringServer::SetSendWatermarks(size_t low, size_t high) {
+  mSendLowWatermark = low;
+  mSendHighWatermark = high;
+}
+
+void UringServer::SetIdleTimeout(std::chrono::milliseconds timeout) {
+  mIdleTimeout = timeout;
+}
+
+void UringServer::SetLazyBuffers(bool lazy) { mLazyBuffers = lazy; }
+
+void UringServer::SetRingEntries(unsigned entries) { mRingEntries = entries; }
+
+void UringServer::SetRecvBuffers(unsigned count, size_t bufSize) {
+  mRecvBufferCount = count;
+  mRecvBufferSize = bufSize;
+}
+
+void UringServer::SetConnectionCache(size_t maxCached) {
+  mMaxCachedConns = maxCached;
+}
+
+size_t UringServer::ConnectionCount() const noexcept {
+  return mConnectionCount.load(std::memory_order_relaxed);
+}
+
+std::uint64_t UringServer::MakeTag(Conn &conn, eOp op) noexcept {
+  return reinterpret_cast<std::uint64_t>(&conn) | op;
+}
+
+void UringServer::ArmAccept() {
+  io_uring_sqe *sqe = mRing.GetSqe();
+  if (!sqe)
+    return;
+  sqe->opcode = IORING_OP_ACCEPT;
+  sqe->fd = mListener.GetFd();
+  sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+  sqe->accept_flags = SOCK_CLOEXEC;
+  sqe->user_data = kTagAccept;
+  mAcceptArmed = true;
+}
+
+void UringServer::ArmWake() {
+  io_uring_sqe *sqe = mRing.GetSqe();
+  if (!sqe)
+    return;
+  sqe->opcode = IORING_OP_READ;
+  sqe->fd = mWakeFd;
+  sqe->addr = reinterpret_cast<std::uint64_t>(&mWakeValue);
+  sqe->len = sizeof(mWakeValue);
+  sqe->user_data = kTagWake;
+  mWakeArmed = true;
+}
+
+void UringServer::ArmRecv(Conn &conn) {
+  io_uring_sqe *sqe = mRing.GetSqe();
+  if (!sqe) {
+    // SQ 를 비워도 자리가 없으면 더 받을 수 없으므로 연결을 내린다
+    conn.session->Close();
+    return;
+  }
+  sqe->opcode = IORING_OP_RECV;
+  sqe->fd = conn.session->Fd();
+  sqe->ioprio = IORING_RECV_MULTISHOT;
+  sqe->flags = IOSQE_BUFFER_SELECT;
+  sqe->buf_group = mRecvRing.GroupId();
+  sqe->user_data = MakeTag(conn, Op_Recv);
+  conn.state.recvArmed = true;
+}
+
+void UringServer::CancelOps(Conn &conn, eOp op) {
+  io_uring_sqe *sqe = mRing.GetSqe();
+  if (!sqe)
+    return;
+  sqe->opcode = IORING_OP_ASYNC_CANCEL;
+  sqe->fd = -1;
+  sqe->addr = MakeTag(conn, op);
+  sqe->cancel_flags = IORING_ASYNC_CANCEL_ALL;
+  sqe->user_data = kTagIgnore;
+}
+
+void UringServer::QueueFlush(Conn &conn) {
+  if (conn.state.flushQueued)
+    return;
+  conn.state.flushQueued = true;
+  mDirty.push_back(&conn);
+}
+
+void UringServer::FlushSends() {
+  // 응답을 loop 회차 끝에 연결당 한 체인으로 모아 제출
+  for (size_t i = 0; i < mDirty.size(); ++i)
+    Flush(*mDirty[i]);
+  mDirty.clear();
+}
+
+void UringServer::Flush(Conn &conn) {
+  ConnState &st = conn.state;
+  st.flushQueued = false;
+  if (!conn.session || !conn.session->IsOpen())
+    return;
+  Session &sess = *conn.session;
+  if (sess.IsSendInFlight() || !sess.HasPendingSend())
+    return;
+
+  constexpr int kMaxSpans = kMaxLinkedSends * Session::kMaxSendSpans;
+  size_t total = 0;
+  const int spanCount = sess.PrepareSend(st.spans, kMaxSpans, total);
+  if (spanCount == 0)
+    return;
+
+  // sendmsg 하나에 kMaxSendSpans 개씩. MSG_WAITALL 이라 커널이 짧은 전송을 끝까지 재시도하고,
+  // 그래도 못 보내면 실패로 처리해 뒤에 링크된 sendmsg 를 -ECANCELED 로 끊어 순서가 지켜진다.
+  const int links =
+      (spanCount + Session::kMaxSendSpans - 1) / Session::kMaxSendSpans;
+  // 체인이 두 번의 제출로 갈라지면 뒤쪽이 먼저 나갈 수 있으므로 자리를 먼저 확보
+  if (mRing.SqSpaceLeft() < static_cast<unsigned>(links))
+    (void)mRing.Submit();
+  if (mRing.SqSpaceLeft() < static_cast<unsigned>(links)) {
+    (void)sess.CompleteSend(total, 0);
+    QueueFlush(conn);
+    return;
+  }
+
+  st.sendHead = 0;
+  for (int g = 0; g < links; ++g) {
+    const int first = g * Session::kMaxSendSpans;
+    const int count = (spanCount - first < Session::kMaxSendSpans)
+                          ? spanCount - first
+                          : Session::kMaxSendSpans;
+    size_t bytes = 0;
+    for (int i = 0; i < count; ++i)
+      bytes += st.spans[first + i].iov_len;
+
+    io_uring_sqe *sqe = mRing.GetSqe();
+    msghdr &msg = st.msgs[g];
+    std::memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &st.spans[first];
+    msg.msg_iovlen = static_cast<size_t>(count);
+
+    sqe->opcode = IORING_OP_SENDMSG;
+    sqe->fd = sess.Fd();
+    sqe->addr = reinterpret_cast<std::uint64_t>(&msg);
+    sqe->len = 1;
+    sqe->msg_flags = MSG_NOSIGNAL | MSG_WAITALL;
+    sqe->user_data = MakeTag(conn, Op_Send);
+    if (g + 1 < links)
+      sqe->flags = IOSQE_IO_LINK;
+
+    st.sendAttempted[g] = bytes;
+    ++st.sendsInFlight;
+    total -= bytes;
+  }
+}
+
+bool UringServer::AdoptConnection(int fd) {
+  Socket clientSocket(fd);
+  Conn &conn = AcquireConn();
+
+  const size_t sendBufSize = (mSendBufferMode == SendBufMode_Segmented)
+                                 ? mSendQueueLimit
+                                 : mSendBufSize;
+  // 재사용할 수 없는 세션이면 버리고 새로 만든다 (Reattach 는 실패하면 socket 을
+  // 건드리지 않음)
+  if (!conn.session ||
+      conn.session->Reattach(std::move(clientSocket)) != Session_Ok)
+    conn.session.emplace(mRecvBufSize, sendBufSize, std::move(clientSocket),
+                         mBufferMode, mSendBufferMode);
+
+  Session &session = *conn.session;
+  if (session.Open(mRecvBufSize, sendBufSize) != Session_Ok) {
+    ReleaseConn(conn);
+    return false;
+  }
+  if (mSendHighWatermark != 0)
+    session.SetSendWatermarks(mSendLowWatermark, mSendHighWatermark);
+  session.SetLazyBuffers(mLazyBuffers);
+
+  Conn *c = &conn;
+  // DeliverRecv / CompleteSend 가 Session 안에서 dispatch 하므로 handler 를 콜백으로 건다
+  ResetProtocolState(mHandler, conn.state.protocol);
+  BindSessionCallbacks(mHandler, session, conn.state.protocol);
+
+  // 걸려 있는 recv/send 를 취소하고, 완료가 다 돌아온 뒤 ReapClosedSessions 에서 회수
+  session.SetCloseCallback([this, c](Session &s) {
+    DispatchClose(mHandler, s, c->state.protocol);
+    mConnectionCount.fetch_sub(1, std::memory_order_relaxed);
+    if (c->state.recvArmed)
+      CancelOps(*c, Op_Recv);
+    if (c->state.sendsInFlight != 0)
+      CancelOps(*c, Op_Send);
+    if (!c->state.closeQueued) {
+      c->state.closeQueued = true;
+      mClosed.push_back(c);
+    }
+  });
+  session.SetWatermarkCallback([this, c](Session & /*s*/, bool aboveHigh) {
+    // 멈추면 multishot recv 를 내리고 (이미 받은 것은 stash), 풀리면 stash 부터 넘긴 뒤 다시 건다
+    if (aboveHigh) {
+      if (c->state.recvArmed)
+        CancelOps(*c, Op_Recv);
+    } else {
+      mResumed.push_back(c);
+    }
+  });
+  session.SetWriteInterestCallback([this, c](Session & /*s*/, bool enable) {
+    if (enable)
+      QueueFlush(*c);
+  });
+
+  conn.state.idleTimer.userData = reinterpret_cast<std::uint64_t>(c);
+  mIdleTimers.Schedule(conn.state.idleTimer, mIdleTimeout);
+  mConnectionCount.fetch_add(1, std::memory_order_relaxed);
+
+  ArmRecv(conn);
+  return true;
+}
+
+UringServer::Conn &UringServer::AcquireConn() {
+  std::unique_ptr<Conn> conn;
+  if (!mFreeConns.empty()) {
+    conn = std::move(mFreeConns.back());
+    mFreeConns.pop_back();
+  } else {
+    conn = std::make_unique<Conn>();
+  }
+  conn->index = mConns.size();
+  mConns.push_back(std::move(conn));
+  return *mConns.back();
+}
+
+void UringServer::ReleaseConn(Conn &conn) {
+  ConnState &st = conn.state;
+  mIdleTimers.Cancel(st.idleTimer);
+  ResetProtocolState(mHandler, st.protocol);
+  st.stash.clear();
+  st.recvArmed = false;
+  st.flushQueued = false;
+  st.closeQueued = false;
+  st.sendBroken = false;
+  st.sendsInFlight = 0;
+  st.sendHead = 0;
+
+  const size_t index = conn.index;
+  std::unique_ptr<Conn> owned = std::move(mConns[index]);
+  if (index + 1 != mConns.size()) {
+    mConns[index] = std::move(mConns.back());
+    mConns[index]->index = index;
+  }
+  mConns.pop_back();
+
+  // Session 은 닫힌 채로 버퍼를 들고 있다가 다음 연결에서 Reattach
+  if (mFreeConns.size() < mMaxCachedConns && owned->session &&
+      !owned->session->IsOpen())
+    mFreeConns.push_back(std::move(owned));
+}
+
+bool UringServer::HasOpsInFlight(const Conn &conn) const noexcept {
+  return conn.state.recvArmed || conn.state.sendsInFlight != 0;
+}
+
+void UringServer::HandleCqe(const io_uring_cqe &cqe) {
+  const std::uint64_t tag = cqe.user_data;
+  if (tag == kTagAccept) {
+    HandleAccept(cqe);
+    return;
+  }
+  if (tag == kTagWake) {
+    mWakeArmed = false;
+    // Stop() 이면 다시 걸지 않고 loop 가 빠져나감
+    if (mRunning)
+      ArmWake();
+    return;
+  }
+  // cancel 완료, PROVIDE_BUFFERS 방식의 버퍼 반납 완료
+  if (tag == kTagIgnore || tag == IoUringBufferRing::kProvideUserData)
+    return;
+
+  Conn &conn = *reinterpret_cast<Conn *>(tag & ~kOpMask);
+  if ((tag & kOpMask) == Op_Recv)
+    HandleRecv(conn, cqe);
+  else
+    HandleSend(conn, cqe);
+
+  // 닫힌 연결은 마지막 완료가 돌아온 시점에 회수 목록으로
+  if ((!conn.session || !conn.session->IsOpen()) && !HasOpsInFlight(conn) &&
+      !conn.state.closeQueued) {
+    conn.state.closeQueued = true;
+    mClosed.push_back(&conn);
+  }
+}
+
+void UringServer::HandleAccept(const io_uring_cqe &cqe) {
+  if (cqe.res >= 0) {
+    if (mRunning)
+      AdoptConnection(cqe.res);
+    else
+      ::close(cqe.res);
+  } else if (cqe.res != -ECANCELED && mVerbose) {
+    std::cerr << "accept failed: " << std::strerror(-cqe.res) << "\n";
+  }
+
+  if ((cqe.flags & IORING_CQE_F_MORE) == 0) {
+    mAcceptArmed = false;
+    if (mRunning)
+      ArmAccept();
+  }
+}
+
+void UringServer::HandleRecv(Conn &conn, const io_uring_cqe &cqe) {
+  ConnState &st = conn.state;
+  if ((cqe.flags & IORING_CQE_F_MORE) == 0)
+    st.recvArmed = false;
+
+  Session &sess = *conn.session;
+  if (cqe.flags & IORING_CQE_F_BUFFER) {
+    const std::uint16_t bid = IoUringBufferRing::BufferId(cqe.flags);
+    if (cqe.res > 0 && sess.IsOpen()) {
+      const std::uint8_t *data = mRecvRing.Buffer(bid);
+      const size_t len = static_cast<size_t>(cqe.res);
+      mIdleTimers.Schedule(st.idleTimer, mIdleTimeout);
+
+      if (!st.stash.empty()) {
+        st.stash.insert(st.stash.end(), data, data + len);
+      } else {
+        size_t accepted = 0;
+        (void)sess.DeliverRecv(data, len, accepted);
+        if (sess.IsOpen() && accepted < len)
+          st.stash.insert(st.stash.end(), data + accepted, data + len);
+      }
+    }
+    // 내용은 이미 recv buffer / stash 로 복사했으므로 바로 커널에 돌려준다
+    mRecvRing.Recycle(bid);
+  } else if (cqe.res == 0) {
+    sess.Close();
+    return;
+  } else if (cqe.res < 0 && cqe.res != -ENOBUFS && cqe.res != -ECANCELED) {
+    sess.Close();
+    return;
+  }
+
+  // -ENOBUFS 나 취소로 끝난 multishot 은 멈춘 상태가 아니면 다시 건다
+  if (!st.recvArmed && sess.IsOpen() && !sess.IsSendPaused() &&
+      st.stash.empty())
+    ArmRecv(conn);
+}
+
+void UringServer::HandleSend(Conn &conn, const io_uring_cqe &cqe) {
+  ConnState &st = conn.state;
+  Session &sess = *conn.session;
+
+  const size_t attempted = st.sendAttempted[st.sendHead++];
+  --st.sendsInFlight;
+
+  size_t sent = (cqe.res > 0) ? static_cast<size_t>(cqe.res) : 0;
+  bool fail = (cqe.res < 0 && cqe.res != -ECANCELED);
+  // 앞 sendmsg 가 덜 보낸 뒤 뒤쪽이 나갔으면 순서가 깨진 것
+  if (st.sendBroken && sent > 0) {
+    fail = true;
+    sent = 0;
+  }
+  if (sent < attempted)
+    st.sendBroken = true;
+
+  (void)sess.CompleteSend(attempted, sent);
+  if (fail && sess.IsOpen()) {
+    sess.Close();
+    return;
+  }
+
+  if (st.sendsInFlight == 0) {
+    st.sendBroken = false;
+    st.sendHead = 0;
+    // 체인이 끝나는 동안 더 쌓였거나 취소된 구간이 남아 있으면 이어서 보냄
+    if (sess.IsOpen() && sess.HasPendingSend())
+      QueueFlush(conn);
+  }
+}
+
+void UringServer::DeliverStash(Conn &conn) {
+  ConnState &st = conn.state;
+  Session &sess = *conn.session;
+  while (!st.stash.empty() && sess.IsOpen() && !sess.IsSendPaused()) {
+    size_t accepted = 0;
+    (void)sess.DeliverRecv(st.stash.data(), st.stash.size(), accepted);
+    if (accepted == 0)
+      break;
+    st.stash.erase(st.stash.begin(),
+                   st.stash.begin() + static_cast<std::ptrdiff_t>(accepted));
+  }
+}
+
+void UringServer::ResumePausedSessions() {
+  for (size_t i = 0; i < mResumed.size(); ++i) {
+    Conn &conn = *mResumed[i];
+    if (!conn.session || !conn.session->IsOpen())
+      continue;
+    Session &sess = *conn.session;
+    (void)sess.ResumeRecv();
+    DeliverStash(conn);
+    if (sess.IsOpen() && !sess.IsSendPaused() && conn.state.stash.empty() &&
+        !conn.state.recvArmed)
+      ArmRecv(conn);
+  }
+  mResumed.clear();
+}
+
+void UringServer::ExpireIdleSessions() {
+  mIdleTimers.Advance(TimingWheel::Clock::now(), [](TimerNode &node) {
+    Conn *conn = reinterpret_cast<Conn *>(node.userData);
+    if (conn->session && conn->session->IsOpen())
+      conn->session->Close();
+  });
+}
+
+void UringServer::ReapClosedSessions() {
+  for (size_t i = 0; i < mClosed.size(); ++i) {
+    Conn &conn = *mClosed[i];
+    // 취소한 요청의 완료가 아직이면 HandleCqe 가 마지막 완료 때 다시 올린다
+    conn.state.closeQueued = false;
+    if (!HasOpsInFlight(conn))
+      ReleaseConn(conn);
+  }
+  mClosed.clear();
+}
+
+void UringServer::Run() {
+  io_uring_cqe *cqes[kCqeBatch];
+
+  while (mRunning) {
+    const int timeoutMs =
+        !mDirty.empty() || !mResumed.empty()
+            ? 0
+            : mIdleTimers.NextTimeoutMs(TimingWheel::Clock::now(), kMaxWaitMs);
+    const eIoUringError err = mRing.SubmitAndWait(1, timeoutMs);
+    if (err == IoUring_EnterFailed) {
+      std::perror("io_uring_enter");
+      break;
+    }
+
+    for (;;) {
+      const unsigned n = mRing.PeekCqes(cqes, kCqeBatch);
+      if (n == 0)
+        break;
+      for (unsigned i = 0; i < n; ++i)
+        HandleCqe(*cqes[i]);
+      mRing.Advance(n);
+    }
+
+    ResumePausedSessions();
+    FlushSends();
+    ExpireIdleSessions();
+    ReapClosedSessions();
+  }
+
+  // loop 스레드 안에서 정리 (Stop 은 다른 스레드에서 불릴 수 있으므로 자원을 건드리지 않음)
+  Shutdown();
+}
+
+void UringServer::Stop() {
+  mRunning = false;
+  if (mWakeFd >= 0) {
+    const std::uint64_t one = 1;
+    (void)::write(mWakeFd, &one, sizeof(one));
+  }
+}
+
+void UringServer::Shutdown() {
+  mRunning = false;
+  if (!mRing.IsOpen()) {
+    mListener.Close();
+    return;
+  }
+
+  // 걸려 있는 요청이 Conn / 버퍼 주소를 들고 있으므로 모두 취소하고 완료를 받은 뒤에 해제
+  io_uring_sqe *sqe = mRing.GetSqe();
+  if (sqe) {
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = kTagAccept;
+    sqe->user_data = kTagIgnore;
+  }
+  for (size_t i = 0; i < mConns.size(); ++i) {
+    Conn &conn = *mConns[i];
+    if (conn.session && conn.session->IsOpen())
+      conn.session->Close();
+  }
+
+  io_uring_cqe *cqes[kCqeBatch];
+  for (int round = 0; round < 100; ++round) {
+    bool busy = mAcceptArmed;
+    for (size_t i = 0; i < mConns.size() && !busy; ++i)
+      busy = HasOpsInFlight(*mConns[i]);
+    if (!busy)
+      break;
+
+    (void)mRing.SubmitAndWait(1, 10);
+    for (;;) {
+      const unsigned n = mRing.PeekCqes(cqes, kCqeBatch);
+      if (n == 0)
+        break;
+      for (unsigned i = 0; i < n; ++i)
+        HandleCqe(*cqes[i]);
+      mRing.Advance(n);
+    }
+  }
+
+  mDirty.clear();
+  mResumed.clear();
+  mClosed.clear();
+  while (!mConns.empty())
+    ReleaseConn(*mConns.back());
+  mFreeConns.clear();
+  mConnectionCount.store(0, std::memory_order_relaxed);
+
+  mListener.Close();
+  // wake read 는 ring 을 닫을 때 커널이 정리한다 (mWakeValue 는 멤버라 끝까지 유효)
+  mRecvRing.Close();
+  mRing.Close();
+  mAcceptArmed = false;
+  mWakeArmed = false;
+}
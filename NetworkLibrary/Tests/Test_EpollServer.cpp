@@ -0,0 +1,228 @@
+#include <gtest/gtest.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "EpollServer.h"
+#include "MultiReactorServer.h"
+
+// listener 없이 연결을 직접 넣고, Run 의 한 회차를 이루는 단계를 하나씩 호출한다.
+class EpollServerTest : public ::testing::Test
+{
+protected:
+    static void StartWorker(EpollServer& server)
+    {
+        server.SetListenEnabled(false);
+        ASSERT_TRUE(server.Start());
+    }
+
+    // 연결 하나를 넣고 server 쪽 fd 를 돌려준다 (peerFd 는 호출자가 닫음)
+    static int Adopt(EpollServer& server, int& peerFd, int type = SOCK_STREAM)
+    {
+        int fds[2];
+        EXPECT_EQ(::socketpair(AF_UNIX, type, 0, fds), 0);
+        peerFd = fds[1];
+        EXPECT_TRUE(server.AdoptConnection(Socket(fds[0]), 0));
+        return fds[0];
+    }
+
+    static uint64_t EventTag(EpollServer& server, int fd)
+    {
+        EpollServer::ConnSlot* slot = server.FindSlot(fd);
+        EXPECT_NE(slot, nullptr);
+        return EpollServer::MakeEventTag(fd, slot ? slot->generation : 0);
+    }
+
+    static void HandleEvent(EpollServer& server, uint64_t tag, uint32_t events)
+    {
+        server.HandleClientEvent(tag, events);
+    }
+
+    static Session* FindSession(EpollServer& server, int fd) { return server.FindSession(fd); }
+    static size_t PendingIoCount(const EpollServer& server) { return server.mPendingIo.size(); }
+    static void ProcessPendingIo(EpollServer& server) { server.ProcessPendingIo(); }
+    static bool OutArmed(EpollServer& server, int fd) { return server.FindSlot(fd)->conn.outArmed; }
+};
+
+static int UnreadBytes(int fd)
+{
+    int n = -1;
+    EXPECT_EQ(::ioctl(fd, FIONREAD, &n), 0);
+    return n;
+}
+
+TEST_F(EpollServerTest, StaleEventAfterFdReuseIsDropped)
+{
+    EpollServer server(0, 4096, 4096);
+    StartWorker(server);
+
+    int oldPeer = -1;
+    const int fd = Adopt(server, oldPeer);
+    const uint64_t staleTag = EventTag(server, fd);
+
+    // 같은 epoll_wait 결과 안에서 닫히고 (아직 reap 전) 같은 fd 번호로 새 연결이 들어온 상황
+    Session* oldSession = FindSession(server, fd);
+    ASSERT_NE(oldSession, nullptr);
+    oldSession->Close();
+    ::close(oldPeer);
+
+    int peer = -1;
+    ASSERT_EQ(Adopt(server, peer), fd);
+    const char request[] = "GET /health HTTP/1.1\r\nHost: a\r\n\r\n";
+    ASSERT_EQ(::write(peer, request, sizeof(request) - 1), static_cast<ssize_t>(sizeof(request) - 1));
+
+    // 이전 연결 앞으로 온 이벤트: 새 세션을 닫거나 읽으면 안 됨
+    HandleEvent(server, staleTag, EPOLLIN | EPOLLHUP);
+    ASSERT_NE(FindSession(server, fd), nullptr);
+    EXPECT_EQ(UnreadBytes(fd), static_cast<int>(sizeof(request) - 1));
+
+    // 현재 generation 의 이벤트는 처리됨
+    HandleEvent(server, EventTag(server, fd), EPOLLIN);
+    EXPECT_NE(FindSession(server, fd), nullptr);
+    EXPECT_EQ(UnreadBytes(fd), 0);
+
+    ::close(peer);
+}
+
+TEST_F(EpollServerTest, DeferredFlushWritesOncePerIteration)
+{
+    EpollServer server(0, 4096, 4096);
+    server.SetDeferredFlush(true);
+    StartWorker(server);
+
+    // SEQPACKET 은 writev 한 번이 record 하나로 가므로 몇 번 flush 했는지 peer 에서 보인다
+    int peer = -1;
+    const int fd = Adopt(server, peer, SOCK_SEQPACKET);
+    int closedPeer = -1;
+    const int closedFd = Adopt(server, closedPeer, SOCK_SEQPACKET);
+
+    Session* s = FindSession(server, fd);
+    ASSERT_NE(s, nullptr);
+    ASSERT_EQ(s->QueueSend("one,", 4), Session_Ok);
+    ASSERT_EQ(s->QueueSend("two,", 4), Session_Ok);
+    ASSERT_EQ(s->QueueSend("three", 5), Session_Ok);
+
+    // flush 전에 닫힌 세션은 목록에 남아 있어도 건너뛴다
+    Session* closed = FindSession(server, closedFd);
+    ASSERT_NE(closed, nullptr);
+    ASSERT_EQ(closed->QueueSend("never", 5), Session_Ok);
+    closed->Close();
+
+    // 회차 끝까지는 아무것도 나가지 않고 EPOLLOUT 도 걸지 않음
+    EXPECT_EQ(PendingIoCount(server), 2u);
+    EXPECT_FALSE(OutArmed(server, fd));
+    char buf[64];
+    EXPECT_EQ(::recv(peer, buf, sizeof(buf), MSG_DONTWAIT), -1);
+
+    ProcessPendingIo(server);
+    EXPECT_EQ(PendingIoCount(server), 0u);
+    EXPECT_FALSE(s->HasPendingSend());
+    EXPECT_FALSE(OutArmed(server, fd));
+
+    // 세 번의 QueueSend 가 record 하나로 도착
+    ASSERT_EQ(::recv(peer, buf, sizeof(buf), MSG_DONTWAIT), 13);
+    EXPECT_EQ(std::string(buf, 13), "one,two,three");
+    EXPECT_EQ(::recv(peer, buf, sizeof(buf), MSG_DONTWAIT), -1);
+
+    // 닫힌 쪽은 아무것도 받지 않고 EOF
+    EXPECT_EQ(::recv(closedPeer, buf, sizeof(buf), MSG_DONTWAIT), 0);
+
+    ::close(peer);
+    ::close(closedPeer);
+}
+
+// 지금 비어 있는 TCP port (bind 0 으로 받은 뒤 닫음)
+static uint16_t FreePort()
+{
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = ::htonl(INADDR_LOOPBACK);
+    EXPECT_EQ(::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+    socklen_t len = sizeof(addr);
+    EXPECT_EQ(::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len), 0);
+    ::close(fd);
+    return ntohs(addr.sin_port);
+}
+
+// POST /echo 한 번을 보내고 응답 body 가 같은지 확인. 실패하면 이유를 돌려준다.
+static std::string EchoOnce(uint16_t port, const std::string& body)
+{
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    timeval timeout{5, 0};
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = ::htonl(INADDR_LOOPBACK);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        ::close(fd);
+        return "connect failed";
+    }
+
+    const std::string request = "POST /echo HTTP/1.1\r\nHost: a\r\nContent-Length: " +
+                                std::to_string(body.size()) + "\r\n\r\n" + body;
+    // 응답이 요청과 같이 흘러오므로 읽기와 쓰기를 번갈아 한다
+    size_t sent = 0;
+    std::string response;
+    char tmp[64 * 1024];
+    size_t headEnd = std::string::npos;
+    while (headEnd == std::string::npos || response.size() < headEnd + 4 + body.size()) {
+        if (sent < request.size()) {
+            const ssize_t n = ::send(fd, request.data() + sent, request.size() - sent, MSG_DONTWAIT);
+            if (n > 0) sent += static_cast<size_t>(n);
+        }
+        const ssize_t n = ::recv(fd, tmp, sizeof(tmp), sent < request.size() ? MSG_DONTWAIT : 0);
+        if (n == 0 || (n < 0 && sent == request.size())) {
+            ::close(fd);
+            return "connection ended after " + std::to_string(response.size()) + " bytes";
+        }
+        if (n > 0) response.append(tmp, static_cast<size_t>(n));
+        if (headEnd == std::string::npos) headEnd = response.find("\r\n\r\n");
+    }
+    ::close(fd);
+
+    if (response.compare(0, 15, "HTTP/1.1 200 OK") != 0) return "bad status";
+    if (response.compare(headEnd + 4, std::string::npos, body) != 0) return "body mismatch";
+    return {};
+}
+
+// prewarm 한 세션의 Segmented 송신 큐는 만든 스레드의 SegmentPool 에 묶인다.
+// 여러 reactor 가 동시에 큰 응답을 보내도 pool 을 공유하지 않아야 한다 (TSan 빌드에서 확인).
+TEST(MultiReactorServer, PrewarmedSegmentedSessionsUseTheirLoopThreadPool)
+{
+    const uint16_t port = FreePort();
+    MultiReactorServer server(port, 3, 16 * 1024, 16 * 1024);
+    server.ForEachReactor([](EpollServer& reactor) {
+        reactor.SetSendBufferMode(SendBufMode_Segmented, 4 * 1024 * 1024);
+        reactor.SetSessionPool(16, 8);
+        reactor.SetDeferredFlush(true);
+    });
+    ASSERT_TRUE(server.Start());
+    std::thread loop([&server] { server.Run(); });
+
+    constexpr int kClients = 4;
+    constexpr int kRounds = 6;
+    std::vector<std::string> errors(kClients);
+    std::vector<std::thread> clients;
+    for (int c = 0; c < kClients; ++c) {
+        clients.emplace_back([&, c] {
+            std::string body(96 * 1024, '\0');
+            for (size_t i = 0; i < body.size(); ++i) body[i] = static_cast<char>('a' + (i * 7 + c) % 26);
+            for (int r = 0; r < kRounds && errors[c].empty(); ++r)
+                errors[c] = EchoOnce(port, body);
+        });
+    }
+    for (auto& t : clients) t.join();
+
+    server.Stop();
+    loop.join();
+
+    for (int c = 0; c < kClients; ++c)
+        EXPECT_EQ(errors[c], "") << "client " << c;
+}
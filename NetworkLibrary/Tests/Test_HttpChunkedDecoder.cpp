@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "HttpChunkedDecoder.h"
+
+namespace {
+
+// input 을 step 바이트씩 나눠 넣으며 끝까지 푼다. 끝나면 소비한 길이, 오류면 npos
+size_t DecodeInSteps(HttpChunkedDecoder& d, const std::string& input, size_t step, std::string& out)
+{
+    size_t pos = 0;
+    while (pos < input.size()) {
+        const size_t end = std::min(input.size(), pos + step);
+        while (pos < end) {
+            size_t used = 0;
+            std::string_view data;
+            const auto r = d.Next(input.data() + pos, end - pos, used, data);
+            pos += used;
+            if (r == HttpChunkedDecoder::Result::Chunk_Data) { out.append(data); continue; }
+            if (r == HttpChunkedDecoder::Result::Chunk_Done) return pos;
+            if (r == HttpChunkedDecoder::Result::Chunk_Error) return std::string::npos;
+            EXPECT_EQ(pos, end);
+            break;
+        }
+    }
+    return std::string::npos;
+}
+
+} // namespace
+
+TEST(HttpChunkedDecoder, DecodesAcrossEverySplit)
+{
+    const std::string body =
+        "5\r\nhello\r\n"
+        "1A;name=\"v\"\r\nabcdefghijklmnopqrstuvwxyz\r\n"
+        "0\r\n"
+        "X-Checksum: 1\r\n"
+        "\r\n";
+    const std::string next = "GET / HTTP/1.1\r\n";
+
+    for (size_t step = 1; step <= body.size(); ++step) {
+        HttpChunkedDecoder d;
+        std::string out;
+        EXPECT_EQ(DecodeInSteps(d, body + next, step, out), body.size()) << "step " << step;
+        EXPECT_EQ(out, "helloabcdefghijklmnopqrstuvwxyz");
+        EXPECT_EQ(d.DecodedBytes(), 31u);
+        EXPECT_TRUE(d.IsDone());
+    }
+}
+
+TEST(HttpChunkedDecoder, RejectsMalformedInput)
+{
+    const char* bad[] = {
+        "\r\n",                 // size 없음
+        "g\r\n",                // hex 아님
+        "3\r\nabcX\r\n",        // data 뒤 CRLF 없음
+        "3\nabc\r\n",           // bare LF
+        "1000000000000000\r\n", // 2^60 이상
+        "0\r\nTrailer\n\r\n",
+    };
+    for (const char* in : bad) {
+        HttpChunkedDecoder d;
+        std::string out;
+        EXPECT_EQ(DecodeInSteps(d, in, 64, out), std::string::npos) << in;
+        EXPECT_NE(d.Error(), nullptr) << in;
+    }
+}
+
+TEST(HttpChunkedDecoder, LimitsLineAndTrailerSize)
+{
+    HttpChunkedDecoder d;
+    std::string out;
+    const std::string longExt = "1;" + std::string(HttpChunkedDecoder::kMaxLineBytes, 'e') + "\r\nx\r\n0\r\n\r\n";
+    EXPECT_EQ(DecodeInSteps(d, longExt, 512, out), std::string::npos);
+
+    d.Reset();
+    std::string trailers = "0\r\n";
+    while (trailers.size() < 2 * HttpChunkedDecoder::kMaxTrailerBytes) trailers += "X-Pad: " + std::string(100, 'p') + "\r\n";
+    trailers += "\r\n";
+    EXPECT_EQ(DecodeInSteps(d, trailers, 512, out), std::string::npos);
+}
@@ -104,3 +104,370 @@ TEST(HttpParser, BadHeader)
     EXPECT_EQ(r, HttpParser::Result::Http_Error);
     EXPECT_FALSE(err.empty());
 }
+
+TEST(HttpParser, ViewPointsIntoRecvBuffer)
+{
+    RecvBuffer rb(4096);
+    ASSERT_EQ(rb.Open(), RecvBuf_Ok);
+
+    HttpParser p;
+    HttpRequestView req;
+
+    WriteAll(rb,
+        "POST /echo HTTP/1.1\r\n"
+        "Host: localhost\r\n"
+        "content-LENGTH:  5 \r\n"
+        "\r\nhello"
+        "GET /health HTTP/1.1\r\n\r\n");
+
+    const std::uint8_t* data = nullptr;
+    std::size_t len = 0;
+    ASSERT_EQ(rb.PeekContiguous(data, len), RecvBuf_Ok);
+    const char* base = reinterpret_cast<const char*>(data);
+
+    ASSERT_EQ(p.TryParseView(rb, req), HttpParser::Result::Http_Ok);
+    EXPECT_EQ(req.method, "POST");
+    EXPECT_EQ(req.target, "/echo");
+    EXPECT_EQ(req.method.data(), base);
+    ASSERT_EQ(req.headerCount, 2u);
+    EXPECT_EQ(req.Header("Content-Length"), std::optional<std::string_view>("5"));
+    EXPECT_EQ(req.Header("host"), std::optional<std::string_view>("localhost"));
+    EXPECT_EQ(req.body, "hello");
+
+    p.FinishView(rb);
+    ASSERT_EQ(p.TryParseView(rb, req), HttpParser::Result::Http_Ok);
+    EXPECT_EQ(req.target, "/health");
+    EXPECT_TRUE(req.body.empty());
+    p.FinishView(rb);
+    EXPECT_TRUE(rb.IsEmpty());
+}
+
+TEST(HttpParser, ViewWaitsForHeadersAndBody)
+{
+    RecvBuffer rb(4096);
+    ASSERT_EQ(rb.Open(), RecvBuf_Ok);
+
+    HttpParser p;
+    HttpRequestView req;
+
+    WriteAll(rb, "POST /echo HTTP/1.1\r\nContent-Length: 3\r\n");
+    EXPECT_EQ(p.TryParseView(rb, req), HttpParser::Result::Http_NeedMore);
+    WriteAll(rb, "\r\nab");
+    EXPECT_EQ(p.TryParseView(rb, req), HttpParser::Result::Http_NeedMore);
+    WriteAll(rb, "c");
+    ASSERT_EQ(p.TryParseView(rb, req), HttpParser::Result::Http_Ok);
+    EXPECT_EQ(req.body, "abc");
+}
+
+TEST(HttpParser, ViewLinearizesWrappedRing)
+{
+    RecvBuffer rb(64);
+    ASSERT_EQ(rb.Open(), RecvBuf_Ok);
+
+    // 앞쪽을 채웠다 소비해서 다음 요청이 ring 끝을 넘어가게 함
+    std::string filler(50, 'x');
+    WriteAll(rb, filler.c_str());
+    ASSERT_EQ(rb.Consume(filler.size()), RecvBuf_Ok);
+
+    HttpParser p;
+    HttpRequestView req;
+    WriteAll(rb, "GET /wrapped HTTP/1.1\r\nA: b\r\n\r\n");
+    ASSERT_EQ(p.TryParseView(rb, req), HttpParser::Result::Http_Ok);
+    EXPECT_EQ(req.target, "/wrapped");
+    EXPECT_EQ(req.Header("a"), std::optional<std::string_view>("b"));
+}
+
+TEST(HttpParser, ViewReportsTooLargeAndCopyPathContinues)
+{
+    RecvBuffer rb(64);
+    ASSERT_EQ(rb.Open(), RecvBuf_Ok);
+
+    HttpParser p;
+    HttpRequestView view;
+    HttpRequest req;
+
+    WriteAll(rb, "POST /echo HTTP/1.1\r\nContent-Length: 100\r\n\r\n");
+    ASSERT_EQ(p.TryParseView(rb, view), HttpParser::Result::Http_TooLarge);
+    EXPECT_EQ(p.TryParse(rb, req), HttpParser::Result::Http_NeedMore);
+    EXPECT_FALSE(p.IsIdle());
+
+    std::string body(100, 'b');
+    WriteAll(rb, body.substr(0, 60).c_str());
+    EXPECT_EQ(p.TryParse(rb, req), HttpParser::Result::Http_NeedMore);
+    WriteAll(rb, body.substr(60).c_str());
+    ASSERT_EQ(p.TryParse(rb, req), HttpParser::Result::Http_Ok);
+    EXPECT_EQ(req.body.size(), 100u);
+    EXPECT_TRUE(p.IsIdle());
+}
+
+TEST(HttpParser, RejectsInvalidHeaderNameCharacters)
+{
+    RecvBuffer rb(4096);
+    ASSERT_EQ(rb.Open(), RecvBuf_Ok);
+
+    HttpParser p;
+    HttpRequestView view;
+    std::string err;
+
+    // 이름과 ':' 사이 공백, 구분자 문자는 token 이 아님
+    WriteAll(rb, "GET / HTTP/1.1\r\nHost : a\r\n\r\n");
+    EXPECT_EQ(p.TryParseView(rb, view, &err), HttpParser::Result::Http_Error);
+    EXPECT_EQ(err, "Bad Header Key");
+
+    HttpParser q;
+    HttpRequest req;
+    RecvBuffer rb2(4096);
+    ASSERT_EQ(rb2.Open(), RecvBuf_Ok);
+    WriteAll(rb2, "GET / HTTP/1.1\r\nX(y): a\r\n\r\n");
+    EXPECT_EQ(q.TryParse(rb2, req, &err), HttpParser::Result::Http_Error);
+}
+
+TEST(HttpParser, LooksUpEveryKnownHeaderName)
+{
+    for(std::size_t i = 1; i < HttpHeaderTable::kCount; ++i){
+        const HttpHeader id = static_cast<HttpHeader>(i);
+        std::string upper(HttpHeaderName(id));
+        for(auto& c : upper) c = (char)std::toupper((unsigned char)c);
+
+        EXPECT_EQ(LookupHttpHeader(HttpHeaderName(id)), id);
+        EXPECT_EQ(LookupHttpHeader(upper), id);
+    }
+    EXPECT_EQ(LookupHttpHeader("hosts"), HttpHeader::Other);
+    EXPECT_EQ(LookupHttpHeader("x-request-id"), HttpHeader::Other);
+    EXPECT_EQ(LookupHttpHeader(""), HttpHeader::Other);
+}
+
+TEST(HttpParser, IndexesKnownHeadersInBothPaths)
+{
+    const char* request =
+        "GET / HTTP/1.1\r\n"
+        "HOST: a\r\n"
+        "X-Trace: t1\r\n"
+        "Connection: close\r\n"
+        "connection: keep-alive\r\n"
+        "\r\n";
+
+    RecvBuffer rb(4096);
+    ASSERT_EQ(rb.Open(), RecvBuf_Ok);
+    HttpParser p;
+    HttpRequestView view;
+    WriteAll(rb, request);
+    ASSERT_EQ(p.TryParseView(rb, view), HttpParser::Result::Http_Ok);
+
+    RecvBuffer rb2(4096);
+    ASSERT_EQ(rb2.Open(), RecvBuf_Ok);
+    HttpParser q;
+    HttpRequest owned;
+    WriteAll(rb2, request);
+    ASSERT_EQ(q.TryParse(rb2, owned), HttpParser::Result::Http_Ok);
+    ASSERT_EQ(owned.HeaderCount(), 4u);
+    EXPECT_EQ(owned.HeaderAt(0).name, "HOST");
+    EXPECT_EQ(owned.HeaderAt(1).id, HttpHeader::Other);
+
+    for(const HttpRequestView& v : {view, MakeRequestView(owned)}){
+        // 같은 이름이 두 번이면 첫 번째
+        EXPECT_EQ(v.Header(HttpHeader::Connection), std::optional<std::string_view>("close"));
+        EXPECT_EQ(v.Header(HttpHeader::Host), std::optional<std::string_view>("a"));
+        EXPECT_EQ(v.Header("x-trace"), std::optional<std::string_view>("t1"));
+        EXPECT_FALSE(v.Header(HttpHeader::ContentLength).has_value());
+    }
+    EXPECT_EQ(owned.Header("host"), std::optional<std::string_view>("a"));
+    EXPECT_EQ(owned.Header("X-TRACE"), std::optional<std::string_view>("t1"));
+}
+
+TEST(HttpParser, DecodesChunkedBodyAcrossCalls)
+{
+    RecvBuffer rb(4096);
+    ASSERT_EQ(rb.Open(), RecvBuf_Ok);
+
+    HttpParser p;
+    HttpRequestView view;
+    HttpRequest req;
+
+    WriteAll(rb, "POST /echo HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n4\r\nWi");
+    // chunked 는 in-place 로 볼 수 없음
+    ASSERT_EQ(p.TryParseView(rb, view), HttpParser::Result::Http_TooLarge);
+    EXPECT_EQ(p.TryParse(rb, req), HttpParser::Result::Http_NeedMore);
+    WriteAll(rb, "ki\r\n5;ext=1\r\npedia\r\n0\r\n");
+    EXPECT_EQ(p.TryParse(rb, req), HttpParser::Result::Http_NeedMore);
+    WriteAll(rb, "\r\nGET /health HTTP/1.1\r\n\r\n");
+    ASSERT_EQ(p.TryParse(rb, req), HttpParser::Result::Http_Ok);
+    EXPECT_EQ(std::string(req.body.begin(), req.body.end()), "Wikipedia");
+
+    // 다음 요청을 body 로 먹지 않음
+    ASSERT_EQ(p.TryParse(rb, req), HttpParser::Result::Http_Ok);
+    EXPECT_EQ(req.target, "/health");
+    EXPECT_TRUE(p.IsIdle());
+}
+
+TEST(HttpParser, HandsChunksToBodyCallback)
+{
+    RecvBuffer rb(4096);
+    ASSERT_EQ(rb.Open(), RecvBuf_Ok);
+
+    HttpParser p;
+    HttpRequest req;
+    std::vector<std::string> chunks;
+    p.SetBodyCallback([&](const HttpRequest& rq, std::string_view data) {
+        EXPECT_EQ(rq.target, "/upload");
+        chunks.emplace_back(data);
+    });
+
+    WriteAll(rb, "POST /upload HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n3\r\nabc\r\n");
+    EXPECT_EQ(p.TryParse(rb, req), HttpParser::Result::Http_NeedMore);
+    EXPECT_EQ(chunks.size(), 1u);
+    WriteAll(rb, "2\r\nde\r\n0\r\n\r\n");
+    ASSERT_EQ(p.TryParse(rb, req), HttpParser::Result::Http_Ok);
+    EXPECT_TRUE(req.body.empty());
+    ASSERT_EQ(chunks.size(), 2u);
+    EXPECT_EQ(chunks[0] + chunks[1], "abcde");
+}
+
+TEST(HttpParser, RejectsAmbiguousTransferEncoding)
+{
+    const char* bad[] = {
+        "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\nContent-Length: 3\r\n\r\n",
+        "POST / HTTP/1.1\r\nTransfer-Encoding: gzip\r\n\r\n",
+        "POST / HTTP/1.1\r\nTransfer-Encoding: chunked, chunked\r\n\r\n",
+        "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\nTransfer-Encoding: gzip\r\n\r\n",
+    };
+    for (const char* in : bad) {
+        RecvBuffer rb(4096);
+        ASSERT_EQ(rb.Open(), RecvBuf_Ok);
+        HttpParser p;
+        HttpRequest req;
+        std::string err;
+        WriteAll(rb, in);
+        EXPECT_EQ(p.TryParse(rb, req, &err), HttpParser::Result::Http_Error) << in;
+        EXPECT_FALSE(err.empty());
+    }
+}
+
+namespace {
+
+struct RecordingStream : HttpStreamHandler
+{
+    std::vector<std::string> events;
+    std::string body;
+    size_t pauseAfter = 0; // 0 이면 멈추지 않음
+    size_t chunks = 0;
+
+    void OnHeaders(const HttpRequestView& req) override
+    {
+        EXPECT_TRUE(req.body.empty());
+        events.push_back("headers " + std::string(req.method) + " " + std::string(req.target));
+    }
+    bool OnBodyChunk(std::string_view data) override
+    {
+        body.append(data);
+        ++chunks;
+        return pauseAfter == 0 || chunks % pauseAfter != 0;
+    }
+    void OnBodyEnd() override { events.push_back("end " + std::to_string(body.size())); }
+};
+
+} // namespace
+
+TEST(HttpParser, StreamsBodyLargerThanRecvBuffer)
+{
+    RecvBuffer rb(256);
+    ASSERT_EQ(rb.Open(), RecvBuf_Ok);
+
+    HttpParser p;
+    RecordingStream h;
+    const std::string body(10000, 'z');
+
+    WriteAll(rb, "POST /upload HTTP/1.1\r\nContent-Length: 10000\r\n\r\n");
+    size_t sent = 0;
+    HttpParser::Result r = HttpParser::Result::Http_NeedMore;
+    while (r == HttpParser::Result::Http_NeedMore) {
+        r = p.TryParseStream(rb, h);
+        // 소비한 만큼 다시 채움 (recv buffer 는 body 의 일부만 담을 수 있음)
+        std::size_t written = 0;
+        const std::size_t n = std::min(rb.BufSize() - rb.WriteSpace(), body.size() - sent);
+        if (n > 0) {
+            ASSERT_EQ(rb.Write(body.data() + sent, n, written), RecvBuf_Ok);
+            sent += written;
+        }
+    }
+    ASSERT_EQ(r, HttpParser::Result::Http_Ok);
+    ASSERT_EQ(h.events.size(), 2u);
+    EXPECT_EQ(h.events[0], "headers POST /upload");
+    EXPECT_EQ(h.events[1], "end 10000");
+    EXPECT_EQ(h.body, body);
+    EXPECT_TRUE(p.IsIdle());
+}
+
+TEST(HttpParser, StreamsChunkedBodyAndPausesOnRequest)
+{
+    RecvBuffer rb(4096);
+    ASSERT_EQ(rb.Open(), RecvBuf_Ok);
+
+    HttpParser p;
+    RecordingStream h;
+    h.pauseAfter = 1;
+
+    WriteAll(rb,
+        "POST /echo HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n"
+        "3\r\nabc\r\n2\r\nde\r\n0\r\n\r\n"
+        "GET /health HTTP/1.1\r\n\r\n");
+
+    // 조각마다 멈추므로 body 두 조각 → NeedMore 두 번 뒤 끝
+    EXPECT_EQ(p.TryParseStream(rb, h), HttpParser::Result::Http_NeedMore);
+    EXPECT_EQ(h.body, "abc");
+    EXPECT_EQ(p.TryParseStream(rb, h), HttpParser::Result::Http_NeedMore);
+    EXPECT_EQ(h.body, "abcde");
+    ASSERT_EQ(p.TryParseStream(rb, h), HttpParser::Result::Http_Ok);
+
+    ASSERT_EQ(p.TryParseStream(rb, h), HttpParser::Result::Http_Ok);
+    ASSERT_EQ(h.events.size(), 4u);
+    EXPECT_EQ(h.events[1], "end 5");
+    EXPECT_EQ(h.events[2], "headers GET /health");
+    EXPECT_TRUE(rb.IsEmpty());
+}
+
+TEST(HttpParser, EnforcesHeaderAndBufferedBodyLimits)
+{
+    std::string err;
+    {
+        RecvBuffer rb(4096);
+        ASSERT_EQ(rb.Open(), RecvBuf_Ok);
+        HttpParser p;
+        p.SetLimits(64, HttpParser::kDefaultMaxBufferedBody);
+        RecordingStream h;
+        WriteAll(rb, ("GET / HTTP/1.1\r\nX-Long: " + std::string(100, 'a')).c_str());
+        EXPECT_EQ(p.TryParseStream(rb, h, &err), HttpParser::Result::Http_Error);
+        EXPECT_EQ(err, "Header Too Large");
+    }
+    {
+        RecvBuffer rb(4096);
+        ASSERT_EQ(rb.Open(), RecvBuf_Ok);
+        HttpParser p;
+        p.SetLimits(64, HttpParser::kDefaultMaxBufferedBody);
+        HttpRequest req;
+        WriteAll(rb, ("GET / HTTP/1.1\r\nX-Long: " + std::string(100, 'a') + "\r\n\r\n").c_str());
+        EXPECT_EQ(p.TryParse(rb, req, &err), HttpParser::Result::Http_Error);
+        EXPECT_EQ(err, "Header Too Large");
+    }
+    {
+        RecvBuffer rb(4096);
+        ASSERT_EQ(rb.Open(), RecvBuf_Ok);
+        HttpParser p;
+        p.SetLimits(HttpParser::kDefaultMaxHeaderBytes, 16);
+        HttpRequest req;
+        WriteAll(rb, "POST / HTTP/1.1\r\nContent-Length: 17\r\n\r\n");
+        EXPECT_EQ(p.TryParse(rb, req, &err), HttpParser::Result::Http_Error);
+        EXPECT_EQ(err, "Body Too Large");
+    }
+    {
+        // stream 은 body 를 모으지 않으므로 maxBufferedBody 와 무관
+        RecvBuffer rb(4096);
+        ASSERT_EQ(rb.Open(), RecvBuf_Ok);
+        HttpParser p;
+        p.SetLimits(HttpParser::kDefaultMaxHeaderBytes, 16);
+        RecordingStream h;
+        WriteAll(rb, ("POST / HTTP/1.1\r\nContent-Length: 100\r\n\r\n" + std::string(100, 'b')).c_str());
+        EXPECT_EQ(p.TryParseStream(rb, h), HttpParser::Result::Http_Ok);
+        EXPECT_EQ(h.body.size(), 100u);
+    }
+}
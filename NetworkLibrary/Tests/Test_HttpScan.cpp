@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include "HttpScan.h"
+
+namespace {
+
+// 각 level 로 바꿔 가며 돌리고 끝나면 원래 level 로
+class HttpScanLevels : public ::testing::TestWithParam<eHttpScanLevel>
+{
+protected:
+    void SetUp() override
+    {
+        mSaved = HttpScan::Level();
+        if (!HttpScan::SetLevel(GetParam()))
+            GTEST_SKIP() << "CPU does not support this scan level";
+    }
+    void TearDown() override { HttpScan::SetLevel(mSaved); }
+
+private:
+    eHttpScanLevel mSaved = HttpScan_Scalar;
+};
+
+size_t RefFind(const std::string& s, const char* needle)
+{
+    const size_t pos = s.find(needle);
+    return pos == std::string::npos ? HttpScan::npos : pos;
+}
+
+size_t RefTokenLength(const std::string& s)
+{
+    size_t i = 0;
+    while (i < s.size() && HttpScan::IsTokenChar(s[i])) ++i;
+    return i;
+}
+
+} // namespace
+
+TEST(HttpScan, TokenCharsFollowRfc)
+{
+    for (char c : std::string("!#$%&'*+-.^_`|~09azAZ")) EXPECT_TRUE(HttpScan::IsTokenChar(c)) << c;
+    for (char c : std::string(" :\"(),/;<=>?@[\\]{}\t\r\n\x7f")) EXPECT_FALSE(HttpScan::IsTokenChar(c)) << int(c);
+    EXPECT_FALSE(HttpScan::IsTokenChar(static_cast<char>(0x80)));
+}
+
+TEST_P(HttpScanLevels, FindsDelimitersAtEveryOffset)
+{
+    // 블록 경계(16/32)와 꼬리 처리를 모두 지나가도록 길이와 위치를 바꿔 가며 비교
+    for (size_t len = 0; len < 80; ++len) {
+        for (size_t at = 0; at + 4 <= len; ++at) {
+            std::string s(len, 'a');
+            s.replace(at, 4, "\r\n\r\n");
+            EXPECT_EQ(HttpScan::FindHeaderEnd(s.data(), s.size()), at);
+            EXPECT_EQ(HttpScan::FindCrlf(s.data(), s.size()), at);
+            EXPECT_EQ(HttpScan::FindByte(s.data(), s.size(), '\n'), at + 1);
+            EXPECT_EQ(HttpScan::TokenLength(s.data(), s.size()), at);
+        }
+        const std::string plain(len, 'a');
+        EXPECT_EQ(HttpScan::FindHeaderEnd(plain.data(), plain.size()), HttpScan::npos);
+        EXPECT_EQ(HttpScan::FindCrlf(plain.data(), plain.size()), HttpScan::npos);
+        EXPECT_EQ(HttpScan::TokenLength(plain.data(), plain.size()), len);
+    }
+}
+
+TEST_P(HttpScanLevels, MatchesReferenceOnRandomInput)
+{
+    std::mt19937 rng(1234);
+    const std::string alphabet = "\r\n: aZ9-_\x80\x7f\t";
+    for (int iter = 0; iter < 2000; ++iter) {
+        std::string s(rng() % 100, 'x');
+        for (auto& c : s) c = (rng() % 4 == 0) ? alphabet[rng() % alphabet.size()] : static_cast<char>('a' + rng() % 26);
+
+        EXPECT_EQ(HttpScan::FindCrlf(s.data(), s.size()), RefFind(s, "\r\n"));
+        EXPECT_EQ(HttpScan::FindHeaderEnd(s.data(), s.size()), RefFind(s, "\r\n\r\n"));
+        EXPECT_EQ(HttpScan::FindByte(s.data(), s.size(), ':'), RefFind(s, ":"));
+        EXPECT_EQ(HttpScan::TokenLength(s.data(), s.size()), RefTokenLength(s));
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(AllLevels, HttpScanLevels,
+                         ::testing::Values(HttpScan_Scalar, HttpScan_Sse42, HttpScan_Avx2));
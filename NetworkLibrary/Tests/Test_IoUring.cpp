@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <string>
+#include "IoUring.h"
+
+// io_uring 이 막힌 환경(seccomp, sysctl)에서는 건너뛴다
+#define SKIP_WITHOUT_IO_URING()                                   \
+    if (!IoUring::IsSupported())                                  \
+        GTEST_SKIP() << "io_uring not available"
+
+TEST(IoUring, NopCompletes)
+{
+    SKIP_WITHOUT_IO_URING();
+
+    IoUring ring;
+    ASSERT_EQ(ring.Open(8), IoUring_Ok);
+
+    io_uring_sqe *sqe = ring.GetSqe();
+    ASSERT_NE(sqe, nullptr);
+    sqe->opcode = IORING_OP_NOP;
+    sqe->user_data = 42;
+    ASSERT_EQ(ring.SubmitAndWait(1, 1000), IoUring_Ok);
+
+    io_uring_cqe *cqe = nullptr;
+    ASSERT_EQ(ring.PeekCqes(&cqe, 1), 1u);
+    EXPECT_EQ(cqe->user_data, 42u);
+    EXPECT_EQ(cqe->res, 0);
+    ring.Advance(1);
+    EXPECT_EQ(ring.PeekCqes(&cqe, 1), 0u);
+}
+
+TEST(IoUring, WaitTimesOut)
+{
+    SKIP_WITHOUT_IO_URING();
+
+    IoUring ring;
+    ASSERT_EQ(ring.Open(8), IoUring_Ok);
+    EXPECT_EQ(ring.SubmitAndWait(1, 10), IoUring_Timeout);
+}
+
+TEST(IoUring, MultishotRecvUsesProvidedBuffers)
+{
+    SKIP_WITHOUT_IO_URING();
+
+    IoUring ring;
+    ASSERT_EQ(ring.Open(16), IoUring_Ok);
+    IoUringBufferRing buffers;
+    ASSERT_EQ(buffers.Open(ring, 3, 4, 64), IoUring_Ok);
+
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+    io_uring_sqe *sqe = ring.GetSqe();
+    ASSERT_NE(sqe, nullptr);
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = fds[0];
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = buffers.GroupId();
+    sqe->user_data = 7;
+    ASSERT_EQ(ring.Submit(), IoUring_Ok);
+
+    // 버퍼 수(4)보다 많이 받아도 Recycle 로 돌려주면 multishot 이 계속 이어져야 함
+    std::string received;
+    for (int i = 0; i < 8; ++i)
+    {
+        const std::string msg = "msg" + std::to_string(i);
+        ASSERT_EQ(::write(fds[1], msg.data(), msg.size()), static_cast<ssize_t>(msg.size()));
+
+        bool got = false;
+        while (!got)
+        {
+            ASSERT_EQ(ring.SubmitAndWait(1, 1000), IoUring_Ok);
+            io_uring_cqe *cqe = nullptr;
+            ASSERT_EQ(ring.PeekCqes(&cqe, 1), 1u);
+            const io_uring_cqe c = *cqe;
+            ring.Advance(1);
+            if (c.user_data == IoUringBufferRing::kProvideUserData)
+                continue;
+
+            ASSERT_EQ(c.user_data, 7u);
+            ASSERT_GT(c.res, 0);
+            ASSERT_TRUE(c.flags & IORING_CQE_F_BUFFER);
+            ASSERT_TRUE(c.flags & IORING_CQE_F_MORE);
+            const std::uint16_t bid = IoUringBufferRing::BufferId(c.flags);
+            received.append(reinterpret_cast<const char *>(buffers.Buffer(bid)), static_cast<size_t>(c.res));
+            buffers.Recycle(bid);
+            got = true;
+        }
+    }
+    EXPECT_EQ(received, "msg0msg1msg2msg3msg4msg5msg6msg7");
+
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
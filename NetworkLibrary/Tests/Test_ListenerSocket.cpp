@@ -0,0 +1,19 @@
+#include <gtest/gtest.h>
+#include "ListenerSocket.h"
+
+TEST(ListenerSocket, ReusePortAllowsListenersOnSamePort)
+{
+    constexpr uint16_t kPort = 38471;
+
+    ListenerSocket first(kPort);
+    ListenerSocket second(kPort);
+    first.SetReusePort(true);
+    second.SetReusePort(true);
+
+    ASSERT_EQ(first.Open(), ListenerSocket_Ok);
+    EXPECT_EQ(second.Open(), ListenerSocket_Ok);
+
+    // reuseport 없이 같은 포트는 bind 실패
+    ListenerSocket plain(kPort);
+    EXPECT_EQ(plain.Open(), ListenerSocket_BindFailed);
+}
@@ -93,3 +93,33 @@ TEST(MessageFramer, OverflowWhenLengthTooLarge)
     Frame f;
     EXPECT_EQ(MessageFramer::PopFrame(rb, f), eFrameError::Framer_Overflow);
 }
+
+TEST(MessageFramer, MirroredFrameAcrossWrap)
+{
+    RecvBuffer rb(4096, RingBuffer_Mirrored);
+    ASSERT_EQ(rb.Open(), RecvBuf_Ok);
+    ASSERT_TRUE(rb.IsMirrored());
+
+    // ring 끝 근처까지 채웠다 비워서 다음 프레임이 물리적으로 wrap 되게 함
+    std::vector<std::uint8_t> filler(rb.BufSize() - 3, 0);
+    WriteAll(rb, filler.data(), filler.size());
+    ASSERT_EQ(rb.Consume(filler.size() - 1), RecvBuf_Ok);
+    std::uint8_t skip = 0;
+    size_t skipped = 0;
+    ASSERT_EQ(rb.Read(&skip, 1, skipped), RecvBuf_Ok);
+
+    std::vector<std::uint8_t> encoded;
+    ASSERT_EQ(MessageFramer::Encode("WRAPPED", 7, encoded), eFrameError::Framer_Ok);
+    WriteAll(rb, encoded.data(), encoded.size());
+
+    const std::uint8_t* data = nullptr;
+    size_t len = 0;
+    ASSERT_EQ(rb.PeekContiguous(data, len), RecvBuf_Ok);
+    EXPECT_EQ(len, encoded.size());
+
+    Frame f;
+    ASSERT_EQ(MessageFramer::PopFrame(rb, f), eFrameError::Framer_Ok);
+    ASSERT_EQ(f.payload.size(), 7u);
+    EXPECT_EQ(::memcmp(f.payload.data(), "WRAPPED", 7), 0);
+    EXPECT_TRUE(rb.IsEmpty());
+}
@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "MpscQueue.h"
+
+TEST(MpscQueue, PreservesPerProducerOrder)
+{
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 20000;
+
+    MpscQueue<std::uint64_t> q;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&q, p] {
+            for (int i = 0; i < kPerProducer; ++i) {
+                q.Push((static_cast<std::uint64_t>(p) << 32) | static_cast<std::uint64_t>(i));
+            }
+        });
+    }
+
+    std::vector<int> next(kProducers, 0);
+    int received = 0;
+    while (received < kProducers * kPerProducer) {
+        std::uint64_t v = 0;
+        if (!q.TryPop(v)) {
+            std::this_thread::yield();
+            continue;
+        }
+        const int p = static_cast<int>(v >> 32);
+        const int i = static_cast<int>(v & 0xffffffffu);
+        ASSERT_EQ(i, next[p]);
+        ++next[p];
+        ++received;
+    }
+
+    for (auto& t : producers) t.join();
+    EXPECT_TRUE(q.IsEmpty());
+}
+
+TEST(MpscQueue, DestroysUnpoppedValues)
+{
+    auto tracker = std::make_shared<int>(0);
+    std::shared_ptr<int> out;
+    {
+        MpscQueue<std::shared_ptr<int>> q;
+        q.Push(std::shared_ptr<int>(tracker));
+        q.Push(std::shared_ptr<int>(tracker));
+
+        ASSERT_TRUE(q.TryPop(out));
+        EXPECT_EQ(tracker.use_count(), 3);
+    }
+    // 꺼내지 않은 하나는 queue 와 함께 해제
+    EXPECT_EQ(tracker.use_count(), 2);
+}
@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
 #include "RingBuffer.h"
+#include "RingStoragePool.h"
+#include "SlabAllocator.h"
 
 TEST(RingBuffer, WritePeekConsumeReadBasic)
 {
@@ -40,3 +44,170 @@ TEST(RingBuffer, WrapAroundKeepsOrder)
     EXPECT_EQ(rb.Read(out2, 6), 6u);
     EXPECT_EQ(::memcmp(out2, "56ABCD", 6), 0);
 }
+
+TEST(RingBuffer, FullAndEmptyFromCursorDifference)
+{
+    RingBuffer rb(8);
+    EXPECT_TRUE(rb.IsPowerOfTwo());
+
+    EXPECT_EQ(rb.Write("12345678", 8), 8u);
+    EXPECT_TRUE(rb.IsFull());
+    EXPECT_EQ(rb.FreeSpace(), 0u);
+    EXPECT_EQ(rb.Write("9", 1), 0u);
+
+    char out[8]{};
+    for (int round = 0; round < 100; ++round) {
+        // 매 라운드 3바이트씩 밀어서 cursor 가 계속 wrap 되게 함
+        EXPECT_EQ(rb.Read(out, 3), 3u);
+        EXPECT_FALSE(rb.IsFull());
+        EXPECT_EQ(rb.Write("abc", 3), 3u);
+        EXPECT_TRUE(rb.IsFull());
+        EXPECT_EQ(rb.DataSpace(), 8u);
+    }
+
+    EXPECT_EQ(rb.Read(out, 8), 8u);
+    EXPECT_TRUE(rb.IsEmpty());
+    EXPECT_EQ(rb.FreeSpace(), 8u);
+}
+
+TEST(RingBuffer, NonPowerOfTwoCapacityWraps)
+{
+    RingBuffer rb(7);
+    EXPECT_FALSE(rb.IsPowerOfTwo());
+
+    EXPECT_EQ(rb.Write("12345", 5), 5u);
+    rb.Consume(4);
+    EXPECT_EQ(rb.Write("ABCDEF", 6), 6u);
+    EXPECT_TRUE(rb.IsFull());
+
+    char out[7]{};
+    EXPECT_EQ(rb.Peek(out, 7), 7u);
+    EXPECT_EQ(::memcmp(out, "5ABCDEF", 7), 0);
+
+    EXPECT_EQ(RingBuffer::RoundUpPowerOfTwo(7), 8u);
+    EXPECT_EQ(RingBuffer::RoundUpPowerOfTwo(4096), 4096u);
+}
+
+TEST(RingBuffer, MirroredRegionIsContiguousAcrossWrap)
+{
+    RingBuffer rb(4096, RingBuffer_Mirrored);
+    ASSERT_TRUE(rb.IsMirrored());
+    const size_t cap = rb.BufSize();
+    ASSERT_GE(cap, 4096u);
+
+    // 1바이트를 남겨 두어 cursor 가 reset 되지 않게 함 (다 비우면 offset 0 으로 돌아감)
+    std::vector<std::uint8_t> fill(cap - 8, 'x');
+    EXPECT_EQ(rb.Write(fill.data(), fill.size()), fill.size());
+    rb.Consume(fill.size() - 1);
+
+    // 끝에서 8바이트 남은 위치에서 16바이트 write → 물리적으로는 wrap
+    EXPECT_EQ(rb.Write("0123456789ABCDEF", 16), 16u);
+
+    // 남겨 둔 1바이트 + 16바이트가 물리적 끝을 넘어 한 구간으로 보여야 함
+    size_t len = 0;
+    const std::uint8_t* p = rb.ReadRegion(len);
+    ASSERT_NE(p, nullptr);
+    ASSERT_EQ(len, 17u);
+    EXPECT_EQ(p[0], 'x');
+    EXPECT_EQ(::memcmp(p + 1, "0123456789ABCDEF", 16), 0);
+
+    size_t freeLen = 0;
+    EXPECT_NE(rb.WriteRegion(freeLen), nullptr);
+    EXPECT_EQ(freeLen, cap - 17);
+}
+
+TEST(RingBuffer, HeapRegionStopsAtWrap)
+{
+    RingBuffer rb(8);
+    EXPECT_FALSE(rb.IsMirrored());
+
+    EXPECT_EQ(rb.Write("123456", 6), 6u);
+    rb.Consume(5);
+    EXPECT_EQ(rb.Write("ABCD", 4), 4u);
+
+    size_t len = 0;
+    const std::uint8_t* p = rb.ReadRegion(len);
+    ASSERT_EQ(len, 3u);
+    EXPECT_EQ(::memcmp(p, "6AB", 3), 0);
+}
+
+TEST(RingBuffer, SpansCoverWrappedDataAndFreeSpace)
+{
+    RingBuffer rb(8);
+    EXPECT_EQ(rb.Write("123456", 6), 6u);
+    rb.Consume(4);
+
+    struct iovec spans[2];
+    ASSERT_EQ(rb.GetWritableSpans(spans, 2), 2);
+    EXPECT_EQ(spans[0].iov_len, 2u);
+    EXPECT_EQ(spans[1].iov_len, 4u);
+
+    // 두 구간에 직접 채운 뒤 commit
+    ::memcpy(spans[0].iov_base, "AB", 2);
+    ::memcpy(spans[1].iov_base, "CD", 2);
+    EXPECT_EQ(rb.CommitWrite(4), 4u);
+
+    ASSERT_EQ(rb.GetReadableSpans(spans, 2), 2);
+    EXPECT_EQ(spans[0].iov_len, 4u);
+    EXPECT_EQ(::memcmp(spans[0].iov_base, "56AB", 4), 0);
+    EXPECT_EQ(spans[1].iov_len, 2u);
+    EXPECT_EQ(::memcmp(spans[1].iov_base, "CD", 2), 0);
+
+    ASSERT_EQ(rb.GetReadableSpans(spans, 1), 1);
+    EXPECT_EQ(spans[0].iov_len, 4u);
+}
+
+TEST(RingBuffer, LazyStorageIsReturnedWhenEmptyAndReused)
+{
+    SlabAllocator& slab = SlabAllocator::Global();
+    const size_t baseline = slab.Stats().inUseBytes;
+
+    RingBuffer rb(4096);
+    EXPECT_EQ(slab.Stats().inUseBytes, baseline + 4096);
+    rb.SetLazy(true);
+    EXPECT_FALSE(rb.HasStorage());
+    EXPECT_EQ(rb.FreeSpace(), 4096u);
+    EXPECT_EQ(slab.Stats().inUseBytes, baseline);
+
+    EXPECT_EQ(rb.Write("hello", 5), 5u);
+    EXPECT_TRUE(rb.HasStorage());
+
+    char out[8] = {};
+    EXPECT_EQ(rb.Read(out, 3), 3u);
+    EXPECT_TRUE(rb.HasStorage());
+    EXPECT_EQ(rb.Read(out + 3, 8), 2u);
+    EXPECT_EQ(::memcmp(out, "hello", 5), 0);
+    EXPECT_FALSE(rb.HasStorage());
+    EXPECT_EQ(slab.Stats().inUseBytes, baseline);
+}
+
+TEST(RingBuffer, MirroredStorageIsCachedUpToByteCap)
+{
+    RingStoragePool& pool = RingStoragePool::Local();
+    pool.Trim();
+    const size_t savedCap = pool.MaxCachedBytes();
+
+    {
+        RingBuffer probe(4096, RingBuffer_Mirrored);
+        ASSERT_TRUE(probe.IsMirrored());
+        pool.SetMaxCachedBytes(probe.BufSize() * 2);
+
+        RingBuffer a(4096, RingBuffer_Mirrored);
+        RingBuffer b(4096, RingBuffer_Mirrored);
+    }
+    // 3 개가 반납됐지만 상한 때문에 2 개만 보관
+    EXPECT_EQ(pool.CachedBlocks(), 2u);
+
+    const std::uint8_t* cached = nullptr;
+    {
+        RingBuffer reuse(4096, RingBuffer_Mirrored);
+        EXPECT_EQ(pool.CachedBlocks(), 1u);
+        EXPECT_TRUE(reuse.IsMirrored());
+        size_t len = 0;
+        cached = reuse.ReadRegion(len);
+    }
+    EXPECT_NE(cached, nullptr);
+
+    pool.SetMaxCachedBytes(savedCap);
+    pool.Trim();
+}
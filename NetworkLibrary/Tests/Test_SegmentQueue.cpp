@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <string.h>
+#include <vector>
+#include "SegmentQueue.h"
+#include "SendBuffer.h"
+
+TEST(SegmentQueue, GrowsAcrossSegmentsAndReturnsThemToPool)
+{
+    SegmentPool pool(8);
+    SegmentQueue q(0, pool);
+
+    std::vector<std::uint8_t> data(SendSegment::kCapacity * 3 + 100);
+    for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<std::uint8_t>(i * 31);
+
+    EXPECT_EQ(q.Write(data.data(), data.size()), data.size());
+    EXPECT_EQ(q.SegmentCount(), 4u);
+    EXPECT_EQ(q.DataSpace(), data.size());
+
+    struct iovec spans[8];
+    ASSERT_EQ(q.GetReadableSpans(spans, 8), 4);
+    EXPECT_EQ(spans[3].iov_len, 100u);
+
+    // 첫 segment 를 넘겨서 consume → 다 쓴 segment 는 pool 로
+    q.Consume(SendSegment::kCapacity + 10);
+    EXPECT_EQ(q.SegmentCount(), 3u);
+    EXPECT_EQ(pool.CachedCount(), 1u);
+
+    std::vector<std::uint8_t> rest(data.size());
+    const size_t n = q.Read(rest.data(), rest.size());
+    ASSERT_EQ(n, data.size() - SendSegment::kCapacity - 10);
+    EXPECT_EQ(::memcmp(rest.data(), data.data() + SendSegment::kCapacity + 10, n), 0);
+
+    EXPECT_TRUE(q.IsEmpty());
+    EXPECT_EQ(q.SegmentCount(), 0u);
+    EXPECT_EQ(pool.CachedCount(), 4u);
+}
+
+TEST(SegmentQueue, RespectsMaxBytes)
+{
+    SegmentPool pool;
+    SegmentQueue q(10, pool);
+
+    EXPECT_EQ(q.Write("0123456789ABC", 13), 10u);
+    EXPECT_TRUE(q.IsFull());
+    EXPECT_EQ(q.FreeSpace(), 0u);
+}
+
+TEST(SendBuffer, SegmentedModeAcceptsLargerThanRing)
+{
+    SendBuffer sb(0, RingBuffer_Heap, SendBufMode_Segmented);
+    ASSERT_EQ(sb.Open(), SendBuf_Ok);
+    EXPECT_EQ(sb.Mode(), SendBufMode_Segmented);
+
+    std::vector<std::uint8_t> big(1024 * 1024, 'z');
+    size_t written = 0;
+    ASSERT_EQ(sb.Write(big.data(), big.size(), written), SendBuf_Ok);
+    EXPECT_EQ(written, big.size());
+    EXPECT_EQ(sb.WriteSpace(), big.size());
+
+    ASSERT_EQ(sb.Consume(big.size()), SendBuf_Ok);
+    EXPECT_TRUE(sb.IsEmpty());
+}
+
+TEST(SegmentQueue, SharedSegmentSpansPrefixAndBody)
+{
+    SegmentPool pool;
+    SegmentQueue q(0, pool);
+
+    SharedBuffer body = MakeSharedBuffer("payload", 7);
+    ASSERT_EQ(q.Write("a", 1), 1u);
+    ASSERT_TRUE(q.AppendShared(body, "HD", 2));
+    ASSERT_EQ(q.Write("z", 1), 1u);
+    EXPECT_EQ(q.DataSpace(), 11u);
+    EXPECT_EQ(body.use_count(), 2);
+
+    struct iovec spans[8];
+    ASSERT_EQ(q.GetReadableSpans(spans, 8), 4);
+    EXPECT_EQ(spans[1].iov_len, 2u);
+    EXPECT_EQ(spans[2].iov_base, body->data());
+
+    // prefix 중간까지 소비한 뒤에도 순서대로 읽혀야 함
+    q.Consume(2);
+    char out[16]{};
+    ASSERT_EQ(q.Read(out, sizeof(out)), 9u);
+    EXPECT_EQ(::memcmp(out, "Dpayloadz", 9), 0);
+    EXPECT_EQ(body.use_count(), 1);
+}
@@ -49,3 +49,28 @@ TEST(SendBuffer, PartialConsumeMaintainsOrder)
     ASSERT_EQ(read, 4u);
     EXPECT_EQ(::memcmp(tmp, "DEFG", 4), 0);
 }
+
+TEST(SendBuffer, ReadableSpansThenConsume)
+{
+    SendBuffer sb(8);
+    ASSERT_EQ(sb.Open(), SendBuf_Ok);
+
+    SBWriteAll(sb, "abcdef", 6);
+    ASSERT_EQ(sb.Consume(5), SendBuf_Ok);
+    SBWriteAll(sb, "ghij", 4);
+
+    struct iovec spans[2];
+    int count = 0;
+    ASSERT_EQ(sb.GetReadableSpans(spans, 2, count), SendBuf_Ok);
+    ASSERT_EQ(count, 2);
+    EXPECT_EQ(spans[0].iov_len + spans[1].iov_len, 5u);
+
+    ASSERT_EQ(sb.Consume(spans[0].iov_len), SendBuf_Ok);
+
+    ASSERT_EQ(sb.GetReadableSpans(spans, 2, count), SendBuf_Ok);
+    ASSERT_EQ(count, 1);
+    EXPECT_EQ(spans[0].iov_len, 2u);
+    EXPECT_EQ(::memcmp(spans[0].iov_base, "ij", 2), 0);
+
+    EXPECT_EQ(sb.CommitWrite(100), SendBuf_Overflow);
+}
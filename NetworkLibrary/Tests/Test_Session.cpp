@@ -0,0 +1,529 @@
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <chrono>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <linux/sockios.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "Session.h"
+
+static void MakeSessionPair(Socket& local, int& peerFd)
+{
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    local = Socket(fds[0]);
+    ASSERT_EQ(local.SetBlocking(false), Socket_Ok);
+    peerFd = fds[1];
+}
+
+using TestClock = std::chrono::steady_clock;
+
+// 송신 루프가 멈추면 ctest 가 끝나지 않으므로 수신 대기는 항상 기한을 둔다
+static TestClock::time_point ReceiveDeadline()
+{
+    return TestClock::now() + std::chrono::seconds(5);
+}
+
+// fd 가 읽을 수 있게 될 때까지 최대 10ms 대기
+static void WaitReadable(int fd)
+{
+    pollfd pfd{fd, POLLIN, 0};
+    ::poll(&pfd, 1, 10);
+}
+
+// MSG_ZEROCOPY 는 AF_UNIX 에서 지원되지 않으므로 loopback TCP 연결을 만든다.
+// peerRcvBuf 를 주면 peer 의 수신 window 를 줄여 보낸 데이터가 송신 측에 머물게 한다.
+static void MakeTcpSessionPair(Socket& local, int& peerFd, int peerRcvBuf = 0)
+{
+    int listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_GE(listenFd, 0);
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = ::htonl(INADDR_LOOPBACK);
+    ASSERT_EQ(::bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+    ASSERT_EQ(::listen(listenFd, 1), 0);
+
+    socklen_t len = sizeof(addr);
+    ASSERT_EQ(::getsockname(listenFd, reinterpret_cast<sockaddr*>(&addr), &len), 0);
+
+    peerFd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (peerRcvBuf > 0) {
+        ASSERT_EQ(::setsockopt(peerFd, SOL_SOCKET, SO_RCVBUF, &peerRcvBuf, sizeof(peerRcvBuf)), 0);
+    }
+    ASSERT_EQ(::connect(peerFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+
+    local = Socket(::accept(listenFd, nullptr, nullptr));
+    ::close(listenFd);
+    ASSERT_TRUE(local.IsOpen());
+    ASSERT_EQ(local.SetBlocking(false), Socket_Ok);
+}
+
+TEST(Session, OnReadableReadsDirectlyIntoRing)
+{
+    Socket sock;
+    int peer = -1;
+    MakeSessionPair(sock, peer);
+
+    Session s(16 * 1024, 16 * 1024, std::move(sock));
+    ASSERT_EQ(s.Open(16 * 1024, 16 * 1024), Session_Ok);
+
+    std::vector<std::uint8_t> payload(10000);
+    for (size_t i = 0; i < payload.size(); ++i) payload[i] = static_cast<std::uint8_t>(i * 7);
+    ASSERT_EQ(::write(peer, payload.data(), payload.size()), (ssize_t)payload.size());
+
+    std::vector<std::uint8_t> received;
+    s.SetRecvCallback([&](Session&, RecvBuffer& rb) {
+        std::uint8_t tmp[4096];
+        size_t n = 0;
+        while (!rb.IsEmpty() && rb.Read(tmp, sizeof(tmp), n) == RecvBuf_Ok) {
+            received.insert(received.end(), tmp, tmp + n);
+        }
+    });
+
+    EXPECT_EQ(s.OnReadable(), Session_Ok);
+    EXPECT_EQ(received, payload);
+
+    ::close(peer);
+}
+
+TEST(Session, IoBudgetDrainsAcrossRingAndFlagsRetry)
+{
+    Socket sock;
+    int peer = -1;
+    MakeSessionPair(sock, peer);
+
+    // ring 4KB, budget 12KB: ring 을 세 번 비우며 읽은 뒤 멈춰야 함
+    Session s(4096, 4096, std::move(sock));
+    ASSERT_EQ(s.Open(4096, 4096), Session_Ok);
+    s.SetIoBudget(12 * 1024);
+
+    std::vector<std::uint8_t> payload(20000);
+    for (size_t i = 0; i < payload.size(); ++i) payload[i] = static_cast<std::uint8_t>(i * 3);
+    ASSERT_EQ(::write(peer, payload.data(), payload.size()), (ssize_t)payload.size());
+
+    std::vector<std::uint8_t> received;
+    s.SetRecvCallback([&](Session&, RecvBuffer& rb) {
+        std::uint8_t tmp[4096];
+        size_t n = 0;
+        while (!rb.IsEmpty() && rb.Read(tmp, sizeof(tmp), n) == RecvBuf_Ok) {
+            received.insert(received.end(), tmp, tmp + n);
+        }
+    });
+
+    ASSERT_EQ(s.OnReadable(), Session_Ok);
+    EXPECT_EQ(received.size(), 12u * 1024);
+    EXPECT_TRUE(s.NeedsReadRetry());
+
+    // edge-triggered 라면 새 이벤트 없이 다시 불러 나머지를 읽는다
+    ASSERT_EQ(s.OnReadable(), Session_Ok);
+    EXPECT_FALSE(s.NeedsReadRetry());
+    EXPECT_EQ(received, payload);
+
+    ::close(peer);
+}
+
+TEST(Session, LazyBuffersHoldNoStorageWhileIdle)
+{
+    Socket sock;
+    int peer = -1;
+    MakeSessionPair(sock, peer);
+
+    Session s(16 * 1024, 16 * 1024, std::move(sock));
+    ASSERT_EQ(s.Open(16 * 1024, 16 * 1024), Session_Ok);
+    s.SetLazyBuffers(true);
+    EXPECT_FALSE(s.RecvBuf().HasStorage());
+    EXPECT_FALSE(s.SendBuf().HasStorage());
+
+    s.SetRecvCallback([](Session& self, RecvBuffer& rb) {
+        std::uint8_t tmp[64];
+        size_t n = 0;
+        while (!rb.IsEmpty() && rb.Read(tmp, sizeof(tmp), n) == RecvBuf_Ok) {
+            self.QueueSend(tmp, n);
+        }
+    });
+
+    ASSERT_EQ(::write(peer, "ping", 4), 4);
+    ASSERT_EQ(s.OnReadable(), Session_Ok);
+    ASSERT_EQ(s.FlushSend(), Session_Ok);
+
+    char echo[8] = {};
+    ASSERT_EQ(::recv(peer, echo, sizeof(echo), 0), 4);
+    EXPECT_EQ(::memcmp(echo, "ping", 4), 0);
+
+    // 요청을 다 처리하고 응답도 다 보냈으면 두 ring 모두 반납된 상태
+    EXPECT_FALSE(s.RecvBuf().HasStorage());
+    EXPECT_FALSE(s.SendBuf().HasStorage());
+
+    ::close(peer);
+}
+
+TEST(Session, OnReadableDetectsPeerClose)
+{
+    Socket sock;
+    int peer = -1;
+    MakeSessionPair(sock, peer);
+
+    Session s(4096, 4096, std::move(sock));
+    ASSERT_EQ(s.Open(4096, 4096), Session_Ok);
+
+    bool closed = false;
+    s.SetCloseCallback([&](Session&) { closed = true; });
+
+    ::close(peer);
+    EXPECT_EQ(s.OnReadable(), Session_PeerClosed);
+    EXPECT_TRUE(closed);
+    EXPECT_FALSE(s.IsOpen());
+}
+
+TEST(Session, OnWritableConsumesOnlyWhatKernelAccepted)
+{
+    Socket sock;
+    int peer = -1;
+    MakeSessionPair(sock, peer);
+
+    // 커널 송신 버퍼를 작게 잡아 partial write 를 유도
+    int small = 4096;
+    ASSERT_EQ(::setsockopt(sock.GetFd(), SOL_SOCKET, SO_SNDBUF, &small, sizeof(small)), 0);
+
+    Session s(64 * 1024, 64 * 1024, std::move(sock));
+    ASSERT_EQ(s.Open(64 * 1024, 64 * 1024), Session_Ok);
+
+    int interestOn = 0, interestOff = 0;
+    s.SetWriteInterestCallback([&](Session&, bool enable) { enable ? ++interestOn : ++interestOff; });
+
+    std::vector<std::uint8_t> payload(60000);
+    for (size_t i = 0; i < payload.size(); ++i) payload[i] = static_cast<std::uint8_t>(i * 13);
+    ASSERT_EQ(s.QueueSend(payload.data(), payload.size()), Session_Ok);
+    EXPECT_EQ(interestOn, 1);
+
+    std::vector<std::uint8_t> received;
+    std::uint8_t tmp[8192];
+    const auto deadline = ReceiveDeadline();
+    while (received.size() < payload.size()) {
+        ASSERT_LT(TestClock::now(), deadline) << "received " << received.size() << " of " << payload.size();
+        ASSERT_EQ(s.FlushSend(), Session_Ok);
+        WaitReadable(peer);
+        ssize_t n = ::recv(peer, tmp, sizeof(tmp), MSG_DONTWAIT);
+        if (n > 0) received.insert(received.end(), tmp, tmp + n);
+    }
+
+    EXPECT_EQ(received, payload);
+    EXPECT_FALSE(s.HasPendingSend());
+    EXPECT_EQ(interestOff, 1);
+
+    ::close(peer);
+}
+
+TEST(Session, SegmentedSendQueueHandlesLargeResponse)
+{
+    Socket sock;
+    int peer = -1;
+    MakeSessionPair(sock, peer);
+
+    Session s(4096, 0, std::move(sock), RingBuffer_Heap, SendBufMode_Segmented);
+    ASSERT_EQ(s.Open(4096, 0), Session_Ok);
+
+    std::vector<std::uint8_t> payload(1024 * 1024);
+    for (size_t i = 0; i < payload.size(); ++i) payload[i] = static_cast<std::uint8_t>(i * 5);
+    ASSERT_EQ(s.QueueSend(payload.data(), payload.size()), Session_Ok);
+
+    std::vector<std::uint8_t> received;
+    std::vector<std::uint8_t> tmp(64 * 1024);
+    const auto deadline = ReceiveDeadline();
+    while (received.size() < payload.size()) {
+        ASSERT_LT(TestClock::now(), deadline) << "received " << received.size() << " of " << payload.size();
+        ASSERT_EQ(s.OnWritable(), Session_Ok);
+        WaitReadable(peer);
+        ssize_t n = ::recv(peer, tmp.data(), tmp.size(), MSG_DONTWAIT);
+        if (n > 0) received.insert(received.end(), tmp.data(), tmp.data() + n);
+    }
+
+    EXPECT_EQ(received, payload);
+    EXPECT_FALSE(s.HasPendingSend());
+
+    ::close(peer);
+}
+
+TEST(Session, SendFrameSharedBroadcastsWithoutCopy)
+{
+    Socket sockA, sockB;
+    int peerA = -1, peerB = -1;
+    MakeSessionPair(sockA, peerA);
+    MakeSessionPair(sockB, peerB);
+
+    Session a(4096, 0, std::move(sockA), RingBuffer_Heap, SendBufMode_Segmented);
+    Session b(4096, 0, std::move(sockB), RingBuffer_Heap, SendBufMode_Segmented);
+    ASSERT_EQ(a.Open(4096, 0), Session_Ok);
+    ASSERT_EQ(b.Open(4096, 0), Session_Ok);
+
+    SharedBuffer payload = MakeSharedBuffer("broadcast", 9);
+    ASSERT_EQ(a.SendFrameShared(payload), Session_Ok);
+    ASSERT_EQ(b.SendFrameShared(payload), Session_Ok);
+    // 두 세션의 큐가 같은 buffer 를 참조
+    EXPECT_EQ(payload.use_count(), 3);
+
+    ASSERT_EQ(a.FlushSend(), Session_Ok);
+    ASSERT_EQ(b.FlushSend(), Session_Ok);
+    EXPECT_EQ(payload.use_count(), 1);
+
+    const std::uint8_t expected[] = {0, 0, 0, 9, 'b', 'r', 'o', 'a', 'd', 'c', 'a', 's', 't'};
+    for (int peer : {peerA, peerB}) {
+        std::uint8_t tmp[64];
+        ASSERT_EQ(::recv(peer, tmp, sizeof(tmp), MSG_DONTWAIT), static_cast<ssize_t>(sizeof(expected)));
+        EXPECT_EQ(::memcmp(tmp, expected, sizeof(expected)), 0);
+        ::close(peer);
+    }
+}
+
+TEST(Session, ZeroCopyHoldsBufferUntilCompletion)
+{
+    Socket sock;
+    int peer = -1;
+    MakeTcpSessionPair(sock, peer);
+
+    Session s(4096, 0, std::move(sock), RingBuffer_Heap, SendBufMode_Segmented);
+    ASSERT_EQ(s.Open(4096, 0), Session_Ok);
+    if (s.EnableZeroCopy(64 * 1024) != Session_Ok) {
+        ::close(peer);
+        GTEST_SKIP() << "SO_ZEROCOPY not supported";
+    }
+
+    std::vector<std::uint8_t> bytes(256 * 1024);
+    for (size_t i = 0; i < bytes.size(); ++i) bytes[i] = static_cast<std::uint8_t>(i * 13);
+    SharedBuffer body = MakeSharedBuffer(std::vector<std::uint8_t>(bytes));
+
+    ASSERT_EQ(s.QueueSend("HEAD", 4), Session_Ok);
+    ASSERT_EQ(s.QueueSendShared(body), Session_Ok);
+    ASSERT_EQ(s.QueueSend("TAIL", 4), Session_Ok);
+
+    std::vector<std::uint8_t> received;
+    std::vector<std::uint8_t> tmp(64 * 1024);
+    const auto deadline = ReceiveDeadline();
+    while (received.size() < bytes.size() + 8) {
+        ASSERT_LT(TestClock::now(), deadline) << "received " << received.size() << " of " << bytes.size() + 8;
+        ASSERT_EQ(s.FlushSend(), Session_Ok);
+        ssize_t n = ::recv(peer, tmp.data(), tmp.size(), MSG_DONTWAIT);
+        if (n > 0) received.insert(received.end(), tmp.data(), tmp.data() + n);
+        else WaitReadable(peer);
+    }
+    EXPECT_FALSE(s.HasPendingSend());
+    EXPECT_EQ(::memcmp(received.data(), "HEAD", 4), 0);
+    EXPECT_EQ(::memcmp(received.data() + 4, bytes.data(), bytes.size()), 0);
+    EXPECT_EQ(::memcmp(received.data() + 4 + bytes.size(), "TAIL", 4), 0);
+
+    // 큐에서는 빠졌지만 완료 통지 전까지는 세션이 참조를 쥐고 있어야 함
+    ASSERT_GT(s.PendingZeroCopyCount(), 0u);
+    EXPECT_GT(body.use_count(), 1);
+
+    for (int i = 0; i < 100 && s.PendingZeroCopyCount() > 0; ++i) {
+        pollfd pfd{s.Fd(), 0, 0};
+        ::poll(&pfd, 1, 10);
+        if (pfd.revents & POLLERR) {
+            ASSERT_EQ(s.OnError(), Session_Ok);
+        }
+    }
+    EXPECT_EQ(s.PendingZeroCopyCount(), 0u);
+    EXPECT_EQ(body.use_count(), 1);
+    EXPECT_TRUE(s.IsOpen());
+
+    ::close(peer);
+}
+
+TEST(Session, ZeroCopyCloseKeepsBufferUntilCompletion)
+{
+    Socket sock;
+    int peer = -1;
+    MakeTcpSessionPair(sock, peer, 4096);
+
+    Session s(4096, 0, std::move(sock), RingBuffer_Heap, SendBufMode_Segmented);
+    ASSERT_EQ(s.Open(4096, 0), Session_Ok);
+    if (s.EnableZeroCopy(64 * 1024) != Session_Ok) {
+        ::close(peer);
+        GTEST_SKIP() << "SO_ZEROCOPY not supported";
+    }
+
+    std::vector<std::uint8_t> bytes(1024 * 1024);
+    for (size_t i = 0; i < bytes.size(); ++i) bytes[i] = static_cast<std::uint8_t>(i * 13);
+    SharedBuffer body = MakeSharedBuffer(std::vector<std::uint8_t>(bytes));
+
+    ASSERT_EQ(s.QueueSendShared(body), Session_Ok);
+    ASSERT_EQ(s.FlushSend(), Session_Ok);
+    ASSERT_GT(s.PendingZeroCopyCount(), 0u);
+
+    // peer 가 읽지 않아 아직 보내지 못한 바이트가 송신 큐에 남아 있음
+    int unsent = 0;
+    ASSERT_EQ(::ioctl(s.Fd(), SIOCOUTQ, &unsent), 0);
+    ASSERT_GT(unsent, 0);
+
+    // 커널이 아직 body 로 보내는 중: Close 뒤에도 참조가 남아 있어야 함
+    ZeroCopyLinger& linger = ZeroCopyLinger::Local();
+    const size_t lingering = linger.Count();
+    s.Close();
+    EXPECT_FALSE(s.IsOpen());
+    EXPECT_EQ(linger.Count(), lingering + 1);
+    EXPECT_GT(body.use_count(), 1);
+
+    // 읽지 않은 데이터가 있는 채로 peer 를 닫으면 RST 가 와서 커널이 송신 큐를 버리고 완료 통지를 올린다
+    ::close(peer);
+    const auto deadline = ReceiveDeadline();
+    while (linger.Count() > lingering) {
+        ASSERT_LT(TestClock::now(), deadline);
+        linger.Poll();
+        ::poll(nullptr, 0, 1);
+    }
+    EXPECT_EQ(body.use_count(), 1);
+}
+
+TEST(Session, ZeroCopyRequiresSegmentedMode)
+{
+    Socket sock;
+    int peer = -1;
+    MakeTcpSessionPair(sock, peer);
+
+    Session s(4096, 4096, std::move(sock));
+    ASSERT_EQ(s.Open(4096, 4096), Session_Ok);
+    EXPECT_EQ(s.EnableZeroCopy(), Session_InvalidArgs);
+    EXPECT_FALSE(s.IsZeroCopyEnabled());
+
+    ::close(peer);
+}
+
+TEST(Session, SendWatermarksPauseAndResume)
+{
+    Socket sock;
+    int peer = -1;
+    MakeSessionPair(sock, peer);
+
+    Session s(4096, 4096, std::move(sock));
+    ASSERT_EQ(s.Open(4096, 4096), Session_Ok);
+    EXPECT_EQ(s.SetSendWatermarks(64, 32), Session_InvalidArgs);
+    ASSERT_EQ(s.SetSendWatermarks(32, 64), Session_Ok);
+
+    std::vector<bool> transitions;
+    s.SetWatermarkCallback([&](Session&, bool aboveHigh) { transitions.push_back(aboveHigh); });
+
+    // 멈춘 동안 들어온 frame 은 처리하지 않고 recv buffer 에 남겨야 함
+    int frames = 0;
+    s.SetFrameCallback([&](Session&, const std::uint8_t*, std::size_t) { ++frames; });
+
+    std::vector<std::uint8_t> chunk(40, 'x');
+    ASSERT_EQ(s.QueueSend(chunk.data(), chunk.size()), Session_Ok);
+    EXPECT_FALSE(s.IsSendPaused());
+    ASSERT_EQ(s.QueueSend(chunk.data(), chunk.size()), Session_Ok);
+    EXPECT_TRUE(s.IsSendPaused());
+    ASSERT_EQ(transitions.size(), 1u);
+    EXPECT_TRUE(transitions[0]);
+
+    const std::uint8_t frame[] = {0, 0, 0, 1, 'a'};
+    ASSERT_EQ(::send(peer, frame, sizeof(frame), 0), static_cast<ssize_t>(sizeof(frame)));
+    ASSERT_EQ(s.OnReadable(), Session_Ok);
+    EXPECT_EQ(frames, 0);
+    EXPECT_EQ(s.ResumeRecv(), Session_Ok);
+    EXPECT_EQ(frames, 0);
+
+    ASSERT_EQ(s.FlushSend(), Session_Ok);
+    EXPECT_FALSE(s.IsSendPaused());
+    ASSERT_EQ(transitions.size(), 2u);
+    EXPECT_FALSE(transitions[1]);
+
+    ASSERT_EQ(s.ResumeRecv(), Session_Ok);
+    EXPECT_EQ(frames, 1);
+
+    ::close(peer);
+}
+
+TEST(Session, DeliverRecvDispatchesCopiedBytes)
+{
+    Socket sock;
+    int peer = -1;
+    MakeSessionPair(sock, peer);
+
+    Session s(64, 64, std::move(sock));
+    ASSERT_EQ(s.Open(64, 64), Session_Ok);
+
+    std::string received;
+    s.SetRecvCallback([&](Session&, RecvBuffer& rb) {
+        char tmp[64];
+        size_t n = 0;
+        while (!rb.IsEmpty() && rb.Read(tmp, sizeof(tmp), n) == RecvBuf_Ok) received.append(tmp, n);
+    });
+
+    // recv buffer 보다 큰 덩어리도 중간에 콜백을 부르며 전부 받아야 함
+    const std::string payload(200, 'q');
+    size_t accepted = 0;
+    EXPECT_EQ(s.DeliverRecv(payload.data(), payload.size(), accepted), Session_Ok);
+    EXPECT_EQ(accepted, payload.size());
+    EXPECT_EQ(received, payload);
+
+    ::close(peer);
+}
+
+TEST(Session, PrepareSendKeepsBytesUntilCompletion)
+{
+    Socket sock;
+    int peer = -1;
+    MakeSessionPair(sock, peer);
+
+    Session s(4096, 4096, std::move(sock));
+    ASSERT_EQ(s.Open(4096, 4096), Session_Ok);
+
+    size_t sentCallbacks = 0;
+    s.SetSendCallback([&](Session&, size_t) { ++sentCallbacks; });
+
+    const std::string msg = "hello uring";
+    ASSERT_EQ(s.QueueSend(msg.data(), msg.size()), Session_Ok);
+
+    iovec spans[Session::kMaxSendSpans];
+    size_t bytes = 0;
+    ASSERT_GT(s.PrepareSend(spans, Session::kMaxSendSpans, bytes), 0);
+    EXPECT_EQ(bytes, msg.size());
+    EXPECT_TRUE(s.IsSendInFlight());
+
+    // 완료 전에는 같은 구간을 다시 내주지 않음
+    size_t again = 0;
+    EXPECT_EQ(s.PrepareSend(spans, Session::kMaxSendSpans, again), 0);
+
+    // 일부만 나갔으면 나머지는 다음 PrepareSend 로
+    ASSERT_EQ(s.CompleteSend(bytes, 5), Session_Ok);
+    EXPECT_FALSE(s.IsSendInFlight());
+    EXPECT_TRUE(s.HasPendingSend());
+    ASSERT_GT(s.PrepareSend(spans, Session::kMaxSendSpans, again), 0);
+    EXPECT_EQ(again, msg.size() - 5);
+    ASSERT_EQ(s.CompleteSend(again, again), Session_Ok);
+    EXPECT_FALSE(s.HasPendingSend());
+    EXPECT_EQ(sentCallbacks, 2u);
+
+    ::close(peer);
+}
+
+TEST(Session, OnReadableWithoutCallbackLeavesDispatchToCaller)
+{
+    Socket sock;
+    int peer = -1;
+    MakeSessionPair(sock, peer);
+
+    Session s(64, 64, std::move(sock));
+    ASSERT_EQ(s.Open(64, 64), Session_Ok);
+
+    // ring 보다 많이 와도 콜백이 없으면 닫지 않고 멈춰서 호출자가 비우기를 기다림
+    const std::string payload(100, 'z');
+    ASSERT_EQ(::write(peer, payload.data(), payload.size()), static_cast<ssize_t>(payload.size()));
+    EXPECT_EQ(s.OnReadable(), Session_Ok);
+    EXPECT_TRUE(s.IsOpen());
+    EXPECT_TRUE(s.NeedsReadRetry());
+
+    std::string received;
+    char tmp[128];
+    size_t n = 0;
+    while (!s.RecvBuf().IsEmpty() && s.RecvBuf().Read(tmp, sizeof(tmp), n) == RecvBuf_Ok) received.append(tmp, n);
+    EXPECT_EQ(s.OnReadable(), Session_Ok);
+    while (!s.RecvBuf().IsEmpty() && s.RecvBuf().Read(tmp, sizeof(tmp), n) == RecvBuf_Ok) received.append(tmp, n);
+    EXPECT_EQ(received, payload);
+
+    ::close(peer);
+}
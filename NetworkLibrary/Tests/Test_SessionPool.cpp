@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "SessionPool.h"
+
+static Socket MakeSocket(int& peerFd)
+{
+    int fds[2];
+    EXPECT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    peerFd = fds[1];
+    Socket sock(fds[0]);
+    sock.SetBlocking(false);
+    return sock;
+}
+
+static const std::uint8_t* RecvRingAddress(Session& s)
+{
+    struct iovec spans[2];
+    int count = 0;
+    EXPECT_EQ(s.RecvBuf().GetWritableSpans(spans, 2, count), RecvBuf_Ok);
+    return count > 0 ? static_cast<const std::uint8_t*>(spans[0].iov_base) : nullptr;
+}
+
+TEST(SessionPool, ReleasedSessionReusesBufferMemory)
+{
+    SessionPool pool(4096, 4096);
+    int peer = -1;
+
+    Session first = pool.Acquire(MakeSocket(peer));
+    ASSERT_EQ(first.Open(4096, 4096), Session_Ok);
+    const std::uint8_t* ring = RecvRingAddress(first);
+    ::close(peer);
+
+    bool stale = false;
+    first.SetRecvCallback([&](Session&, RecvBuffer&) { stale = true; });
+    pool.Release(std::move(first));
+    EXPECT_EQ(pool.CachedCount(), 1u);
+    EXPECT_EQ(pool.Misses(), 1u);
+
+    Session second = pool.Acquire(MakeSocket(peer));
+    EXPECT_EQ(pool.Hits(), 1u);
+    ASSERT_EQ(second.Open(4096, 4096), Session_Ok);
+    EXPECT_EQ(RecvRingAddress(second), ring);
+
+    // 이전 연결의 콜백은 따라오지 않음
+    ASSERT_EQ(::write(peer, "hi", 2), 2);
+    EXPECT_EQ(second.OnReadable(), Session_Ok);
+    EXPECT_FALSE(stale);
+    EXPECT_EQ(second.RecvBuf().FreeSpace(), 4096u - 2);
+
+    ::close(peer);
+}
+
+TEST(SessionPool, AcquireReplacesSessionThatCannotReattach)
+{
+    SessionPool pool(4096, 4096);
+    int peer = -1;
+
+    Session first = pool.Acquire(MakeSocket(peer));
+    ASSERT_EQ(first.Open(4096, 4096), Session_Ok);
+    ASSERT_EQ(first.QueueSend("hello", 5), Session_Ok);
+    struct iovec spans[2];
+    size_t bytes = 0;
+    ASSERT_GT(first.PrepareSend(spans, 2, bytes), 0);
+    ::close(peer);
+
+    // 송신 완료 전에 닫혀 돌아온 세션은 Reattach 할 수 없음
+    pool.Release(std::move(first));
+    ASSERT_EQ(pool.CachedCount(), 1u);
+
+    Socket sock = MakeSocket(peer);
+    const int fd = sock.GetFd();
+    Session second = pool.Acquire(std::move(sock));
+    EXPECT_EQ(pool.Hits(), 0u);
+    EXPECT_EQ(pool.Misses(), 2u);
+    EXPECT_EQ(pool.CachedCount(), 0u);
+    ASSERT_EQ(second.Open(4096, 4096), Session_Ok);
+    EXPECT_EQ(second.Fd(), fd);
+
+    ::close(peer);
+}
+
+TEST(SessionPool, ReserveAndCapLimitCachedSessions)
+{
+    SessionPool pool(4096, 4096, RingBuffer_Heap, SendBufMode_Ring, 4);
+    pool.Reserve(10);
+    EXPECT_EQ(pool.CachedCount(), 4u);
+
+    int peer = -1;
+    Session s = pool.Acquire(MakeSocket(peer));
+    EXPECT_EQ(pool.Hits(), 1u);
+    EXPECT_EQ(pool.CachedCount(), 3u);
+    ::close(peer);
+
+    pool.SetMaxCached(2);
+    EXPECT_EQ(pool.CachedCount(), 2u);
+    pool.Release(std::move(s));
+    pool.Release(pool.Acquire(Socket()));
+    EXPECT_EQ(pool.CachedCount(), 2u);
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <thread>
+#include "SlabAllocator.h"
+
+TEST(SlabAllocator, RoundsUpToPowerOfTwoClasses)
+{
+    EXPECT_EQ(SlabAllocator::ClassSize(1), 64u);
+    EXPECT_EQ(SlabAllocator::ClassSize(64), 64u);
+    EXPECT_EQ(SlabAllocator::ClassSize(65), 128u);
+    EXPECT_EQ(SlabAllocator::ClassSize(64 * 1024), 64u * 1024);
+    EXPECT_EQ(SlabAllocator::ClassSize(100000), 128u * 1024);
+    // 최대 class 보다 크면 그대로
+    EXPECT_EQ(SlabAllocator::ClassSize(5 * 1024 * 1024), 5u * 1024 * 1024);
+}
+
+TEST(SlabAllocator, ReusesFreedBlocksAndTracksStats)
+{
+    SlabAllocator slab;
+
+    void* a = slab.Allocate(60000);
+    void* b = slab.Allocate(60000);
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    std::memset(a, 0xAB, 60000);
+
+    SlabStats stats = slab.Stats();
+    EXPECT_EQ(stats.inUseBytes, 2u * 64 * 1024);
+    EXPECT_EQ(stats.reservedBytes, SlabAllocator::kChunkSize);
+    EXPECT_EQ(stats.freeBytes, 0u);
+
+    // 같은 chunk 에서 이어서 잘라냄
+    const auto distance = static_cast<std::uint8_t*>(b) - static_cast<std::uint8_t*>(a);
+    EXPECT_EQ(distance, 64 * 1024);
+
+    slab.Free(a, 60000);
+    stats = slab.Stats();
+    EXPECT_EQ(stats.inUseBytes, 64u * 1024);
+    EXPECT_EQ(stats.freeBytes, 64u * 1024);
+    EXPECT_EQ(stats.highWaterBytes, 2u * 64 * 1024);
+
+    EXPECT_EQ(slab.Allocate(40000), a);
+    slab.Free(a, 40000);
+    slab.Free(b, 60000);
+    EXPECT_EQ(slab.Stats().inUseBytes, 0u);
+}
+
+TEST(SlabAllocator, OversizedAllocationsBypassChunks)
+{
+    SlabAllocator slab;
+    const size_t big = 8 * 1024 * 1024;
+    void* p = slab.Allocate(big);
+    ASSERT_NE(p, nullptr);
+    EXPECT_EQ(slab.Stats().directBytes, big);
+    EXPECT_EQ(slab.Stats().reservedBytes, 0u);
+    slab.Free(p, big);
+    EXPECT_EQ(slab.Stats().inUseBytes, 0u);
+}
+
+TEST(SlabAllocator, ThreadCacheBlocksReturnToCentralOnExit)
+{
+    SlabAllocator& slab = SlabAllocator::Global();
+    const size_t baseline = slab.Stats().inUseBytes;
+
+    void* fromWorker = nullptr;
+    std::thread worker([&] {
+        fromWorker = slab.Allocate(3000);
+        slab.Free(fromWorker, 3000);
+    });
+    worker.join();
+    EXPECT_EQ(slab.Stats().inUseBytes, baseline);
+
+    // 다른 스레드 cache 에 있던 블록도 종료 후에는 재사용 가능
+    bool found = false;
+    void* blocks[SlabAllocator::kBatch * 4];
+    for (auto& block : blocks) {
+        block = slab.Allocate(3000);
+        found = found || block == fromWorker;
+    }
+    for (auto* block : blocks) {
+        slab.Free(block, 3000);
+    }
+    EXPECT_TRUE(found);
+}
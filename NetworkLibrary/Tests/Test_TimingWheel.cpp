@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "TimingWheel.h"
+
+using namespace std::chrono_literals;
+
+TEST(TimingWheel, FiresOnlyExpiredTimers)
+{
+    const auto t0 = TimingWheel::Clock::now();
+    TimingWheel wheel(10ms, t0);
+
+    TimerNode a, b;
+    a.userData = 1;
+    b.userData = 2;
+    wheel.Schedule(a, 50ms);
+    wheel.Schedule(b, 200ms);
+    EXPECT_EQ(wheel.Size(), 2u);
+
+    std::vector<std::uint64_t> fired;
+    auto collect = [&](TimerNode& n) { fired.push_back(n.userData); };
+
+    EXPECT_EQ(wheel.Advance(t0 + 40ms, collect), 0u);
+    EXPECT_EQ(wheel.Advance(t0 + 50ms, collect), 1u);
+    ASSERT_EQ(fired.size(), 1u);
+    EXPECT_EQ(fired[0], 1u);
+    EXPECT_FALSE(a.IsScheduled());
+    EXPECT_TRUE(b.IsScheduled());
+
+    EXPECT_EQ(wheel.Advance(t0 + 300ms, collect), 1u);
+    EXPECT_TRUE(wheel.IsEmpty());
+}
+
+TEST(TimingWheel, RearmPostponesExpiry)
+{
+    const auto t0 = TimingWheel::Clock::now();
+    TimingWheel wheel(10ms, t0);
+
+    TimerNode node;
+    int fired = 0;
+    auto onExpire = [&](TimerNode&) { ++fired; };
+
+    wheel.Schedule(node, 100ms);
+    wheel.Advance(t0 + 80ms, onExpire);
+    // 활동이 있으면 다시 걸어서 만료를 미룸
+    wheel.Schedule(node, 100ms);
+    EXPECT_EQ(wheel.Size(), 1u);
+
+    wheel.Advance(t0 + 150ms, onExpire);
+    EXPECT_EQ(fired, 0);
+    wheel.Advance(t0 + 200ms, onExpire);
+    EXPECT_EQ(fired, 1);
+}
+
+TEST(TimingWheel, CascadesLongTimers)
+{
+    const auto t0 = TimingWheel::Clock::now();
+    TimingWheel wheel(1ms, t0);
+
+    // level 0(64), level 1(4096), level 2 범위에 각각 걸어둠
+    const std::chrono::milliseconds delays[] = {30ms, 1000ms, 30000ms, 100000ms};
+    TimerNode nodes[4];
+    for (int i = 0; i < 4; ++i) {
+        nodes[i].userData = static_cast<std::uint64_t>(delays[i].count());
+        wheel.Schedule(nodes[i], delays[i]);
+    }
+
+    std::vector<std::uint64_t> fired;
+    auto collect = [&](TimerNode& n) { fired.push_back(n.userData); };
+    for (int i = 0; i < 4; ++i) {
+        wheel.Advance(t0 + delays[i] - 1ms, collect);
+        EXPECT_EQ(fired.size(), static_cast<size_t>(i));
+        wheel.Advance(t0 + delays[i], collect);
+        ASSERT_EQ(fired.size(), static_cast<size_t>(i + 1));
+        EXPECT_EQ(fired.back(), nodes[i].userData);
+    }
+}
+
+TEST(TimingWheel, NextTimeoutTracksNearestSlot)
+{
+    const auto t0 = TimingWheel::Clock::now();
+    TimingWheel wheel(10ms, t0);
+    EXPECT_EQ(wheel.NextTimeoutMs(t0, 1000), 1000);
+
+    TimerNode node;
+    wheel.Schedule(node, 120ms);
+    EXPECT_EQ(wheel.NextTimeoutMs(t0, 1000), 120);
+    EXPECT_EQ(wheel.NextTimeoutMs(t0, 50), 50);
+
+    // 상위 level 에 있는 timer 는 적어도 cascade 시점에는 깨워야 함
+    TimerNode far;
+    wheel.Cancel(node);
+    wheel.Schedule(far, 5000ms);
+    const int wait = wheel.NextTimeoutMs(t0, 100000);
+    EXPECT_GT(wait, 0);
+    EXPECT_LE(wait, 5000);
+}
+
+TEST(TimingWheel, DestroyedNodeIsRemoved)
+{
+    const auto t0 = TimingWheel::Clock::now();
+    TimingWheel wheel(10ms, t0);
+    {
+        TimerNode node;
+        wheel.Schedule(node, 10ms);
+        EXPECT_EQ(wheel.Size(), 1u);
+    }
+    EXPECT_TRUE(wheel.IsEmpty());
+    EXPECT_EQ(wheel.Advance(t0 + 1s, nullptr), 0u);
+}